@@ -0,0 +1,690 @@
+/// @file rad_bench.cpp
+/// @author Graham Scott
+/// @brief Implementation of rad_bench.h, and the entry point of the rad_bench executable.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_bench.h"
+#include "rad_allocation_counter.h"
+#include "rad_base.h"
+#include "rad_perf_counters.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define RAD_BENCH_HAS_CPUID 1
+
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#else
+    #define RAD_BENCH_HAS_CPUID 0
+#endif
+
+#ifndef RAD_BENCH_BUILD_TYPE
+    #define RAD_BENCH_BUILD_TYPE "unknown"
+#endif
+
+#ifndef RAD_BENCH_CXX_FLAGS
+    #define RAD_BENCH_CXX_FLAGS ""
+#endif
+
+namespace rad::bench
+{
+namespace
+{
+    struct benchmark_entry
+    {
+        const char*     name;
+        benchmark_func  func;
+    };
+
+    struct options
+    {
+        std::string_view    filter;
+        const char*         jsonPath = nullptr;
+        const char*         csvPath = nullptr;
+        std::size_t         warmupCount = 2;
+        std::size_t         repetitionCount = 30;
+        double              minBatchTimeNs = 1e6;
+        bool                listOnly = false;
+        bool                perfCounters = false;
+    };
+
+    struct result
+    {
+        const char*             name;
+        std::size_t             iterations;
+        double                  minNs;
+        double                  medianNs;
+        double                  p99Ns;
+        double                  meanNs;
+        double                  stddevNs;
+        std::vector<double>     samples;    // NOTE: The time per iteration of each repetition.
+        allocation_stats        allocationTotals;
+        perf_counter_values     counterTotals;
+    };
+
+    struct metadata
+    {
+        std::string     cpuModel;
+        std::string     compiler;
+        std::string     os;
+        std::string     timestamp;
+        unsigned int    threadCount;
+    };
+
+    std::vector<benchmark_entry>& get_benchmarks_()
+    {
+        // NOTE: This is a function-local static so that benchmarks can safely
+        // be registered from static initializers in other translation units.
+        static std::vector<benchmark_entry> benchmarks;
+        return benchmarks;
+    }
+
+    double run_batch_(benchmark_func func, std::size_t iterations)
+    {
+        state s(iterations);
+
+        const auto start = std::chrono::steady_clock::now();
+        func(s);
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+    double get_percentile_(const std::vector<double>& sortedSamples, double percentile)
+    {
+        // Use the nearest-rank method.
+        const auto rank = static_cast<std::size_t>(
+            std::ceil(percentile * sortedSamples.size()));
+
+        return sortedSamples[std::max<std::size_t>(rank, 1) - 1];
+    }
+
+    result run_benchmark_(const benchmark_entry& benchmark, const options& opts)
+    {
+        const auto func = benchmark.func;
+
+        // Find an iteration count which makes each batch take long enough
+        // for the timer's resolution and overhead to be negligible.
+        std::size_t iterations = 1;
+
+        while (run_batch_(func, iterations) < opts.minBatchTimeNs &&
+            iterations < (static_cast<std::size_t>(1) << 40))
+        {
+            iterations *= 2;
+        }
+
+        // Warm up caches, branch predictors, allocators, etc.
+        for (std::size_t i = 0; i < opts.warmupCount; ++i)
+        {
+            run_batch_(func, iterations);
+        }
+
+        // Measure the time per iteration of each repetition.
+        result r;
+        r.name = benchmark.name;
+        r.iterations = iterations;
+        r.samples.reserve(opts.repetitionCount);
+
+        for (std::size_t i = 0; i < opts.repetitionCount; ++i)
+        {
+            r.samples.push_back(run_batch_(func, iterations) / iterations);
+        }
+
+    #if RAD_USE_ALLOCATION_COUNTERS == 1
+        // Count allocations in a separate batch, so that
+        // counting them doesn't affect the timing results.
+        {
+            const scoped_allocation_counter counter;
+            run_batch_(func, iterations);
+            r.allocationTotals = counter.stats();
+        }
+    #endif
+
+        // Compute statistics.
+        auto sorted = r.samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        r.minNs = sorted.front();
+        r.medianNs = (sorted.size() % 2) ? sorted[sorted.size() / 2] :
+            ((sorted[(sorted.size() / 2) - 1] + sorted[sorted.size() / 2]) / 2);
+        r.p99Ns = get_percentile_(sorted, 0.99);
+
+        double sum = 0, sumOfSquares = 0;
+
+        for (const auto sample : sorted)
+        {
+            sum += sample;
+        }
+
+        r.meanNs = (sum / sorted.size());
+
+        for (const auto sample : sorted)
+        {
+            sumOfSquares += ((sample - r.meanNs) * (sample - r.meanNs));
+        }
+
+        r.stddevNs = (sorted.size() > 1) ?
+            std::sqrt(sumOfSquares / (sorted.size() - 1)) : 0.0;
+
+        return r;
+    }
+
+    // NOTE: These return -1 if libRad was built without allocation counters;
+    // rad_bench_compare treats negative counts as not present.
+
+    double get_allocations_per_op_([[maybe_unused]] const result& r) noexcept
+    {
+    #if RAD_USE_ALLOCATION_COUNTERS == 1
+        // NOTE: Reallocations are counted too, as they're just as
+        // costly as (and often actually are) new allocations.
+        return static_cast<double>(r.allocationTotals.allocations +
+            r.allocationTotals.reallocations) / r.iterations;
+    #else
+        return -1;
+    #endif
+    }
+
+    double get_allocated_bytes_per_op_([[maybe_unused]] const result& r) noexcept
+    {
+    #if RAD_USE_ALLOCATION_COUNTERS == 1
+        return static_cast<double>(r.allocationTotals.bytes) / r.iterations;
+    #else
+        return -1;
+    #endif
+    }
+
+    void measure_perf_counters_(const benchmark_entry& benchmark,
+        perf_counters& counters, result& r)
+    {
+        // NOTE: We do this in a separate batch, so the (small) overhead
+        // of reading the counters doesn't affect the timing results.
+        {
+            const auto region = counters.region(benchmark.name);
+            run_batch_(benchmark.func, r.iterations);
+        }
+
+        r.counterTotals = counters.find_region(benchmark.name)->totals;
+    }
+
+    std::string get_cpu_model_()
+    {
+        std::string model;
+
+    #if RAD_BENCH_HAS_CPUID == 1
+        // Read the processor brand string from the extended CPUID leaves.
+        unsigned int regs[12] = {};
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+        #ifdef _MSC_VER
+            __cpuid(reinterpret_cast<int*>(regs + (i * 4)), 0x80000002 + i);
+        #else
+            __get_cpuid(0x80000002 + i, &regs[i * 4],
+                &regs[(i * 4) + 1], &regs[(i * 4) + 2], &regs[(i * 4) + 3]);
+        #endif
+        }
+
+        model.assign(reinterpret_cast<const char*>(regs),
+            strnlen(reinterpret_cast<const char*>(regs), sizeof(regs)));
+    #elif defined(__linux__)
+        // Fallback to reading the model from /proc/cpuinfo.
+        if (auto file = std::fopen("/proc/cpuinfo", "r"))
+        {
+            char line[512];
+
+            while (std::fgets(line, sizeof(line), file))
+            {
+                const std::string_view lineView(line);
+
+                if (lineView.compare(0, 10, "model name") == 0 ||
+                    lineView.compare(0, 9, "Processor") == 0)
+                {
+                    const auto colonPos = lineView.find(':');
+                    if (colonPos != std::string_view::npos)
+                    {
+                        model = lineView.substr(colonPos + 1);
+                        break;
+                    }
+                }
+            }
+
+            std::fclose(file);
+        }
+    #endif
+
+        // Trim leading/trailing whitespace.
+        const auto begin = model.find_first_not_of(" \t\n");
+        const auto end = model.find_last_not_of(" \t\n");
+
+        return (begin == std::string::npos) ? "unknown" :
+            model.substr(begin, (end - begin) + 1);
+    }
+
+    metadata get_metadata_()
+    {
+        metadata m;
+        m.cpuModel = get_cpu_model_();
+
+    #if defined(__clang__)
+        m.compiler = "clang " __clang_version__;
+    #elif defined(__GNUC__)
+        m.compiler = "gcc " __VERSION__;
+    #elif defined(_MSC_VER)
+        m.compiler = ("msvc " + std::to_string(_MSC_FULL_VER));
+    #else
+        m.compiler = "unknown";
+    #endif
+
+    #if defined(_WIN32)
+        m.os = "windows";
+    #elif defined(__APPLE__)
+        m.os = "macos";
+    #elif defined(__linux__)
+        m.os = "linux";
+    #else
+        m.os = "unknown";
+    #endif
+
+        // Get the current time in UTC, in ISO 8601 format.
+        const auto now = std::time(nullptr);
+        char timestamp[32];
+        std::tm utcTime;
+
+    #ifdef _WIN32
+        gmtime_s(&utcTime, &now);
+    #else
+        gmtime_r(&now, &utcTime);
+    #endif
+
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utcTime);
+        m.timestamp = timestamp;
+
+        m.threadCount = std::thread::hardware_concurrency();
+        return m;
+    }
+
+    void write_json_string_(std::FILE* file, std::string_view str)
+    {
+        std::fputc('"', file);
+
+        for (const char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                std::fputc('\\', file);
+                std::fputc(c, file);
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                std::fprintf(file, "\\u%04x", static_cast<unsigned int>(c));
+            }
+            else
+            {
+                std::fputc(c, file);
+            }
+        }
+
+        std::fputc('"', file);
+    }
+
+    bool write_json_(const char* path, const metadata& m, const options& opts,
+        const perf_counters* counters, const std::vector<result>& results)
+    {
+        const auto file = std::fopen(path, "w");
+        if (!file)
+        {
+            return false;
+        }
+
+        std::fprintf(file, "{\n  \"context\": {\n    \"cpu_model\": ");
+        write_json_string_(file, m.cpuModel);
+        std::fprintf(file, ",\n    \"thread_count\": %u,\n    \"os\": ", m.threadCount);
+        write_json_string_(file, m.os);
+        std::fprintf(file, ",\n    \"compiler\": ");
+        write_json_string_(file, m.compiler);
+        std::fprintf(file, ",\n    \"build_type\": ");
+        write_json_string_(file, RAD_BENCH_BUILD_TYPE);
+        std::fprintf(file, ",\n    \"cxx_flags\": ");
+        write_json_string_(file, RAD_BENCH_CXX_FLAGS);
+        std::fprintf(file, ",\n    \"rad_use_debug_memory\": %s",
+            (RAD_USE_DEBUG_MEMORY == 1) ? "true" : "false");
+        std::fprintf(file, ",\n    \"timestamp\": ");
+        write_json_string_(file, m.timestamp);
+        std::fprintf(file, ",\n    \"warmup\": %zu,\n    \"repetitions\": %zu\n  },\n",
+            opts.warmupCount, opts.repetitionCount);
+
+        std::fprintf(file, "  \"benchmarks\": [");
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& r = results[i];
+
+            std::fprintf(file, "%s\n    {\n      \"name\": ", (i == 0) ? "" : ",");
+            write_json_string_(file, r.name);
+            std::fprintf(file, ",\n      \"iterations\": %zu,\n"
+                "      \"min_ns\": %.17g,\n      \"median_ns\": %.17g,\n"
+                "      \"p99_ns\": %.17g,\n      \"mean_ns\": %.17g,\n"
+                "      \"stddev_ns\": %.17g,\n      \"allocations_per_op\": %.17g,\n"
+                "      \"allocated_bytes_per_op\": %.17g,\n      \"samples_ns\": [",
+                r.iterations, r.minNs, r.medianNs, r.p99Ns, r.meanNs, r.stddevNs,
+                get_allocations_per_op_(r), get_allocated_bytes_per_op_(r));
+
+            for (std::size_t j = 0; j < r.samples.size(); ++j)
+            {
+                std::fprintf(file, "%s%.17g", (j == 0) ? "" : ", ", r.samples[j]);
+            }
+
+            std::fprintf(file, "]");
+
+            if (counters)
+            {
+                std::fprintf(file, ",\n      \"counters_per_op\": {");
+                bool isFirst = true;
+
+                for (std::size_t j = 0; j < perf_counter_count; ++j)
+                {
+                    const auto counter = static_cast<perf_counter>(j);
+
+                    if (counters->is_available(counter))
+                    {
+                        std::fprintf(file, "%s\"%s\": %.17g", isFirst ? "" : ", ",
+                            get_perf_counter_name(counter),
+                            static_cast<double>(r.counterTotals[counter]) / r.iterations);
+
+                        isFirst = false;
+                    }
+                }
+
+                std::fprintf(file, "}");
+            }
+
+            std::fprintf(file, "\n    }");
+        }
+
+        std::fprintf(file, "\n  ]\n}\n");
+        return (std::fclose(file) == 0);
+    }
+
+    bool write_csv_(const char* path, const metadata& m, const options& opts,
+        const perf_counters* counters, const std::vector<result>& results)
+    {
+        const auto file = std::fopen(path, "w");
+        if (!file)
+        {
+            return false;
+        }
+
+        // NOTE: The environment metadata is written as leading "#" comment lines,
+        // which most CSV readers can be told to skip (e.g. pandas' comment='#').
+        std::fprintf(file,
+            "# cpu_model: %s\n# thread_count: %u\n# os: %s\n# compiler: %s\n"
+            "# build_type: %s\n# cxx_flags: %s\n# rad_use_debug_memory: %s\n"
+            "# timestamp: %s\n# warmup: %zu\n# repetitions: %zu\n",
+            m.cpuModel.c_str(), m.threadCount, m.os.c_str(), m.compiler.c_str(),
+            RAD_BENCH_BUILD_TYPE, RAD_BENCH_CXX_FLAGS,
+            (RAD_USE_DEBUG_MEMORY == 1) ? "true" : "false",
+            m.timestamp.c_str(), opts.warmupCount, opts.repetitionCount);
+
+        std::fprintf(file, "name,iterations,min_ns,median_ns,p99_ns,mean_ns,stddev_ns,"
+            "allocations_per_op,allocated_bytes_per_op,samples_ns");
+
+        if (counters)
+        {
+            for (std::size_t i = 0; i < perf_counter_count; ++i)
+            {
+                std::fprintf(file, ",%s_per_op", get_perf_counter_name(static_cast<perf_counter>(i)));
+            }
+        }
+
+        std::fputc('\n', file);
+
+        for (const auto& r : results)
+        {
+            // NOTE: Samples are separated by semicolons so they fit within one CSV field.
+            std::fprintf(file, "%s,%zu,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,",
+                r.name, r.iterations, r.minNs, r.medianNs, r.p99Ns, r.meanNs, r.stddevNs,
+                get_allocations_per_op_(r), get_allocated_bytes_per_op_(r));
+
+            for (std::size_t i = 0; i < r.samples.size(); ++i)
+            {
+                std::fprintf(file, "%s%.17g", (i == 0) ? "" : ";", r.samples[i]);
+            }
+
+            if (counters)
+            {
+                // NOTE: Unavailable counters are left empty.
+                for (std::size_t i = 0; i < perf_counter_count; ++i)
+                {
+                    const auto counter = static_cast<perf_counter>(i);
+
+                    if (counters->is_available(counter))
+                    {
+                        std::fprintf(file, ",%.17g",
+                            static_cast<double>(r.counterTotals[counter]) / r.iterations);
+                    }
+                    else
+                    {
+                        std::fputc(',', file);
+                    }
+                }
+            }
+
+            std::fputc('\n', file);
+        }
+
+        return (std::fclose(file) == 0);
+    }
+
+    bool parse_size_option_(const char* arg, const char* name, std::size_t& value)
+    {
+        const auto nameLen = std::strlen(name);
+
+        if (std::strncmp(arg, name, nameLen) != 0 || arg[nameLen] != '=')
+        {
+            return false;
+        }
+
+        value = static_cast<std::size_t>(std::strtoull(arg + nameLen + 1, nullptr, 10));
+        return true;
+    }
+
+    void print_usage_(const char* exeName)
+    {
+        std::printf(
+            "Usage: %s [options]\n"
+            "\n"
+            "Options:\n"
+            "  --filter=<text>       Only run benchmarks whose names contain the given text\n"
+            "  --warmup=<count>      The number of warmup batches to run (default: 2)\n"
+            "  --repetitions=<count> The number of measured batches to run (default: 30)\n"
+            "  --min-time-ms=<ms>    The minimum duration of each batch (default: 1)\n"
+            "  --perf-counters       Also measure hardware performance counters (Linux only)\n"
+            "  --json=<path>         Also write the results, samples, and environment info as JSON\n"
+            "  --csv=<path>          Also write the results, samples, and environment info as CSV\n"
+            "  --list                List the names of all benchmarks without running them\n",
+            exeName);
+    }
+}
+
+namespace detail_
+{
+    void use_char_pointer_(const volatile char* ptr) noexcept
+    {
+        (void)ptr;
+    }
+}
+
+void register_benchmark(const char* name, benchmark_func func)
+{
+    get_benchmarks_().push_back({ name, func });
+}
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace rad::bench;
+
+    // Parse command-line arguments.
+    options opts;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        std::size_t minTimeMs;
+
+        if (std::strncmp(arg, "--filter=", 9) == 0)
+        {
+            opts.filter = (arg + 9);
+        }
+        else if (std::strncmp(arg, "--json=", 7) == 0)
+        {
+            opts.jsonPath = (arg + 7);
+        }
+        else if (std::strncmp(arg, "--csv=", 6) == 0)
+        {
+            opts.csvPath = (arg + 6);
+        }
+        else if (std::strcmp(arg, "--perf-counters") == 0)
+        {
+            opts.perfCounters = true;
+        }
+        else if (std::strcmp(arg, "--list") == 0)
+        {
+            opts.listOnly = true;
+        }
+        else if (parse_size_option_(arg, "--min-time-ms", minTimeMs))
+        {
+            opts.minBatchTimeNs = (minTimeMs * 1e6);
+        }
+        else if (!parse_size_option_(arg, "--warmup", opts.warmupCount) &&
+            !parse_size_option_(arg, "--repetitions", opts.repetitionCount))
+        {
+            print_usage_(argv[0]);
+            return (std::strcmp(arg, "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (opts.repetitionCount == 0)
+    {
+        opts.repetitionCount = 1;
+    }
+
+    // Sort benchmarks by name, so related benchmarks are printed next to each other.
+    auto& benchmarks = get_benchmarks_();
+
+    std::sort(benchmarks.begin(), benchmarks.end(),
+        [](const benchmark_entry& a, const benchmark_entry& b)
+        {
+            return (std::strcmp(a.name, b.name) < 0);
+        });
+
+    // Open hardware performance counters if requested.
+    std::unique_ptr<rad::perf_counters> counters;
+
+    if (opts.perfCounters && !opts.listOnly)
+    {
+        counters.reset(new rad::perf_counters());
+
+        if (!rad::perf_counters::is_supported())
+        {
+            std::fprintf(stderr, "warning: hardware performance counters are "
+                "not supported on this platform; ignoring --perf-counters\n");
+
+            counters.reset();
+        }
+        else if (!counters->is_any_available())
+        {
+            std::fprintf(stderr, "warning: no hardware performance counters "
+                "are available on this system; ignoring --perf-counters\n");
+
+            counters.reset();
+        }
+    }
+
+    // Run benchmarks.
+    std::vector<result> results;
+
+    if (!opts.listOnly)
+    {
+        std::printf("%-48s %14s %12s %12s %12s %10s\n", "benchmark",
+            "iterations", "min ns/op", "median ns/op", "p99 ns/op", "allocs/op");
+    }
+
+    for (const auto& benchmark : benchmarks)
+    {
+        if (std::string_view(benchmark.name).find(opts.filter) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        if (opts.listOnly)
+        {
+            std::printf("%s\n", benchmark.name);
+            continue;
+        }
+
+        auto r = run_benchmark_(benchmark, opts);
+
+        std::printf("%-48s %14zu %12.2f %12.2f %12.2f %10.2f\n", benchmark.name,
+            r.iterations, r.minNs, r.medianNs, r.p99Ns, get_allocations_per_op_(r));
+
+        if (counters)
+        {
+            measure_perf_counters_(benchmark, *counters, r);
+            std::printf("   ");
+
+            for (std::size_t i = 0; i < rad::perf_counter_count; ++i)
+            {
+                const auto counter = static_cast<rad::perf_counter>(i);
+
+                if (counters->is_available(counter))
+                {
+                    std::printf(" %s/op: %.2f", rad::get_perf_counter_name(counter),
+                        static_cast<double>(r.counterTotals[counter]) / r.iterations);
+                }
+            }
+
+            std::printf("\n");
+        }
+
+        std::fflush(stdout);
+        results.push_back(std::move(r));
+    }
+
+    // Write machine-readable results.
+    if (opts.listOnly || (!opts.jsonPath && !opts.csvPath))
+    {
+        return EXIT_SUCCESS;
+    }
+
+    const auto m = get_metadata_();
+
+    if (opts.jsonPath && !write_json_(opts.jsonPath, m, opts, counters.get(), results))
+    {
+        std::fprintf(stderr, "Failed to write JSON results to \"%s\"\n", opts.jsonPath);
+        return EXIT_FAILURE;
+    }
+
+    if (opts.csvPath && !write_csv_(opts.csvPath, m, opts, counters.get(), results))
+    {
+        std::fprintf(stderr, "Failed to write CSV results to \"%s\"\n", opts.csvPath);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
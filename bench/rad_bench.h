@@ -0,0 +1,99 @@
+/// @file rad_bench.h
+/// @author Graham Scott
+/// @brief Header file providing the small embedded harness used by the rad_bench executable.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_BENCH_H_INCLUDED
+#define RAD_BENCH_H_INCLUDED
+
+#include <cstddef>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace rad::bench
+{
+namespace detail_
+{
+    void use_char_pointer_(const volatile char* ptr) noexcept;
+}
+
+/// @brief Prevents the compiler from optimizing away the computation of the given value.
+template<typename T>
+inline void do_not_optimize(const T& value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    detail_::use_char_pointer_(&reinterpret_cast<const volatile char&>(value));
+    _ReadWriteBarrier();
+#endif
+}
+
+/// @brief Forces the compiler to assume that all memory may have been read
+/// from or written to, so that pending writes can't be optimized away.
+inline void clobber_memory() noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    _ReadWriteBarrier();
+#endif
+}
+
+class state
+{
+    std::size_t iterations_;
+
+public:
+    /// @brief Returns the number of times the benchmark body should be run.
+    inline std::size_t iterations() const noexcept
+    {
+        return iterations_;
+    }
+
+    explicit state(std::size_t iterations) noexcept
+        : iterations_(iterations)
+    {
+    }
+};
+
+using benchmark_func = void (*)(state& s);
+
+/// @brief Adds the given benchmark to the global list of benchmarks.
+/// @param name The name of the benchmark; by convention, "group/operation/implementation".
+/// @param func The benchmark function; must run its body s.iterations() times.
+void register_benchmark(const char* name, benchmark_func func);
+
+struct registrar
+{
+    inline registrar(const char* name, benchmark_func func)
+    {
+        register_benchmark(name, func);
+    }
+};
+}
+
+#define RAD_BENCH_CONCAT_IMPL_(a, b) a##b
+#define RAD_BENCH_CONCAT_(a, b) RAD_BENCH_CONCAT_IMPL_(a, b)
+
+/// @brief Defines and registers a benchmark function with the given name.
+///
+/// Example usage:
+///
+///     RAD_BENCH("vector/push_back/rad", s)
+///     {
+///         for (std::size_t i = 0; i < s.iterations(); ++i)
+///         {
+///             ...
+///         }
+///     }
+#define RAD_BENCH(name, stateName)\
+    static void RAD_BENCH_CONCAT_(rad_bench_func_, __LINE__)(::rad::bench::state& stateName);\
+    static const ::rad::bench::registrar RAD_BENCH_CONCAT_(rad_bench_registrar_, __LINE__)(\
+        (name), &RAD_BENCH_CONCAT_(rad_bench_func_, __LINE__));\
+    static void RAD_BENCH_CONCAT_(rad_bench_func_, __LINE__)(::rad::bench::state& stateName)
+
+#endif
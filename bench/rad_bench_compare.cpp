@@ -0,0 +1,654 @@
+/// @file rad_bench_compare.cpp
+/// @author Graham Scott
+/// @brief The entry point of the rad_bench_compare executable, which compares two
+/// rad_bench JSON result files and reports statistically-significant regressions.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /// @brief The exit code used when at least one regression was found.
+    constexpr int exit_regression = 1;
+
+    /// @brief The exit code used when the given arguments or files were invalid.
+    constexpr int exit_error = 2;
+
+    struct json_value
+    {
+        enum class type
+        {
+            null,
+            boolean,
+            number,
+            string,
+            array,
+            object
+        };
+
+        type                                            valueType = type::null;
+        bool                                            boolean = false;
+        double                                          number = 0;
+        std::string                                     string;
+        std::vector<json_value>                         array;
+        std::vector<std::pair<std::string, json_value>> object;
+
+        const json_value* find(std::string_view key) const noexcept
+        {
+            for (const auto& member : object)
+            {
+                if (member.first == key)
+                {
+                    return &member.second;
+                }
+            }
+
+            return nullptr;
+        }
+    };
+
+    /// @brief A minimal JSON parser; just enough to read back rad_bench's own output.
+    class json_parser
+    {
+        const char* cur_;
+        const char* end_;
+
+        void skip_whitespace_() noexcept
+        {
+            while (cur_ != end_ && (*cur_ == ' ' || *cur_ == '\t' ||
+                *cur_ == '\n' || *cur_ == '\r'))
+            {
+                ++cur_;
+            }
+        }
+
+        bool consume_(char c) noexcept
+        {
+            skip_whitespace_();
+
+            if (cur_ == end_ || *cur_ != c)
+            {
+                return false;
+            }
+
+            ++cur_;
+            return true;
+        }
+
+        bool consume_literal_(std::string_view literal) noexcept
+        {
+            if (static_cast<std::size_t>(end_ - cur_) < literal.size() ||
+                std::string_view(cur_, literal.size()) != literal)
+            {
+                return false;
+            }
+
+            cur_ += literal.size();
+            return true;
+        }
+
+        bool parse_string_(std::string& str)
+        {
+            if (!consume_('"'))
+            {
+                return false;
+            }
+
+            while (cur_ != end_ && *cur_ != '"')
+            {
+                if (*cur_ == '\\')
+                {
+                    if (++cur_ == end_)
+                    {
+                        return false;
+                    }
+
+                    switch (*cur_)
+                    {
+                    case 'n':
+                        str += '\n';
+                        break;
+
+                    case 't':
+                        str += '\t';
+                        break;
+
+                    case 'r':
+                        str += '\r';
+                        break;
+
+                    case 'u':
+                        // NOTE: rad_bench only escapes control characters this way,
+                        // so we don't bother handling non-ASCII code points here.
+                        if ((end_ - cur_) < 5)
+                        {
+                            return false;
+                        }
+
+                        str += static_cast<char>(std::strtoul(
+                            std::string(cur_ + 1, 4).c_str(), nullptr, 16));
+
+                        cur_ += 4;
+                        break;
+
+                    default:
+                        str += *cur_;
+                        break;
+                    }
+                }
+                else
+                {
+                    str += *cur_;
+                }
+
+                ++cur_;
+            }
+
+            return consume_('"');
+        }
+
+        bool parse_value_(json_value& value)
+        {
+            skip_whitespace_();
+
+            if (cur_ == end_)
+            {
+                return false;
+            }
+
+            switch (*cur_)
+            {
+            case '{':
+                value.valueType = json_value::type::object;
+                ++cur_;
+
+                if (consume_('}'))
+                {
+                    return true;
+                }
+
+                do
+                {
+                    std::pair<std::string, json_value> member;
+
+                    if (!parse_string_(member.first) || !consume_(':') ||
+                        !parse_value_(member.second))
+                    {
+                        return false;
+                    }
+
+                    value.object.push_back(std::move(member));
+                }
+                while (consume_(','));
+
+                return consume_('}');
+
+            case '[':
+                value.valueType = json_value::type::array;
+                ++cur_;
+
+                if (consume_(']'))
+                {
+                    return true;
+                }
+
+                do
+                {
+                    value.array.emplace_back();
+
+                    if (!parse_value_(value.array.back()))
+                    {
+                        return false;
+                    }
+                }
+                while (consume_(','));
+
+                return consume_(']');
+
+            case '"':
+                value.valueType = json_value::type::string;
+                return parse_string_(value.string);
+
+            case 't':
+            case 'f':
+                value.valueType = json_value::type::boolean;
+                value.boolean = (*cur_ == 't');
+                return consume_literal_(value.boolean ? "true" : "false");
+
+            case 'n':
+                return consume_literal_("null");
+
+            default:
+            {
+                char* numEnd;
+                value.valueType = json_value::type::number;
+                value.number = std::strtod(cur_, &numEnd);
+
+                if (numEnd == cur_)
+                {
+                    return false;
+                }
+
+                cur_ = numEnd;
+                return true;
+            }
+            }
+        }
+
+    public:
+        /// @brief Parses the given null-terminated JSON string.
+        bool parse(const std::string& json, json_value& value)
+        {
+            cur_ = json.c_str();
+            end_ = (cur_ + json.size());
+
+            if (!parse_value_(value))
+            {
+                return false;
+            }
+
+            skip_whitespace_();
+            return (cur_ == end_);
+        }
+    };
+
+    struct benchmark_result
+    {
+        std::string             name;
+        double                  medianNs;
+        double                  allocationsPerOp = -1;  // NOTE: -1 if not present.
+        std::vector<double>     samples;
+    };
+
+    struct result_file
+    {
+        json_value                      context;
+        std::vector<benchmark_result>   benchmarks;
+
+        const benchmark_result* find(std::string_view name) const noexcept
+        {
+            for (const auto& benchmark : benchmarks)
+            {
+                if (benchmark.name == name)
+                {
+                    return &benchmark;
+                }
+            }
+
+            return nullptr;
+        }
+    };
+
+    bool read_file_(const char* path, std::string& data)
+    {
+        const auto file = std::fopen(path, "rb");
+        if (!file)
+        {
+            return false;
+        }
+
+        char buffer[4096];
+        std::size_t readSize;
+
+        while ((readSize = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            data.append(buffer, readSize);
+        }
+
+        const bool success = !std::ferror(file);
+        std::fclose(file);
+
+        return success;
+    }
+
+    bool load_result_file_(const char* path, result_file& results)
+    {
+        std::string data;
+
+        if (!read_file_(path, data))
+        {
+            std::fprintf(stderr, "Failed to read \"%s\"\n", path);
+            return false;
+        }
+
+        json_value root;
+
+        if (!json_parser().parse(data, root) || root.valueType != json_value::type::object)
+        {
+            std::fprintf(stderr, "\"%s\" is not a valid JSON file\n", path);
+            return false;
+        }
+
+        const auto context = root.find("context");
+        const auto benchmarks = root.find("benchmarks");
+
+        if (!benchmarks || benchmarks->valueType != json_value::type::array)
+        {
+            std::fprintf(stderr, "\"%s\" is not a rad_bench JSON result file\n", path);
+            return false;
+        }
+
+        if (context)
+        {
+            results.context = *context;
+        }
+
+        for (const auto& benchmark : benchmarks->array)
+        {
+            const auto name = benchmark.find("name");
+            const auto median = benchmark.find("median_ns");
+            const auto samples = benchmark.find("samples_ns");
+
+            if (!name || name->valueType != json_value::type::string ||
+                !median || median->valueType != json_value::type::number ||
+                !samples || samples->valueType != json_value::type::array)
+            {
+                std::fprintf(stderr, "\"%s\" contains an invalid benchmark entry\n", path);
+                return false;
+            }
+
+            benchmark_result result;
+            result.name = name->string;
+            result.medianNs = median->number;
+
+            // NOTE: Older result files don't contain allocation counts.
+            const auto allocationsPerOp = benchmark.find("allocations_per_op");
+
+            if (allocationsPerOp && allocationsPerOp->valueType == json_value::type::number)
+            {
+                result.allocationsPerOp = allocationsPerOp->number;
+            }
+
+            for (const auto& sample : samples->array)
+            {
+                result.samples.push_back(sample.number);
+            }
+
+            results.benchmarks.push_back(std::move(result));
+        }
+
+        return true;
+    }
+
+    /// @brief Computes the two-sided p-value of the Mann-Whitney U test on the given samples.
+    ///
+    /// Uses the normal approximation (with tie and continuity corrections), which is
+    /// accurate enough for the sample counts rad_bench produces (30 by default).
+    double mann_whitney_p_value_(const std::vector<double>& a, const std::vector<double>& b)
+    {
+        const double n1 = static_cast<double>(a.size());
+        const double n2 = static_cast<double>(b.size());
+
+        if (a.empty() || b.empty())
+        {
+            return 1.0;
+        }
+
+        // Rank all samples together, giving tied samples their average rank.
+        std::vector<std::pair<double, bool>> all;
+        all.reserve(a.size() + b.size());
+
+        for (const auto sample : a)
+        {
+            all.emplace_back(sample, true);
+        }
+
+        for (const auto sample : b)
+        {
+            all.emplace_back(sample, false);
+        }
+
+        std::sort(all.begin(), all.end());
+
+        double rankSumA = 0, tieCorrection = 0;
+
+        for (std::size_t i = 0; i < all.size();)
+        {
+            std::size_t j = (i + 1);
+
+            while (j < all.size() && all[j].first == all[i].first)
+            {
+                ++j;
+            }
+
+            const double tieCount = static_cast<double>(j - i);
+            const double averageRank = ((i + 1) + j) / 2.0;
+
+            for (std::size_t k = i; k < j; ++k)
+            {
+                if (all[k].second)
+                {
+                    rankSumA += averageRank;
+                }
+            }
+
+            tieCorrection += ((tieCount * tieCount * tieCount) - tieCount);
+            i = j;
+        }
+
+        const double n = (n1 + n2);
+        const double u = (rankSumA - ((n1 * (n1 + 1)) / 2));
+        const double mean = ((n1 * n2) / 2);
+        const double variance = (((n1 * n2) / 12) *
+            ((n + 1) - (tieCorrection / (n * (n - 1)))));
+
+        if (variance <= 0)
+        {
+            return 1.0;
+        }
+
+        const double z = (std::max(std::fabs(u - mean) - 0.5, 0.0) / std::sqrt(variance));
+        return std::erfc(z / std::sqrt(2.0));
+    }
+
+    bool has_more_allocations_(const benchmark_result& oldResult,
+        const benchmark_result& newResult) noexcept
+    {
+        if (oldResult.allocationsPerOp < 0 || newResult.allocationsPerOp < 0)
+        {
+            return false;
+        }
+
+        // NOTE: Allocation counts are deterministic, but one-time allocations made by
+        // a benchmark's setup code get amortized over a (varying) number of iterations,
+        // so we allow a tiny bit of slack. A hot path which goes from 0 allocations
+        // to even 1 allocation every 100 operations is still caught.
+        return (newResult.allocationsPerOp >
+            ((oldResult.allocationsPerOp * 1.01) + 0.01));
+    }
+
+    const char* get_context_string_(const json_value& context, std::string_view key)
+    {
+        const auto value = context.find(key);
+
+        if (!value)
+        {
+            return "unknown";
+        }
+
+        switch (value->valueType)
+        {
+        case json_value::type::string:
+            return value->string.c_str();
+
+        case json_value::type::boolean:
+            return (value->boolean) ? "true" : "false";
+
+        default:
+            return "unknown";
+        }
+    }
+
+    void print_context_differences_(const json_value& oldContext, const json_value& newContext)
+    {
+        static const char* const keys[] =
+        {
+            "cpu_model", "os", "compiler", "build_type", "cxx_flags", "rad_use_debug_memory"
+        };
+
+        for (const auto key : keys)
+        {
+            const auto oldValue = get_context_string_(oldContext, key);
+            const auto newValue = get_context_string_(newContext, key);
+
+            if (std::strcmp(oldValue, newValue) != 0)
+            {
+                std::printf("warning: %s differs (\"%s\" vs. \"%s\")\n", key, oldValue, newValue);
+            }
+        }
+    }
+
+    bool parse_double_option_(const char* arg, const char* name, double& value)
+    {
+        const auto nameLen = std::strlen(name);
+
+        if (std::strncmp(arg, name, nameLen) != 0 || arg[nameLen] != '=')
+        {
+            return false;
+        }
+
+        value = std::strtod(arg + nameLen + 1, nullptr);
+        return true;
+    }
+
+    void print_usage_(const char* exeName)
+    {
+        std::printf(
+            "Usage: %s [options] <old.json> <new.json>\n"
+            "\n"
+            "Compares two rad_bench JSON result files (written via rad_bench --json=<path>),\n"
+            "and exits with a non-zero code if any benchmark regressed (i.e. became\n"
+            "significantly slower, or started making more allocations per operation).\n"
+            "\n"
+            "Options:\n"
+            "  --threshold=<percent> The minimum median slowdown considered a regression (default: 5)\n"
+            "  --alpha=<p-value>     The significance level of the Mann-Whitney U test (default: 0.05)\n"
+            "  --filter=<text>       Only compare benchmarks whose names contain the given text\n",
+            exeName);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Parse command-line arguments.
+    const char* paths[2] = {};
+    std::size_t pathCount = 0;
+    std::string_view filter;
+    double thresholdPercent = 5.0;
+    double alpha = 0.05;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+
+        if (std::strncmp(arg, "--filter=", 9) == 0)
+        {
+            filter = (arg + 9);
+        }
+        else if (parse_double_option_(arg, "--threshold", thresholdPercent) ||
+            parse_double_option_(arg, "--alpha", alpha))
+        {
+            continue;
+        }
+        else if (arg[0] != '-' && pathCount < 2)
+        {
+            paths[pathCount++] = arg;
+        }
+        else
+        {
+            print_usage_(argv[0]);
+            return (std::strcmp(arg, "--help") == 0) ? EXIT_SUCCESS : exit_error;
+        }
+    }
+
+    if (pathCount != 2)
+    {
+        print_usage_(argv[0]);
+        return exit_error;
+    }
+
+    // Load result files.
+    result_file oldResults, newResults;
+
+    if (!load_result_file_(paths[0], oldResults) ||
+        !load_result_file_(paths[1], newResults))
+    {
+        return exit_error;
+    }
+
+    print_context_differences_(oldResults.context, newResults.context);
+
+    // Compare results.
+    const double threshold = (thresholdPercent / 100.0);
+    std::size_t regressionCount = 0, improvementCount = 0;
+
+    std::printf("%-48s %12s %12s %9s %8s  %s\n", "benchmark",
+        "old ns/op", "new ns/op", "change", "p-value", "result");
+
+    for (const auto& newResult : newResults.benchmarks)
+    {
+        if (newResult.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        const auto oldResult = oldResults.find(newResult.name);
+
+        if (!oldResult)
+        {
+            std::printf("%-48s %12s %12.2f %9s %8s  new\n", newResult.name.c_str(),
+                "-", newResult.medianNs, "-", "-");
+
+            continue;
+        }
+
+        const double change = (oldResult->medianNs > 0) ?
+            ((newResult.medianNs - oldResult->medianNs) / oldResult->medianNs) : 0.0;
+
+        const double pValue = mann_whitney_p_value_(oldResult->samples, newResult.samples);
+        const char* verdict = "~";
+
+        if (has_more_allocations_(*oldResult, newResult))
+        {
+            verdict = "REGRESSION (allocations)";
+            ++regressionCount;
+        }
+        else if (pValue < alpha && change > threshold)
+        {
+            verdict = "REGRESSION";
+            ++regressionCount;
+        }
+        else if (pValue < alpha && change < -threshold)
+        {
+            verdict = "improvement";
+            ++improvementCount;
+        }
+
+        std::printf("%-48s %12.2f %12.2f %+8.2f%% %8.4f  %s\n", newResult.name.c_str(),
+            oldResult->medianNs, newResult.medianNs, change * 100.0, pValue, verdict);
+    }
+
+    for (const auto& oldResult : oldResults.benchmarks)
+    {
+        if (oldResult.name.find(filter) != std::string::npos &&
+            !newResults.find(oldResult.name))
+        {
+            std::printf("%-48s %12.2f %12s %9s %8s  removed\n", oldResult.name.c_str(),
+                oldResult.medianNs, "-", "-", "-");
+        }
+    }
+
+    std::printf("\n%zu regression(s), %zu improvement(s) (threshold: %.2f%%, alpha: %g)\n",
+        regressionCount, improvementCount, thresholdPercent, alpha);
+
+    return (regressionCount > 0) ? exit_regression : EXIT_SUCCESS;
+}
@@ -0,0 +1,155 @@
+/// @file rad_bench_memory_pool.cpp
+/// @author Graham Scott
+/// @brief Benchmarks comparing rad::fixed_memory_pool and
+/// rad::dynamic_memory_pool against new/delete, and comparing
+/// the pools' allocation orders after churn.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_bench.h"
+#include "rad_memory_pool.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct object
+    {
+        double values[4];
+    };
+
+    constexpr std::size_t object_count = 256;
+
+    template<typename Pool>
+    void allocate_then_free_all(rad::bench::state& s, Pool& pool)
+    {
+        object* objects[object_count];
+
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            for (std::size_t j = 0; j < object_count; ++j)
+            {
+                objects[j] = pool.allocate();
+                objects[j]->values[0] = static_cast<double>(j);
+            }
+
+            rad::bench::do_not_optimize(objects);
+            rad::bench::clobber_memory();
+
+            for (std::size_t j = 0; j < object_count; ++j)
+            {
+                pool.deallocate(objects[j]);
+            }
+        }
+    }
+
+    constexpr std::size_t churn_object_count = 65536;
+    constexpr std::size_t churn_batch_count = 4096;
+
+    /// @brief Returns a pool whose free list has been scrambled by filling
+    /// it and then freeing half of its objects in a random order.
+    /// NOTE: The pool is only created once, so the setup isn't timed.
+    template<rad::memory_pool_order Order>
+    rad::dynamic_memory_pool<object, Order>& get_churned_pool()
+    {
+        static rad::dynamic_memory_pool<object, Order> pool(1024);
+        static std::vector<object*> objects;
+
+        if (objects.empty())
+        {
+            for (std::size_t i = 0; i < churn_object_count; ++i)
+            {
+                objects.push_back(pool.allocate());
+            }
+
+            std::shuffle(objects.begin(), objects.end(), std::mt19937(1234));
+
+            for (std::size_t i = 0; i < (churn_object_count / 2); ++i)
+            {
+                pool.deallocate(objects.back());
+                objects.pop_back();
+            }
+        }
+
+        return pool;
+    }
+
+    /// @brief Repeatedly allocates a batch of objects from the given pool and
+    /// reads them back in allocation order, as e.g. entity iteration would.
+    template<typename Pool>
+    void allocate_and_iterate(rad::bench::state& s, Pool& pool)
+    {
+        object* batch[churn_batch_count];
+
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            for (std::size_t j = 0; j < churn_batch_count; ++j)
+            {
+                batch[j] = pool.allocate();
+                batch[j]->values[0] = static_cast<double>(j);
+            }
+
+            double sum = 0;
+            for (std::size_t j = 0; j < churn_batch_count; ++j)
+            {
+                sum += batch[j]->values[0];
+            }
+
+            rad::bench::do_not_optimize(sum);
+
+            for (std::size_t j = churn_batch_count; j-- > 0;)
+            {
+                pool.deallocate(batch[j]);
+            }
+        }
+    }
+
+    struct new_delete_pool
+    {
+        object* allocate()
+        {
+            return new object;
+        }
+
+        void deallocate(object* ptr) noexcept
+        {
+            delete ptr;
+        }
+    };
+}
+
+RAD_BENCH("memory_pool/allocate_free_256/fixed_memory_pool", s)
+{
+    rad::fixed_memory_pool<object> pool(object_count);
+    allocate_then_free_all(s, pool);
+}
+
+RAD_BENCH("memory_pool/allocate_free_256/dynamic_memory_pool", s)
+{
+    // NOTE: We purposefully use small blocks here, so that
+    // the pool has to allocate several blocks at first.
+    rad::dynamic_memory_pool<object> pool(32);
+    allocate_then_free_all(s, pool);
+}
+
+RAD_BENCH("memory_pool/allocate_free_256/new_delete", s)
+{
+    new_delete_pool pool;
+    allocate_then_free_all(s, pool);
+}
+
+RAD_BENCH("memory_pool/allocate_iterate_after_churn/lifo", s)
+{
+    allocate_and_iterate(s, get_churned_pool<rad::memory_pool_order::lifo>());
+}
+
+RAD_BENCH("memory_pool/allocate_iterate_after_churn/address", s)
+{
+    allocate_and_iterate(s, get_churned_pool<rad::memory_pool_order::address>());
+}
+
+RAD_BENCH("memory_pool/allocate_iterate_after_churn/block_affine", s)
+{
+    allocate_and_iterate(s, get_churned_pool<rad::memory_pool_order::block_affine>());
+}
@@ -0,0 +1,123 @@
+/// @file rad_bench_path.cpp
+/// @author Graham Scott
+/// @brief Benchmarks comparing rad::path functions against std::filesystem::path.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_bench.h"
+#include "rad_path.h"
+#include <filesystem>
+#include <string>
+
+namespace
+{
+    const std::string test_path = "/home/user/projects/libRad/include/rad/rad_path.tar.gz";
+}
+
+RAD_BENCH("path/get_name/rad", s)
+{
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(test_path);
+        rad::bench::do_not_optimize(rad::path::get_name(test_path));
+    }
+}
+
+RAD_BENCH("path/get_name/std", s)
+{
+    const std::filesystem::path path = test_path;
+
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(path);
+        rad::bench::do_not_optimize(path.filename());
+    }
+}
+
+RAD_BENCH("path/get_parent/rad", s)
+{
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(test_path);
+        rad::bench::do_not_optimize(rad::path::get_parent(test_path));
+    }
+}
+
+RAD_BENCH("path/get_parent/std", s)
+{
+    const std::filesystem::path path = test_path;
+
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(path);
+        rad::bench::do_not_optimize(path.parent_path());
+    }
+}
+
+RAD_BENCH("path/get_extensions/rad", s)
+{
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(test_path);
+        rad::bench::do_not_optimize(rad::path::get_extensions(test_path));
+    }
+}
+
+RAD_BENCH("path/get_extensions/std", s)
+{
+    const std::filesystem::path path = test_path;
+
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(path);
+        rad::bench::do_not_optimize(path.extension());
+    }
+}
+
+RAD_BENCH("path/iterate_components/rad", s)
+{
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(test_path);
+
+        for (const auto component : rad::path::components(test_path))
+        {
+            rad::bench::do_not_optimize(component);
+        }
+    }
+}
+
+RAD_BENCH("path/iterate_components/std", s)
+{
+    const std::filesystem::path path = test_path;
+
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(path);
+
+        for (const auto& component : path)
+        {
+            rad::bench::do_not_optimize(component);
+        }
+    }
+}
+
+RAD_BENCH("path/combine/rad", s)
+{
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(test_path);
+        rad::bench::do_not_optimize(rad::path::combine(test_path, "subdir/file.txt"));
+    }
+}
+
+RAD_BENCH("path/combine/std", s)
+{
+    const std::filesystem::path path = test_path;
+
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::bench::do_not_optimize(path);
+        rad::bench::do_not_optimize(path / "subdir/file.txt");
+    }
+}
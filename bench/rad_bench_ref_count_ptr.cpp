@@ -0,0 +1,63 @@
+/// @file rad_bench_ref_count_ptr.cpp
+/// @author Graham Scott
+/// @brief Benchmarks comparing rad::ref_count_ptr against std::shared_ptr.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_bench.h"
+#include "rad_ref_count_object.h"
+#include "rad_ref_count_ptr.h"
+#include <memory>
+
+namespace
+{
+    struct counted_object : public rad::ref_count_object
+    {
+        int value = 0;
+    };
+
+    struct object
+    {
+        int value = 0;
+    };
+}
+
+RAD_BENCH("ref_count_ptr/create/rad", s)
+{
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::ref_count_ptr<counted_object> ptr(new counted_object());
+        rad::bench::do_not_optimize(ptr.get());
+    }
+}
+
+RAD_BENCH("ref_count_ptr/create/std_make_shared", s)
+{
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        auto ptr = std::make_shared<object>();
+        rad::bench::do_not_optimize(ptr.get());
+    }
+}
+
+RAD_BENCH("ref_count_ptr/copy/rad", s)
+{
+    rad::ref_count_ptr<counted_object> ptr(new counted_object());
+
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        rad::ref_count_ptr<counted_object> copy(ptr);
+        rad::bench::do_not_optimize(copy.get());
+    }
+}
+
+RAD_BENCH("ref_count_ptr/copy/std", s)
+{
+    auto ptr = std::make_shared<object>();
+
+    for (std::size_t i = 0; i < s.iterations(); ++i)
+    {
+        std::shared_ptr<object> copy(ptr);
+        rad::bench::do_not_optimize(copy.get());
+    }
+}
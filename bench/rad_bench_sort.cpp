@@ -0,0 +1,76 @@
+/// @file rad_bench_sort.cpp
+/// @author Graham Scott
+/// @brief Benchmarks comparing rad::radix_sort and rad::parallel_sort against std::sort.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_bench.h"
+#include "rad_sort.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t element_count = 1000000;
+
+    const std::vector<std::uint64_t>& get_random_keys()
+    {
+        static const std::vector<std::uint64_t> keys = []()
+        {
+            std::vector<std::uint64_t> result(element_count);
+            std::mt19937_64 rng(12345);
+
+            for (auto& key : result)
+            {
+                key = rng();
+            }
+
+            return result;
+        }();
+
+        return keys;
+    }
+
+    template<typename SortFunc>
+    void sort_keys(rad::bench::state& s, SortFunc sortFunc)
+    {
+        const auto& keys = get_random_keys();
+        std::vector<std::uint64_t> v(keys.size());
+
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            // NOTE: Copying the keys is included in every benchmark's time.
+            std::copy(keys.begin(), keys.end(), v.begin());
+            sortFunc(rad::span<std::uint64_t>(v.data(), v.size()));
+
+            rad::bench::do_not_optimize(v.data());
+            rad::bench::clobber_memory();
+        }
+    }
+}
+
+RAD_BENCH("sort/uint64_1000000/radix_sort", s)
+{
+    sort_keys(s, [](rad::span<std::uint64_t> keys)
+    {
+        rad::radix_sort(keys);
+    });
+}
+
+RAD_BENCH("sort/uint64_1000000/parallel_sort", s)
+{
+    sort_keys(s, [](rad::span<std::uint64_t> keys)
+    {
+        rad::parallel_sort(keys);
+    });
+}
+
+RAD_BENCH("sort/uint64_1000000/std", s)
+{
+    sort_keys(s, [](rad::span<std::uint64_t> keys)
+    {
+        std::sort(keys.begin(), keys.end());
+    });
+}
@@ -0,0 +1,97 @@
+/// @file rad_bench_stack_or_heap_array.cpp
+/// @author Graham Scott
+/// @brief Benchmarks comparing rad::stack_or_heap_array against heap arrays.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_bench.h"
+#include "rad_stack_or_heap_array.h"
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t small_count = 64;
+    constexpr std::size_t large_count = 4096;
+
+    template<std::size_t Count>
+    void stack_or_heap_array_fill(rad::bench::state& s)
+    {
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            rad::stack_or_heap_array<int, small_count> arr(Count);
+
+            for (std::size_t j = 0; j < Count; ++j)
+            {
+                arr[j] = static_cast<int>(j);
+            }
+
+            rad::bench::do_not_optimize(arr.data());
+            rad::bench::clobber_memory();
+        }
+    }
+
+    template<std::size_t Count>
+    void unique_ptr_array_fill(rad::bench::state& s)
+    {
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            std::unique_ptr<int[]> arr(new int[Count]());
+
+            for (std::size_t j = 0; j < Count; ++j)
+            {
+                arr[j] = static_cast<int>(j);
+            }
+
+            rad::bench::do_not_optimize(arr.get());
+            rad::bench::clobber_memory();
+        }
+    }
+
+    template<std::size_t Count>
+    void std_vector_fill(rad::bench::state& s)
+    {
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            std::vector<int> arr(Count);
+
+            for (std::size_t j = 0; j < Count; ++j)
+            {
+                arr[j] = static_cast<int>(j);
+            }
+
+            rad::bench::do_not_optimize(arr.data());
+            rad::bench::clobber_memory();
+        }
+    }
+}
+
+RAD_BENCH("stack_or_heap_array/fill_64/stack_or_heap_array", s)
+{
+    stack_or_heap_array_fill<small_count>(s);
+}
+
+RAD_BENCH("stack_or_heap_array/fill_64/unique_ptr_array", s)
+{
+    unique_ptr_array_fill<small_count>(s);
+}
+
+RAD_BENCH("stack_or_heap_array/fill_64/std_vector", s)
+{
+    std_vector_fill<small_count>(s);
+}
+
+RAD_BENCH("stack_or_heap_array/fill_4096/stack_or_heap_array", s)
+{
+    stack_or_heap_array_fill<large_count>(s);
+}
+
+RAD_BENCH("stack_or_heap_array/fill_4096/unique_ptr_array", s)
+{
+    unique_ptr_array_fill<large_count>(s);
+}
+
+RAD_BENCH("stack_or_heap_array/fill_4096/std_vector", s)
+{
+    std_vector_fill<large_count>(s);
+}
@@ -0,0 +1,184 @@
+/// @file rad_bench_vector.cpp
+/// @author Graham Scott
+/// @brief Benchmarks comparing rad::vector against std::vector.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_bench.h"
+#include "rad_vector.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t element_count = 1000;
+
+    template<typename Vector>
+    void push_back_ints(rad::bench::state& s)
+    {
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            Vector v;
+
+            for (std::size_t j = 0; j < element_count; ++j)
+            {
+                v.push_back(static_cast<int>(j));
+            }
+
+            rad::bench::do_not_optimize(v.data());
+            rad::bench::clobber_memory();
+        }
+    }
+
+    template<typename Vector>
+    void push_back_ints_reserved(rad::bench::state& s)
+    {
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            Vector v;
+            v.reserve(element_count);
+
+            for (std::size_t j = 0; j < element_count; ++j)
+            {
+                v.push_back(static_cast<int>(j));
+            }
+
+            rad::bench::do_not_optimize(v.data());
+            rad::bench::clobber_memory();
+        }
+    }
+
+    template<typename Vector>
+    void emplace_back_pairs(rad::bench::state& s)
+    {
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            Vector v;
+
+            for (std::size_t j = 0; j < element_count; ++j)
+            {
+                v.emplace_back(static_cast<int>(j), static_cast<float>(j));
+            }
+
+            rad::bench::do_not_optimize(v.data());
+            rad::bench::clobber_memory();
+        }
+    }
+
+    template<typename Vector>
+    void push_back_strings(rad::bench::state& s)
+    {
+        // NOTE: This string is long enough to not fit within the small string buffer,
+        // so growing the vector has to move (not just copy) each string.
+        const std::string str = "a string which is too long for the SSO buffer";
+
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            Vector v;
+
+            for (std::size_t j = 0; j < element_count; ++j)
+            {
+                v.push_back(str);
+            }
+
+            rad::bench::do_not_optimize(v.data());
+            rad::bench::clobber_memory();
+        }
+    }
+
+    constexpr std::size_t cull_element_count = 100000;
+
+    struct cull_item
+    {
+        float   position[3];
+        int     id;
+    };
+
+    /// @brief Erases every third element, as e.g. a per-frame culling pass would.
+    template<typename Vector, typename EraseFunc>
+    void cull_items(rad::bench::state& s, EraseFunc eraseFunc)
+    {
+        for (std::size_t i = 0; i < s.iterations(); ++i)
+        {
+            // NOTE: Filling the vector is included in both benchmarks' times.
+            Vector v;
+            v.reserve(cull_element_count);
+
+            for (std::size_t j = 0; j < cull_element_count; ++j)
+            {
+                const auto f = static_cast<float>(j);
+                v.push_back(cull_item{ { f, f, f }, static_cast<int>(j) });
+            }
+
+            eraseFunc(v);
+
+            rad::bench::do_not_optimize(v.data());
+            rad::bench::clobber_memory();
+        }
+    }
+}
+
+RAD_BENCH("vector/push_back_int_1000/rad", s)
+{
+    push_back_ints<rad::vector<int>>(s);
+}
+
+RAD_BENCH("vector/push_back_int_1000/std", s)
+{
+    push_back_ints<std::vector<int>>(s);
+}
+
+RAD_BENCH("vector/push_back_int_1000_reserved/rad", s)
+{
+    push_back_ints_reserved<rad::vector<int>>(s);
+}
+
+RAD_BENCH("vector/push_back_int_1000_reserved/std", s)
+{
+    push_back_ints_reserved<std::vector<int>>(s);
+}
+
+RAD_BENCH("vector/emplace_back_pair_1000/rad", s)
+{
+    emplace_back_pairs<rad::vector<std::pair<int, float>>>(s);
+}
+
+RAD_BENCH("vector/emplace_back_pair_1000/std", s)
+{
+    emplace_back_pairs<std::vector<std::pair<int, float>>>(s);
+}
+
+RAD_BENCH("vector/push_back_string_1000/rad", s)
+{
+    push_back_strings<rad::vector<std::string>>(s);
+}
+
+RAD_BENCH("vector/push_back_string_1000/std", s)
+{
+    push_back_strings<std::vector<std::string>>(s);
+}
+
+RAD_BENCH("vector/erase_if_100000/rad", s)
+{
+    cull_items<rad::vector<cull_item>>(s, [](rad::vector<cull_item>& v)
+    {
+        v.erase_if([](const cull_item& item)
+        {
+            return (item.id % 3) == 0;
+        });
+    });
+}
+
+RAD_BENCH("vector/erase_if_100000/std", s)
+{
+    cull_items<std::vector<cull_item>>(s, [](std::vector<cull_item>& v)
+    {
+        v.erase(std::remove_if(v.begin(), v.end(), [](const cull_item& item)
+        {
+            return (item.id % 3) == 0;
+        }),
+        v.end());
+    });
+}
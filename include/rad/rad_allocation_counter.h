@@ -0,0 +1,212 @@
+/// @file rad_allocation_counter.h
+/// @author Graham Scott
+/// @brief Header file providing rad::scoped_allocation_counter, which counts the
+/// allocations made on the current thread, and helpers for asserting on them.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_ALLOCATION_COUNTER_H_INCLUDED
+#define RAD_ALLOCATION_COUNTER_H_INCLUDED
+
+#include "rad_base.h"
+#include <cstddef>
+
+namespace rad
+{
+struct allocation_stats
+{
+    /// @brief The number of new blocks which were allocated.
+    std::size_t allocations = 0;
+
+    /// @brief The number of existing blocks which were reallocated.
+    std::size_t reallocations = 0;
+
+    /// @brief The number of blocks which were freed.
+    std::size_t frees = 0;
+
+    /// @brief The total number of bytes requested by all allocations and reallocations.
+    std::size_t bytes = 0;
+
+    allocation_stats& operator+=(const allocation_stats& other) noexcept
+    {
+        allocations += other.allocations;
+        reallocations += other.reallocations;
+        frees += other.frees;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+/// @brief Counts every allocation, reallocation, and free made through libRad's
+/// allocation functions (RAD_ALLOC etc., and thus also operator new/delete if
+/// RAD_USE_OPERATOR_NEW_DELETE_REPLACEMENTS is 1) on the current thread, from its
+/// construction until its destruction.
+///
+/// Allocations made on other threads are not counted. Counters can be nested; when an
+/// inner counter is destroyed, its stats are also added to the next outer counter.
+///
+/// NOTE: Allocations made via the standard malloc/free (or other allocators) are not counted.
+///
+/// NOTE: Allocations are only counted if libRad was built with RAD_USE_ALLOCATION_COUNTERS
+/// set to 1 (via the CMake option of the same name); otherwise, the stats are always 0.
+class scoped_allocation_counter
+{
+    allocation_stats    stats_;
+#if RAD_USE_ALLOCATION_COUNTERS == 1
+    allocation_stats*   prevStats_;
+#endif
+
+public:
+    inline const allocation_stats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+    inline std::size_t allocations() const noexcept
+    {
+        return stats_.allocations;
+    }
+
+    inline std::size_t reallocations() const noexcept
+    {
+        return stats_.reallocations;
+    }
+
+    inline std::size_t frees() const noexcept
+    {
+        return stats_.frees;
+    }
+
+    inline std::size_t bytes() const noexcept
+    {
+        return stats_.bytes;
+    }
+
+    scoped_allocation_counter& operator=(const scoped_allocation_counter& other) = delete;
+
+#if RAD_USE_ALLOCATION_COUNTERS == 1
+    RAD_API scoped_allocation_counter() noexcept;
+
+    scoped_allocation_counter(const scoped_allocation_counter& other) = delete;
+
+    RAD_API ~scoped_allocation_counter();
+#else
+    scoped_allocation_counter() noexcept = default;
+
+    scoped_allocation_counter(const scoped_allocation_counter& other) = delete;
+#endif
+};
+
+#if RAD_USE_ALLOCATION_COUNTERS == 1 && RAD_USE_DEBUG_MEMORY == 1
+    /// @brief Returns the total number of allocations, reallocations, frees, and
+    /// bytes requested through libRad's allocation functions across all threads,
+    /// since the start of the program.
+    ///
+    /// The number of live blocks is (allocations - frees).
+    RAD_API allocation_stats get_global_allocation_stats() noexcept;
+#endif
+
+#if RAD_USE_ALLOCATION_COUNTERS == 1
+/// @brief The function which is called when an allocation expectation is not met.
+/// @param filePath The path of the source file containing the failed expectation.
+/// @param lineNumber The line number of the failed expectation.
+/// @param maxAllocations The maximum number of allocations which were expected.
+/// @param stats The allocation stats which were actually measured.
+using allocation_expectation_handler = void (*)(const char* filePath,
+    unsigned int lineNumber, std::size_t maxAllocations, const allocation_stats& stats);
+
+/// @brief Sets the function which is called when an allocation expectation is not met.
+///
+/// The default handler prints an error message to stderr and calls std::abort.
+/// Test frameworks may want to set a handler which logs or records a failure instead.
+///
+/// NOTE: The handler is called from a destructor, so it must not throw; if it does,
+/// std::terminate is called. To stop at the failure, the handler should abort instead.
+///
+/// @param handler The handler to use, or nullptr to restore the default handler.
+/// @return The previous handler.
+RAD_API allocation_expectation_handler set_allocation_expectation_handler(
+    allocation_expectation_handler handler) noexcept;
+
+namespace detail_
+{
+    RAD_API void report_allocation_expectation_failure_(const char* filePath,
+        unsigned int lineNumber, std::size_t maxAllocations,
+        const allocation_stats& stats);
+
+    class allocation_expectation_
+    {
+        scoped_allocation_counter   counter_;
+        const char*                 filePath_;
+        unsigned int                lineNumber_;
+        std::size_t                 maxAllocations_;
+        bool                        hasRun_ = false;
+
+    public:
+        inline bool run_once_() noexcept
+        {
+            const bool shouldRun = !hasRun_;
+            hasRun_ = true;
+            return shouldRun;
+        }
+
+        inline allocation_expectation_(std::size_t maxAllocations,
+            const char* filePath, unsigned int lineNumber) noexcept
+            : filePath_(filePath)
+            , lineNumber_(lineNumber)
+            , maxAllocations_(maxAllocations)
+        {
+        }
+
+        inline ~allocation_expectation_() noexcept
+        {
+            // NOTE: Reallocations are counted too, as they're just as
+            // costly as (and often actually are) new allocations.
+            const auto& stats = counter_.stats();
+
+            if ((stats.allocations + stats.reallocations) > maxAllocations_)
+            {
+                report_allocation_expectation_failure_(filePath_,
+                    lineNumber_, maxAllocations_, stats);
+            }
+        }
+    };
+
+    #define RAD_ALLOCATION_EXPECTATION_VAR_NAME2_(lineNumber)\
+        ZZZZ_allocation_expectation_from_line_##lineNumber##_
+
+    #define RAD_ALLOCATION_EXPECTATION_VAR_NAME1_(lineNumber)\
+        RAD_ALLOCATION_EXPECTATION_VAR_NAME2_(lineNumber)
+}
+
+/// @brief Expects the following block to make at most the given number of
+/// allocations (or reallocations) on the current thread. Example usage:
+///
+///     RAD_EXPECT_MAX_ALLOCATIONS(1)
+///     {
+///         handle_request(request);
+///     }
+#define RAD_EXPECT_MAX_ALLOCATIONS(maxAllocations)\
+    for (::rad::detail_::allocation_expectation_\
+        RAD_ALLOCATION_EXPECTATION_VAR_NAME1_(__LINE__)((maxAllocations), __FILE__, __LINE__);\
+        RAD_ALLOCATION_EXPECTATION_VAR_NAME1_(__LINE__).run_once_();)
+#else
+// NOTE: Allocation counting is compiled out; expectations just run the following
+// block once, so that callers don't have to wrap every use of them in an #if.
+
+#define RAD_EXPECT_MAX_ALLOCATIONS(maxAllocations)\
+    for (bool ZZZZ_allocation_expectation_has_run_ = (static_cast<void>(maxAllocations), false);\
+        !ZZZZ_allocation_expectation_has_run_; ZZZZ_allocation_expectation_has_run_ = true)
+#endif
+
+/// @brief Expects the following block to make no allocations (or reallocations)
+/// on the current thread. Example usage:
+///
+///     RAD_EXPECT_NO_ALLOCATIONS
+///     {
+///         handle_request(request);
+///     }
+#define RAD_EXPECT_NO_ALLOCATIONS RAD_EXPECT_MAX_ALLOCATIONS(0)
+}
+
+#endif
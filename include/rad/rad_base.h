@@ -50,6 +50,20 @@
     #define RAD_USE_OPERATOR_NEW_DELETE_REPLACEMENTS 1
 #endif
 
+// Tracing
+// NOTE: If this value is not set to 1 while compiling libRad,
+// tracing functions will not be available!
+#ifndef RAD_USE_TRACING
+    #define RAD_USE_TRACING 0
+#endif
+
+// Allocation counters
+// NOTE: If this value is not set to 1 while compiling libRad,
+// scoped_allocation_counters will not count any allocations!
+#ifndef RAD_USE_ALLOCATION_COUNTERS
+    #define RAD_USE_ALLOCATION_COUNTERS 0
+#endif
+
 // Strict bounds checking
 #ifndef RAD_USE_STRICT_BOUNDS_CHECKING
     #ifndef NDEBUG
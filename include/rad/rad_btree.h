@@ -0,0 +1,1467 @@
+/// @file rad_btree.h
+/// @author Graham Scott
+/// @brief Header file providing rad::btree_map and rad::btree_set, ordered
+/// containers implemented as cache-conscious B+trees.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_BTREE_H_INCLUDED
+#define RAD_BTREE_H_INCLUDED
+
+#include "rad_base.h"
+#include "rad_vector.h"
+#include "rad_memory_pool.h"
+#include "rad_span.h"
+#include <type_traits>
+#include <functional>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+#ifndef RAD_SIMD_HAS_SSE2
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) ||\
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define RAD_SIMD_HAS_SSE2 1
+    #else
+        #define RAD_SIMD_HAS_SSE2 0
+    #endif
+#endif
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    #include <emmintrin.h>
+#endif
+
+namespace rad
+{
+namespace detail_
+{
+    constexpr std::size_t btree_cache_line_size_ = 64;
+
+    template<typename Mapped, std::size_t Count>
+    struct btree_values_
+    {
+        Mapped  items[Count];
+    };
+
+    template<std::size_t Count>
+    struct btree_values_<void, Count>
+    {
+    };
+
+    /// @brief Whether the keys within each node can be searched by simply
+    /// counting how many of them are less/greater than the given key, which
+    /// is branchless, and can be vectorized.
+    template<typename Key, typename Compare>
+    constexpr bool btree_uses_counting_search_ = (std::is_arithmetic_v<Key> &&
+        (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>));
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    inline std::size_t btree_mask_bit_count_(int mask) noexcept
+    {
+        // NOTE: The masks here never have more than 4 bits set.
+        constexpr unsigned char bitCounts[16] = {
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+        };
+
+        return bitCounts[mask];
+    }
+#endif
+
+    /// @brief Returns the number of keys in the given sorted range which are less than key.
+    template<typename Key>
+    std::size_t btree_count_less_(const Key* keys, std::size_t count, Key key) noexcept
+    {
+        std::size_t i = 0, result = 0;
+
+    #if RAD_SIMD_HAS_SSE2 == 1
+        if constexpr (std::is_same_v<Key, std::int32_t>)
+        {
+            const auto k = _mm_set1_epi32(key);
+            for (; (i + 4) <= count; i += 4)
+            {
+                const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+                result += btree_mask_bit_count_(_mm_movemask_ps(
+                    _mm_castsi128_ps(_mm_cmplt_epi32(v, k))));
+            }
+        }
+        else if constexpr (std::is_same_v<Key, float>)
+        {
+            const auto k = _mm_set1_ps(key);
+            for (; (i + 4) <= count; i += 4)
+            {
+                result += btree_mask_bit_count_(_mm_movemask_ps(
+                    _mm_cmplt_ps(_mm_loadu_ps(keys + i), k)));
+            }
+        }
+        else if constexpr (std::is_same_v<Key, double>)
+        {
+            const auto k = _mm_set1_pd(key);
+            for (; (i + 2) <= count; i += 2)
+            {
+                result += btree_mask_bit_count_(_mm_movemask_pd(
+                    _mm_cmplt_pd(_mm_loadu_pd(keys + i), k)));
+            }
+        }
+    #endif
+
+        // NOTE: This loop is branchless, so compilers can vectorize
+        // it for key types which aren't handled explicitly above.
+        for (; i < count; ++i)
+        {
+            result += static_cast<std::size_t>(keys[i] < key);
+        }
+
+        return result;
+    }
+
+    /// @brief Returns the number of keys in the given sorted range which are greater than key.
+    template<typename Key>
+    std::size_t btree_count_greater_(const Key* keys, std::size_t count, Key key) noexcept
+    {
+        std::size_t i = 0, result = 0;
+
+    #if RAD_SIMD_HAS_SSE2 == 1
+        if constexpr (std::is_same_v<Key, std::int32_t>)
+        {
+            const auto k = _mm_set1_epi32(key);
+            for (; (i + 4) <= count; i += 4)
+            {
+                const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+                result += btree_mask_bit_count_(_mm_movemask_ps(
+                    _mm_castsi128_ps(_mm_cmpgt_epi32(v, k))));
+            }
+        }
+        else if constexpr (std::is_same_v<Key, float>)
+        {
+            const auto k = _mm_set1_ps(key);
+            for (; (i + 4) <= count; i += 4)
+            {
+                result += btree_mask_bit_count_(_mm_movemask_ps(
+                    _mm_cmpgt_ps(_mm_loadu_ps(keys + i), k)));
+            }
+        }
+        else if constexpr (std::is_same_v<Key, double>)
+        {
+            const auto k = _mm_set1_pd(key);
+            for (; (i + 2) <= count; i += 2)
+            {
+                result += btree_mask_bit_count_(_mm_movemask_pd(
+                    _mm_cmpgt_pd(_mm_loadu_pd(keys + i), k)));
+            }
+        }
+    #endif
+
+        for (; i < count; ++i)
+        {
+            result += static_cast<std::size_t>(key < keys[i]);
+        }
+
+        return result;
+    }
+
+    /// @brief The implementation shared by btree_map and btree_set.
+    /// @tparam Mapped The type of values stored alongside each key, or void for sets.
+    template<typename Key, typename Mapped, typename Compare, std::size_t NodeBytes>
+    class btree_
+    {
+        static_assert((NodeBytes % btree_cache_line_size_) == 0,
+            "B+tree node sizes must be a multiple of the cache line size");
+
+        static_assert(std::is_nothrow_move_constructible_v<Key> &&
+            std::is_nothrow_move_assignable_v<Key> &&
+            (std::is_void_v<Mapped> || std::is_nothrow_move_assignable_v<Mapped>),
+            "B+tree keys and values must be nothrow movable");
+
+    protected:
+        static constexpr bool has_values_ = !std::is_void_v<Mapped>;
+
+        static constexpr std::size_t mapped_size_ = []() constexpr
+        {
+            if constexpr (has_values_)
+            {
+                return sizeof(Mapped);
+            }
+            else
+            {
+                return std::size_t(0);
+            }
+        }();
+
+        struct node_
+        {
+            std::uint16_t   count;
+            bool            isLeaf;
+        };
+
+        // NOTE: Node capacities are computed such that each node
+        // fits within (roughly) NodeBytes bytes, if possible.
+        static constexpr std::size_t leaf_capacity_ = std::max<std::size_t>(3,
+            (NodeBytes - sizeof(node_) - (sizeof(void*) * 2)) /
+            (sizeof(Key) + mapped_size_));
+
+        static constexpr std::size_t inner_capacity_ = std::max<std::size_t>(3,
+            (NodeBytes - sizeof(node_) - sizeof(void*)) /
+            (sizeof(Key) + sizeof(void*)));
+
+        static_assert(leaf_capacity_ <= UINT16_MAX && inner_capacity_ <= UINT16_MAX);
+
+        static constexpr std::size_t min_leaf_count_ = (leaf_capacity_ / 2);
+        static constexpr std::size_t min_inner_count_ = (inner_capacity_ / 2);
+
+        // NOTE: Every non-root node has at least 2 children, so this is plenty.
+        static constexpr std::size_t max_depth_ = 64;
+
+        // NOTE: We allocate nodes from pools in blocks of this many nodes.
+        static constexpr std::size_t nodes_per_block_ = 64;
+
+        struct leaf_ : node_
+        {
+            leaf_*                                      prev = nullptr;
+            leaf_*                                      next = nullptr;
+            Key                                         keys[leaf_capacity_];
+            btree_values_<Mapped, leaf_capacity_>       values;
+        };
+
+        struct inner_ : node_
+        {
+            /// @brief Every key within children[i + 1] is greater than or equal to keys[i].
+            Key                                         keys[inner_capacity_];
+            node_*                                      children[inner_capacity_ + 1];
+        };
+
+        struct path_entry_
+        {
+            inner_*         node;
+            std::size_t     childIndex;
+        };
+
+        using mapped_storage_t_ = std::conditional_t<has_values_, Mapped, char>;
+
+        Compare                         compare_;
+        node_*                          root_ = nullptr;
+        leaf_*                          firstLeaf_ = nullptr;
+        leaf_*                          lastLeaf_ = nullptr;
+        std::size_t                     size_ = 0;
+        dynamic_memory_pool<leaf_>      leafPool_;
+        dynamic_memory_pool<inner_>     innerPool_;
+
+        leaf_* create_leaf_()
+        {
+            // NOTE: The pools don't allocate any blocks until the first node is needed.
+            if (leafPool_.block_count() == 0)
+            {
+                leafPool_ = dynamic_memory_pool<leaf_>(nodes_per_block_);
+            }
+
+            const auto leaf = leafPool_.allocate();
+
+            try
+            {
+                ::new (leaf) leaf_();
+            }
+            catch (...)
+            {
+                leafPool_.deallocate(leaf);
+                throw;
+            }
+
+            leaf->count = 0;
+            leaf->isLeaf = true;
+            return leaf;
+        }
+
+        inner_* create_inner_()
+        {
+            if (innerPool_.block_count() == 0)
+            {
+                innerPool_ = dynamic_memory_pool<inner_>(nodes_per_block_);
+            }
+
+            const auto inner = innerPool_.allocate();
+
+            try
+            {
+                ::new (inner) inner_();
+            }
+            catch (...)
+            {
+                innerPool_.deallocate(inner);
+                throw;
+            }
+
+            inner->count = 0;
+            inner->isLeaf = false;
+            return inner;
+        }
+
+        void free_leaf_(leaf_* leaf) noexcept
+        {
+            leaf->~leaf_();
+            leafPool_.deallocate(leaf);
+        }
+
+        void free_inner_(inner_* inner) noexcept
+        {
+            inner->~inner_();
+            innerPool_.deallocate(inner);
+        }
+
+        void free_subtree_(node_* node) noexcept
+        {
+            if (node->isLeaf)
+            {
+                free_leaf_(static_cast<leaf_*>(node));
+            }
+            else
+            {
+                const auto inner = static_cast<inner_*>(node);
+                for (std::size_t i = 0; i <= inner->count; ++i)
+                {
+                    free_subtree_(inner->children[i]);
+                }
+
+                free_inner_(inner);
+            }
+        }
+
+        void reset_() noexcept
+        {
+            root_ = nullptr;
+            firstLeaf_ = nullptr;
+            lastLeaf_ = nullptr;
+            size_ = 0;
+        }
+
+        std::size_t leaf_lower_bound_(const leaf_& leaf, const Key& key) const
+        {
+            if constexpr (btree_uses_counting_search_<Key, Compare>)
+            {
+                return btree_count_less_(leaf.keys, leaf.count, key);
+            }
+            else
+            {
+                return static_cast<std::size_t>(std::lower_bound(leaf.keys,
+                    leaf.keys + leaf.count, key, compare_) - leaf.keys);
+            }
+        }
+
+        std::size_t leaf_upper_bound_(const leaf_& leaf, const Key& key) const
+        {
+            if constexpr (btree_uses_counting_search_<Key, Compare>)
+            {
+                return (leaf.count - btree_count_greater_(leaf.keys, leaf.count, key));
+            }
+            else
+            {
+                return static_cast<std::size_t>(std::upper_bound(leaf.keys,
+                    leaf.keys + leaf.count, key, compare_) - leaf.keys);
+            }
+        }
+
+        std::size_t inner_child_index_(const inner_& inner, const Key& key) const
+        {
+            if constexpr (btree_uses_counting_search_<Key, Compare>)
+            {
+                return (inner.count - btree_count_greater_(inner.keys, inner.count, key));
+            }
+            else
+            {
+                return static_cast<std::size_t>(std::upper_bound(inner.keys,
+                    inner.keys + inner.count, key, compare_) - inner.keys);
+            }
+        }
+
+        /// @brief Returns the leaf which the given key belongs in; the tree must not be empty.
+        leaf_* find_leaf_(const Key& key) const
+        {
+            auto node = root_;
+
+            while (!node->isLeaf)
+            {
+                const auto inner = static_cast<inner_*>(node);
+                node = inner->children[inner_child_index_(*inner, key)];
+            }
+
+            return static_cast<leaf_*>(node);
+        }
+
+        /// @brief Like find_leaf_, but also records the path taken to the leaf.
+        leaf_* find_leaf_(const Key& key, path_entry_* path, std::size_t& depth) const
+        {
+            auto node = root_;
+            depth = 0;
+
+            while (!node->isLeaf)
+            {
+                const auto inner = static_cast<inner_*>(node);
+                const auto childIndex = inner_child_index_(*inner, key);
+
+                path[depth++] = { inner, childIndex };
+                node = inner->children[childIndex];
+            }
+
+            return static_cast<leaf_*>(node);
+        }
+
+        /// @brief Moves count items from src (starting at srcIndex) to dst (starting at dstIndex).
+        /// NOTE: The ranges may overlap only if dst and src are the same leaf.
+        static void move_leaf_items_(leaf_& dst, std::size_t dstIndex,
+            leaf_& src, std::size_t srcIndex, std::size_t count) noexcept
+        {
+            if (&dst == &src && dstIndex > srcIndex)
+            {
+                std::move_backward(src.keys + srcIndex, src.keys + srcIndex + count,
+                    dst.keys + dstIndex + count);
+
+                if constexpr (has_values_)
+                {
+                    std::move_backward(src.values.items + srcIndex,
+                        src.values.items + srcIndex + count,
+                        dst.values.items + dstIndex + count);
+                }
+            }
+            else
+            {
+                std::move(src.keys + srcIndex, src.keys + srcIndex + count,
+                    dst.keys + dstIndex);
+
+                if constexpr (has_values_)
+                {
+                    std::move(src.values.items + srcIndex,
+                        src.values.items + srcIndex + count,
+                        dst.values.items + dstIndex);
+                }
+            }
+        }
+
+        static void insert_into_leaf_(leaf_& leaf, std::size_t index,
+            Key&& key, mapped_storage_t_&& value) noexcept
+        {
+            move_leaf_items_(leaf, index + 1, leaf, index, leaf.count - index);
+            leaf.keys[index] = std::move(key);
+
+            if constexpr (has_values_)
+            {
+                leaf.values.items[index] = std::move(value);
+            }
+
+            ++leaf.count;
+        }
+
+        static void insert_into_inner_(inner_& inner, std::size_t index,
+            Key&& key, node_* rightChild) noexcept
+        {
+            std::move_backward(inner.keys + index, inner.keys + inner.count,
+                inner.keys + inner.count + 1);
+
+            std::copy_backward(inner.children + index + 1, inner.children + inner.count + 1,
+                inner.children + inner.count + 2);
+
+            inner.keys[index] = std::move(key);
+            inner.children[index + 1] = rightChild;
+            ++inner.count;
+        }
+
+        static void erase_from_inner_(inner_& inner, std::size_t keyIndex) noexcept
+        {
+            // NOTE: This erases the given key, and the child to its right.
+            std::move(inner.keys + keyIndex + 1, inner.keys + inner.count,
+                inner.keys + keyIndex);
+
+            std::copy(inner.children + keyIndex + 2, inner.children + inner.count + 1,
+                inner.children + keyIndex + 1);
+
+            --inner.count;
+        }
+
+        /// @brief Inserts the given separator key and new right child into the parent
+        /// recorded at the given depth within path, splitting full parents as necessary.
+        /// @param spareInners Pre-allocated inner nodes to use for any splits.
+        void insert_into_parent_(path_entry_* path, std::size_t depth,
+            Key separator, node_* rightChild, inner_** spareInners) noexcept
+        {
+            while (depth > 0)
+            {
+                const auto& entry = path[--depth];
+                const auto inner = entry.node;
+                const auto childIndex = entry.childIndex;
+
+                if (inner->count < inner_capacity_)
+                {
+                    insert_into_inner_(*inner, childIndex, std::move(separator), rightChild);
+                    return;
+                }
+
+                // Split the full parent in half, promoting its middle key.
+                constexpr std::size_t mid = (inner_capacity_ / 2);
+                const auto right = *(spareInners++);
+
+                Key promoted = std::move(inner->keys[mid]);
+
+                std::move(inner->keys + mid + 1, inner->keys + inner_capacity_, right->keys);
+                std::copy(inner->children + mid + 1,
+                    inner->children + inner_capacity_ + 1, right->children);
+
+                right->count = static_cast<std::uint16_t>(inner_capacity_ - mid - 1);
+                inner->count = static_cast<std::uint16_t>(mid);
+
+                if (childIndex <= mid)
+                {
+                    insert_into_inner_(*inner, childIndex, std::move(separator), rightChild);
+                }
+                else
+                {
+                    insert_into_inner_(*right, childIndex - mid - 1,
+                        std::move(separator), rightChild);
+                }
+
+                separator = std::move(promoted);
+                rightChild = right;
+            }
+
+            // The root was split, so grow the tree by one level.
+            const auto newRoot = *spareInners;
+
+            newRoot->count = 1;
+            newRoot->keys[0] = std::move(separator);
+            newRoot->children[0] = root_;
+            newRoot->children[1] = rightChild;
+            root_ = newRoot;
+        }
+
+        template<typename LeafPtr>
+        static inline pair<LeafPtr, std::size_t> normalize_position_(
+            LeafPtr leaf, std::size_t index) noexcept
+        {
+            // NOTE: Positions past the end of a leaf refer to the start of the next leaf.
+            if (index == leaf->count && leaf->next)
+            {
+                return { leaf->next, 0 };
+            }
+
+            return { leaf, index };
+        }
+
+    public:
+        template<bool IsConst>
+        class basic_iterator
+        {
+            template<bool> friend class basic_iterator;
+            friend class btree_;
+
+            using leaf_ptr_ = std::conditional_t<IsConst, const leaf_*, leaf_*>;
+
+            leaf_ptr_       curLeaf_ = nullptr;
+            std::size_t     index_ = 0;
+
+            basic_iterator(leaf_ptr_ leaf, std::size_t index) noexcept
+                : curLeaf_(leaf)
+                , index_(index)
+            {
+            }
+
+        public:
+            using mapped_reference = std::conditional_t<IsConst,
+                const mapped_storage_t_&, mapped_storage_t_&>;
+
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = std::conditional_t<has_values_,
+                std::pair<Key, mapped_storage_t_>, Key>;
+            using reference         = std::conditional_t<has_values_,
+                std::pair<const Key&, mapped_reference>, const Key&>;
+            using pointer           = void;
+
+            inline const Key& key() const noexcept
+            {
+                return curLeaf_->keys[index_];
+            }
+
+            template<bool HasValues = has_values_, std::enable_if_t<HasValues, int> = 0>
+            inline mapped_reference value() const noexcept
+            {
+                return curLeaf_->values.items[index_];
+            }
+
+            inline reference operator*() const noexcept
+            {
+                if constexpr (has_values_)
+                {
+                    return reference(key(), value());
+                }
+                else
+                {
+                    return key();
+                }
+            }
+
+            basic_iterator& operator++() noexcept
+            {
+                ++index_;
+
+                // NOTE: We stay at the end of the last leaf, which is the end iterator.
+                if (index_ == curLeaf_->count && curLeaf_->next)
+                {
+                    curLeaf_ = curLeaf_->next;
+                    index_ = 0;
+                }
+
+                return *this;
+            }
+
+            inline basic_iterator operator++(int) noexcept
+            {
+                const auto it = *this;
+                ++(*this);
+                return it;
+            }
+
+            basic_iterator& operator--() noexcept
+            {
+                if (index_ == 0)
+                {
+                    curLeaf_ = curLeaf_->prev;
+                    index_ = curLeaf_->count;
+                }
+
+                --index_;
+                return *this;
+            }
+
+            inline basic_iterator operator--(int) noexcept
+            {
+                const auto it = *this;
+                --(*this);
+                return it;
+            }
+
+            inline bool operator==(const basic_iterator& other) const noexcept
+            {
+                return (curLeaf_ == other.curLeaf_ && index_ == other.index_);
+            }
+
+            inline bool operator!=(const basic_iterator& other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+            template<bool OtherIsConst, std::enable_if_t<IsConst && !OtherIsConst, int> = 0>
+            inline basic_iterator(const basic_iterator<OtherIsConst>& other) noexcept
+                : curLeaf_(other.curLeaf_)
+                , index_(other.index_)
+            {
+            }
+
+            basic_iterator() noexcept = default;
+        };
+
+        using key_type          = Key;
+        using key_compare       = Compare;
+        using size_type         = std::size_t;
+        using iterator          = basic_iterator<!has_values_>;
+        using const_iterator    = basic_iterator<true>;
+
+        /// @brief The maximum number of keys stored within each leaf node.
+        static constexpr std::size_t leaf_capacity = leaf_capacity_;
+
+        /// @brief The maximum number of keys stored within each inner node.
+        static constexpr std::size_t inner_capacity = inner_capacity_;
+
+    protected:
+        template<typename LeafPtr>
+        static inline basic_iterator<std::is_const_v<std::remove_pointer_t<LeafPtr>>>
+            make_iterator_(LeafPtr leaf, std::size_t index) noexcept
+        {
+            const auto pos = normalize_position_(leaf, index);
+            return { pos.first(), pos.second() };
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> emplace_(const Key& key, Args&&... args)
+        {
+            if (!root_)
+            {
+                const auto leaf = create_leaf_();
+                root_ = firstLeaf_ = lastLeaf_ = leaf;
+            }
+
+            path_entry_ path[max_depth_];
+            std::size_t depth;
+
+            auto leaf = find_leaf_(key, path, depth);
+            auto index = leaf_lower_bound_(*leaf, key);
+
+            if (index < leaf->count && !compare_(key, leaf->keys[index]))
+            {
+                return { iterator(leaf, index), false };
+            }
+
+            // NOTE: We construct the value, and copy the key, before modifying the
+            // tree, so that the tree is left untouched if either of them throws.
+            // From then on, we only ever move them, which can't throw.
+            auto value = mapped_storage_t_(std::forward<Args>(args)...);
+            Key newKey(key);
+
+            if (leaf->count < leaf_capacity_)
+            {
+                insert_into_leaf_(*leaf, index, std::move(newKey), std::move(value));
+                ++size_;
+                return { iterator(leaf, index), true };
+            }
+
+            // NOTE: When appending to the last leaf (e.g. when inserting keys in
+            // ascending order), we leave the old leaf full, rather than half-empty.
+            const bool isAppend = (index == leaf_capacity_ && !leaf->next);
+            const std::size_t splitIndex = (isAppend) ? leaf_capacity_ : min_leaf_count_;
+
+            // The first key within the new leaf is inserted into the parent as a
+            // separator, so we copy it up-front too, for the same reason as above.
+            Key separator = (isAppend) ? newKey : leaf->keys[splitIndex];
+
+            // The leaf is full, so we have to split it. We allocate every node the
+            // split could require up-front, so that the tree is left untouched if
+            // any of the allocations throw.
+            std::size_t fullParentCount = 0;
+
+            while (fullParentCount < depth &&
+                path[depth - fullParentCount - 1].node->count == inner_capacity_)
+            {
+                ++fullParentCount;
+            }
+
+            const std::size_t spareInnerCount = (fullParentCount == depth) ?
+                (fullParentCount + 1) : fullParentCount;
+
+            inner_* spareInners[max_depth_ + 1];
+            std::size_t allocatedInnerCount = 0;
+            leaf_* newLeaf;
+
+            try
+            {
+                for (; allocatedInnerCount < spareInnerCount; ++allocatedInnerCount)
+                {
+                    spareInners[allocatedInnerCount] = create_inner_();
+                }
+
+                newLeaf = create_leaf_();
+            }
+            catch (...)
+            {
+                while (allocatedInnerCount > 0)
+                {
+                    free_inner_(spareInners[--allocatedInnerCount]);
+                }
+
+                throw;
+            }
+
+            move_leaf_items_(*newLeaf, 0, *leaf, splitIndex, leaf_capacity_ - splitIndex);
+            newLeaf->count = static_cast<std::uint16_t>(leaf_capacity_ - splitIndex);
+            leaf->count = static_cast<std::uint16_t>(splitIndex);
+
+            newLeaf->prev = leaf;
+            newLeaf->next = leaf->next;
+
+            if (leaf->next)
+            {
+                leaf->next->prev = newLeaf;
+            }
+            else
+            {
+                lastLeaf_ = newLeaf;
+            }
+
+            leaf->next = newLeaf;
+
+            if (isAppend || index > splitIndex)
+            {
+                leaf = newLeaf;
+                index -= splitIndex;
+            }
+
+            insert_into_leaf_(*leaf, index, std::move(newKey), std::move(value));
+            insert_into_parent_(path, depth, std::move(separator), newLeaf, spareInners);
+
+            ++size_;
+            return { iterator(leaf, index), true };
+        }
+
+        /// @brief Erases the item at the given index within the given leaf, and then, if
+        /// the leaf became underfull, rebalances it by borrowing from, or merging with,
+        /// one of its siblings, and rebalances its parents as necessary.
+        ///
+        /// NOTE: Borrowing from a sibling requires copying a key into the parent, as the
+        /// new separator between the two leaves. We make that copy before modifying the
+        /// tree, so that the tree is left untouched if it throws.
+        void erase_from_leaf_(leaf_* leaf, std::size_t index,
+            path_entry_* path, std::size_t depth)
+        {
+            static_assert(min_leaf_count_ >= 1,
+                "Leaves must be able to hold at least two items");
+
+            const auto removeItem = [&]() noexcept
+            {
+                move_leaf_items_(*leaf, index, *leaf, index + 1, leaf->count - index - 1);
+                --leaf->count;
+                --size_;
+            };
+
+            if (depth == 0 || leaf->count > min_leaf_count_)
+            {
+                removeItem();
+
+                if (depth == 0 && leaf->count == 0)
+                {
+                    free_leaf_(leaf);
+                    reset_();
+                }
+
+                return;
+            }
+
+            const auto parent = path[depth - 1].node;
+            const auto childIndex = path[depth - 1].childIndex;
+
+            // Try borrowing the last item of the left sibling.
+            if (childIndex > 0)
+            {
+                const auto left = static_cast<leaf_*>(parent->children[childIndex - 1]);
+                if (left->count > min_leaf_count_)
+                {
+                    Key separator(left->keys[left->count - 1]);
+                    removeItem();
+
+                    move_leaf_items_(*leaf, 1, *leaf, 0, leaf->count);
+                    move_leaf_items_(*leaf, 0, *left, left->count - 1, 1);
+
+                    --left->count;
+                    ++leaf->count;
+
+                    parent->keys[childIndex - 1] = std::move(separator);
+                    return;
+                }
+            }
+
+            // Try borrowing the first item of the right sibling.
+            if (childIndex < parent->count)
+            {
+                const auto right = static_cast<leaf_*>(parent->children[childIndex + 1]);
+                if (right->count > min_leaf_count_)
+                {
+                    // NOTE: The right sibling's second item becomes its first.
+                    Key separator(right->keys[1]);
+                    removeItem();
+
+                    move_leaf_items_(*leaf, leaf->count, *right, 0, 1);
+                    move_leaf_items_(*right, 0, *right, 1, right->count - 1);
+
+                    ++leaf->count;
+                    --right->count;
+
+                    parent->keys[childIndex] = std::move(separator);
+                    return;
+                }
+            }
+
+            // Otherwise, merge the leaf with one of its siblings.
+            removeItem();
+
+            const auto keyIndex = (childIndex > 0) ? (childIndex - 1) : childIndex;
+            const auto left = static_cast<leaf_*>(parent->children[keyIndex]);
+            const auto right = static_cast<leaf_*>(parent->children[keyIndex + 1]);
+
+            move_leaf_items_(*left, left->count, *right, 0, right->count);
+            left->count = static_cast<std::uint16_t>(left->count + right->count);
+
+            left->next = right->next;
+
+            if (right->next)
+            {
+                right->next->prev = left;
+            }
+            else
+            {
+                lastLeaf_ = left;
+            }
+
+            free_leaf_(right);
+            erase_from_inner_(*parent, keyIndex);
+            rebalance_inner_(path, depth - 1);
+        }
+
+        /// @brief Rebalances the inner node recorded at the given depth within path, if it's underfull.
+        void rebalance_inner_(path_entry_* path, std::size_t depth) noexcept
+        {
+            while (true)
+            {
+                const auto inner = path[depth].node;
+
+                if (depth == 0)
+                {
+                    // Shrink the tree by one level if the root only has one child left.
+                    if (inner->count == 0)
+                    {
+                        root_ = inner->children[0];
+                        free_inner_(inner);
+                    }
+
+                    return;
+                }
+
+                if (inner->count >= min_inner_count_)
+                {
+                    return;
+                }
+
+                const auto parent = path[depth - 1].node;
+                const auto childIndex = path[depth - 1].childIndex;
+
+                // Try borrowing the last child of the left sibling.
+                if (childIndex > 0)
+                {
+                    const auto left = static_cast<inner_*>(parent->children[childIndex - 1]);
+                    if (left->count > min_inner_count_)
+                    {
+                        std::move_backward(inner->keys, inner->keys + inner->count,
+                            inner->keys + inner->count + 1);
+
+                        std::copy_backward(inner->children, inner->children + inner->count + 1,
+                            inner->children + inner->count + 2);
+
+                        inner->keys[0] = std::move(parent->keys[childIndex - 1]);
+                        inner->children[0] = left->children[left->count];
+                        parent->keys[childIndex - 1] = std::move(left->keys[left->count - 1]);
+
+                        --left->count;
+                        ++inner->count;
+                        return;
+                    }
+                }
+
+                // Try borrowing the first child of the right sibling.
+                if (childIndex < parent->count)
+                {
+                    const auto right = static_cast<inner_*>(parent->children[childIndex + 1]);
+                    if (right->count > min_inner_count_)
+                    {
+                        inner->keys[inner->count] = std::move(parent->keys[childIndex]);
+                        inner->children[inner->count + 1] = right->children[0];
+                        parent->keys[childIndex] = std::move(right->keys[0]);
+
+                        std::move(right->keys + 1, right->keys + right->count, right->keys);
+                        std::copy(right->children + 1, right->children + right->count + 1,
+                            right->children);
+
+                        --right->count;
+                        ++inner->count;
+                        return;
+                    }
+                }
+
+                // Otherwise, merge the node with one of its siblings, pulling
+                // the separator between them down from the parent.
+                const auto keyIndex = (childIndex > 0) ? (childIndex - 1) : childIndex;
+                const auto left = static_cast<inner_*>(parent->children[keyIndex]);
+                const auto right = static_cast<inner_*>(parent->children[keyIndex + 1]);
+
+                left->keys[left->count] = std::move(parent->keys[keyIndex]);
+
+                std::move(right->keys, right->keys + right->count,
+                    left->keys + left->count + 1);
+
+                std::copy(right->children, right->children + right->count + 1,
+                    left->children + left->count + 1);
+
+                left->count = static_cast<std::uint16_t>(left->count + right->count + 1);
+
+                free_inner_(right);
+                erase_from_inner_(*parent, keyIndex);
+                --depth;
+            }
+        }
+
+        bool erase_(const Key& key)
+        {
+            if (!root_)
+            {
+                return false;
+            }
+
+            path_entry_ path[max_depth_];
+            std::size_t depth;
+
+            const auto leaf = find_leaf_(key, path, depth);
+            const auto index = leaf_lower_bound_(*leaf, key);
+
+            if (index == leaf->count || compare_(key, leaf->keys[index]))
+            {
+                return false;
+            }
+
+            // NOTE: Separators within inner nodes don't have to be updated when a
+            // leaf's first key is erased; they just have to stay <= every key to their right.
+            erase_from_leaf_(leaf, index, path, depth);
+            return true;
+        }
+
+        /// @brief Replaces the contents of the tree with the given sorted keys and values.
+        void assign_sorted_(span<const Key> keys, const mapped_storage_t_* values)
+        {
+            clear();
+
+            const auto count = keys.size();
+            if (count == 0)
+            {
+                return;
+            }
+
+        #ifndef NDEBUG
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                assert(compare_(keys.data()[i - 1], keys.data()[i]) &&
+                    "The given keys must be sorted, and must not contain duplicates");
+            }
+        #endif
+
+            // NOTE: Every node on each level is filled evenly, which keeps every
+            // node at least half-full. We keep track of the smallest key within
+            // each node, which becomes its separator within its parent.
+            vector<node_*> level;
+            vector<const Key*> levelMinKeys;
+            vector<node_*> nextLevel;
+            vector<const Key*> nextLevelMinKeys;
+            vector<inner_*> inners;
+
+            try
+            {
+                // Build the leaves, linking each one to the next.
+                const auto leafCount = ((count + leaf_capacity_ - 1) / leaf_capacity_);
+                level.reserve(leafCount);
+                levelMinKeys.reserve(leafCount);
+
+                for (std::size_t i = 0, offset = 0; i < leafCount; ++i)
+                {
+                    const auto leafSize = ((count / leafCount) + (i < (count % leafCount)));
+                    const auto leaf = create_leaf_();
+
+                    // NOTE: We link the leaf in before copying anything into it,
+                    // so that it gets freed below if any of the copies throw.
+                    leaf->prev = lastLeaf_;
+
+                    if (lastLeaf_)
+                    {
+                        lastLeaf_->next = leaf;
+                    }
+                    else
+                    {
+                        firstLeaf_ = leaf;
+                    }
+
+                    lastLeaf_ = leaf;
+
+                    std::copy(keys.data() + offset, keys.data() + offset + leafSize, leaf->keys);
+
+                    if constexpr (has_values_)
+                    {
+                        std::copy(values + offset, values + offset + leafSize,
+                            leaf->values.items);
+                    }
+
+                    leaf->count = static_cast<std::uint16_t>(leafSize);
+                    level.push_back(leaf);
+                    levelMinKeys.push_back(&leaf->keys[0]);
+                    offset += leafSize;
+                }
+
+                // Build each level of inner nodes, until only the root is left.
+                while (level.size() > 1)
+                {
+                    const auto childCount = level.size();
+                    const auto nodeCount = ((childCount + inner_capacity_) / (inner_capacity_ + 1));
+
+                    nextLevel.clear();
+                    nextLevelMinKeys.clear();
+                    nextLevel.reserve(nodeCount);
+                    nextLevelMinKeys.reserve(nodeCount);
+
+                    // NOTE: We reserve space for the new inner nodes up-front,
+                    // so that they can't be leaked if pushing one of them throws.
+                    inners.reserve(inners.size() + nodeCount);
+
+                    for (std::size_t i = 0, offset = 0; i < nodeCount; ++i)
+                    {
+                        const auto nodeChildCount = ((childCount / nodeCount) +
+                            (i < (childCount % nodeCount)));
+
+                        const auto inner = create_inner_();
+                        inners.push_back(inner);
+
+                        for (std::size_t j = 0; j < nodeChildCount; ++j)
+                        {
+                            inner->children[j] = level[offset + j];
+
+                            if (j > 0)
+                            {
+                                inner->keys[j - 1] = *levelMinKeys[offset + j];
+                            }
+                        }
+
+                        inner->count = static_cast<std::uint16_t>(nodeChildCount - 1);
+                        nextLevel.push_back(inner);
+                        nextLevelMinKeys.push_back(levelMinKeys[offset]);
+                        offset += nodeChildCount;
+                    }
+
+                    std::swap(level, nextLevel);
+                    std::swap(levelMinKeys, nextLevelMinKeys);
+                }
+            }
+            catch (...)
+            {
+                for (const auto inner : inners)
+                {
+                    free_inner_(inner);
+                }
+
+                for (auto leaf = firstLeaf_; leaf;)
+                {
+                    const auto next = leaf->next;
+                    free_leaf_(leaf);
+                    leaf = next;
+                }
+
+                reset_();
+                throw;
+            }
+
+            root_ = level[0];
+            size_ = count;
+        }
+
+        void move_from_(btree_& other) noexcept
+        {
+            compare_ = std::move(other.compare_);
+            root_ = other.root_;
+            firstLeaf_ = other.firstLeaf_;
+            lastLeaf_ = other.lastLeaf_;
+            size_ = other.size_;
+            leafPool_ = std::move(other.leafPool_);
+            innerPool_ = std::move(other.innerPool_);
+
+            other.reset_();
+        }
+
+    public:
+        inline size_type size() const noexcept
+        {
+            return size_;
+        }
+
+        [[nodiscard]] inline bool empty() const noexcept
+        {
+            return (size_ == 0);
+        }
+
+        inline const_iterator cbegin() const noexcept
+        {
+            return const_iterator(firstLeaf_, 0);
+        }
+
+        inline const_iterator begin() const noexcept
+        {
+            return const_iterator(firstLeaf_, 0);
+        }
+
+        inline iterator begin() noexcept
+        {
+            return iterator(firstLeaf_, 0);
+        }
+
+        inline const_iterator cend() const noexcept
+        {
+            return const_iterator(lastLeaf_, (lastLeaf_) ? lastLeaf_->count : 0);
+        }
+
+        inline const_iterator end() const noexcept
+        {
+            return cend();
+        }
+
+        inline iterator end() noexcept
+        {
+            return iterator(lastLeaf_, (lastLeaf_) ? lastLeaf_->count : 0);
+        }
+
+        /// @brief Returns an iterator to the first key which is not ordered before
+        /// the given key. Iterating from here scans through the leaves in order.
+        const_iterator lower_bound(const Key& key) const
+        {
+            if (!root_)
+            {
+                return end();
+            }
+
+            const leaf_* leaf = find_leaf_(key);
+            return make_iterator_(leaf, leaf_lower_bound_(*leaf, key));
+        }
+
+        iterator lower_bound(const Key& key)
+        {
+            if (!root_)
+            {
+                return end();
+            }
+
+            const auto leaf = find_leaf_(key);
+            const auto pos = normalize_position_(leaf, leaf_lower_bound_(*leaf, key));
+            return iterator(pos.first(), pos.second());
+        }
+
+        /// @brief Returns an iterator to the first key which is ordered after the given key.
+        const_iterator upper_bound(const Key& key) const
+        {
+            if (!root_)
+            {
+                return end();
+            }
+
+            const leaf_* leaf = find_leaf_(key);
+            return make_iterator_(leaf, leaf_upper_bound_(*leaf, key));
+        }
+
+        iterator upper_bound(const Key& key)
+        {
+            if (!root_)
+            {
+                return end();
+            }
+
+            const auto leaf = find_leaf_(key);
+            const auto pos = normalize_position_(leaf, leaf_upper_bound_(*leaf, key));
+            return iterator(pos.first(), pos.second());
+        }
+
+        const_iterator find(const Key& key) const
+        {
+            const auto it = lower_bound(key);
+            return (it != end() && !compare_(key, it.key())) ? it : end();
+        }
+
+        iterator find(const Key& key)
+        {
+            const auto it = lower_bound(key);
+            return (it != end() && !compare_(key, it.key())) ? it : end();
+        }
+
+        bool contains(const Key& key) const
+        {
+            if (!root_)
+            {
+                return false;
+            }
+
+            const auto leaf = find_leaf_(key);
+            const auto index = leaf_lower_bound_(*leaf, key);
+
+            return (index < leaf->count && !compare_(key, leaf->keys[index]));
+        }
+
+        /// @brief Erases the given key (and its value) from the tree.
+        ///
+        /// Erasing may have to copy a key into an inner node; if that copy throws,
+        /// the exception is propagated, and the tree is left unchanged.
+        ///
+        /// @return true if the key was erased, or false if it wasn't within the tree.
+        inline bool erase(const Key& key) noexcept(std::is_nothrow_copy_constructible_v<Key>)
+        {
+            return erase_(key);
+        }
+
+        void clear() noexcept
+        {
+            if (root_)
+            {
+                free_subtree_(root_);
+                reset_();
+            }
+        }
+
+        btree_& operator=(const btree_& other) = delete;
+
+        btree_() = default;
+
+        explicit btree_(const Compare& compare)
+            : compare_(compare)
+        {
+        }
+
+        btree_(const btree_& other) = delete;
+
+        ~btree_()
+        {
+            clear();
+        }
+    };
+}
+
+/// @brief An ordered map, implemented as a B+tree.
+///
+/// Unlike std::map, which allocates a separate node for every key, a btree_map stores
+/// many keys (and their values) within each node, so lookups only touch one node per
+/// level of a much shallower tree. Nodes are sized to a multiple of the cache line size
+/// (NodeBytes), and are allocated from memory pools. Keys and values are stored in
+/// separate arrays within each leaf, so searching a leaf only reads its keys; if the
+/// keys are arithmetic and compared via std::less, they're searched via SIMD.
+///
+/// All of the keys and values are stored within the leaves, which are linked together
+/// in order, so range scans (e.g. iterating from lower_bound) are sequential.
+///
+/// NOTE: Since keys and values are stored separately, iterators don't point to a pair;
+/// use it.key() and it.value() (or structured bindings, e.g. for (auto [k, v] : map)).
+/// Inserting or erasing keys invalidates every iterator.
+///
+/// @tparam Key The type of keys stored within the map; must be default-constructible.
+/// @tparam T The type of values stored within the map; must be default-constructible.
+/// @tparam Compare The comparison function used to order keys.
+/// @tparam NodeBytes The approximate size of each node, in bytes.
+template<typename Key, typename T, typename Compare = std::less<Key>,
+    std::size_t NodeBytes = 256>
+class btree_map : public detail_::btree_<Key, T, Compare, NodeBytes>
+{
+    using base_ = detail_::btree_<Key, T, Compare, NodeBytes>;
+
+public:
+    using mapped_type   = T;
+    using iterator      = typename base_::iterator;
+
+    /// @brief Constructs a value associated with the given key, if the key isn't
+    /// already within the map. Otherwise, returns the existing value untouched.
+    /// @return An iterator to the key's value, and whether the value was inserted.
+    template<typename... Args>
+    inline std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+    {
+        return base_::emplace_(key, std::forward<Args>(args)...);
+    }
+
+    inline std::pair<iterator, bool> insert(const Key& key, const T& value)
+    {
+        return base_::emplace_(key, value);
+    }
+
+    inline std::pair<iterator, bool> insert(const Key& key, T&& value)
+    {
+        return base_::emplace_(key, std::move(value));
+    }
+
+    /// @brief Returns the value associated with the given key,
+    /// default-constructing one first if there isn't one.
+    inline T& operator[](const Key& key)
+    {
+        return base_::emplace_(key).first.value();
+    }
+
+    /// @brief Replaces the contents of the map with the given keys and values in O(n),
+    /// which is much faster than inserting them one-by-one.
+    /// @param keys The keys to insert, which must be sorted, without duplicates.
+    /// @param values The values to insert, in the same order as the keys.
+    void assign_sorted(span<const Key> keys, span<const T> values)
+    {
+        assert(keys.size() == values.size() &&
+            "There must be exactly one value for every key");
+
+        base_::assign_sorted_(keys, values.data());
+    }
+
+    inline void assign_sorted(const vector<Key>& keys, const vector<T>& values)
+    {
+        assign_sorted(span<const Key>(keys.data(), keys.size()),
+            span<const T>(values.data(), values.size()));
+    }
+
+    btree_map& operator=(btree_map&& other) noexcept
+    {
+        if (&other != this)
+        {
+            base_::clear();
+            base_::move_from_(other);
+        }
+
+        return *this;
+    }
+
+    btree_map() = default;
+
+    explicit btree_map(const Compare& compare)
+        : base_(compare)
+    {
+    }
+
+    btree_map(btree_map&& other) noexcept
+    {
+        base_::move_from_(other);
+    }
+};
+
+/// @brief An ordered set, implemented as a B+tree; see btree_map for details.
+///
+/// @tparam Key The type of keys stored within the set; must be default-constructible.
+/// @tparam Compare The comparison function used to order keys.
+/// @tparam NodeBytes The approximate size of each node, in bytes.
+template<typename Key, typename Compare = std::less<Key>, std::size_t NodeBytes = 256>
+class btree_set : public detail_::btree_<Key, void, Compare, NodeBytes>
+{
+    using base_ = detail_::btree_<Key, void, Compare, NodeBytes>;
+
+public:
+    using value_type    = Key;
+    using iterator      = typename base_::iterator;
+
+    /// @brief Inserts the given key into the set.
+    /// @return An iterator to the key, and whether the key was inserted.
+    inline std::pair<iterator, bool> insert(const Key& key)
+    {
+        return base_::emplace_(key);
+    }
+
+    /// @brief Replaces the contents of the set with the given keys in O(n),
+    /// which is much faster than inserting them one-by-one.
+    /// @param keys The keys to insert, which must be sorted, without duplicates.
+    inline void assign_sorted(span<const Key> keys)
+    {
+        base_::assign_sorted_(keys, nullptr);
+    }
+
+    inline void assign_sorted(const vector<Key>& keys)
+    {
+        assign_sorted(span<const Key>(keys.data(), keys.size()));
+    }
+
+    btree_set& operator=(btree_set&& other) noexcept
+    {
+        if (&other != this)
+        {
+            base_::clear();
+            base_::move_from_(other);
+        }
+
+        return *this;
+    }
+
+    btree_set() = default;
+
+    explicit btree_set(const Compare& compare)
+        : base_(compare)
+    {
+    }
+
+    btree_set(btree_set&& other) noexcept
+    {
+        base_::move_from_(other);
+    }
+};
+}
+
+#endif
@@ -0,0 +1,357 @@
+/// @file rad_chunk_buffer.h
+/// @author Graham Scott
+/// @brief Header file providing rad::chunk_buffer, a byte buffer made up of
+/// a list of fixed-size chunks, which never moves bytes once they've been written.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_CHUNK_BUFFER_H_INCLUDED
+#define RAD_CHUNK_BUFFER_H_INCLUDED
+
+#include "rad_memory_pool.h"
+#include "rad_shared_buffer.h"
+#include "rad_span.h"
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <cassert>
+
+#ifndef _WIN32
+    #include <sys/uio.h>
+#endif
+
+namespace rad
+{
+/// @brief A byte buffer made up of a singly-linked list of fixed-size chunks.
+///
+/// Appending to a chunk_buffer never moves any of the bytes which have already been
+/// written; once the last chunk is full, a new chunk is simply linked onto the end.
+/// Bytes can also be consumed from the front, which returns fully-consumed chunks
+/// to the pool right away, so a chunk_buffer can be used as a streaming queue.
+///
+/// The chunks are allocated from a dynamic_memory_pool which is owned by the caller,
+/// so many chunk_buffers can share (and recycle) the same chunks. The pool must
+/// outlive every chunk_buffer which uses it.
+///
+/// @tparam ChunkSize The number of bytes which can be stored in each chunk.
+template<std::size_t ChunkSize = 4096>
+class chunk_buffer
+{
+public:
+    struct chunk
+    {
+        chunk*          next;
+        unsigned char   data[ChunkSize];
+    };
+
+    using pool_type = dynamic_memory_pool<chunk>;
+    using size_type = std::size_t;
+
+    static constexpr size_type chunk_size = ChunkSize;
+
+private:
+    pool_type*      pool_;
+    chunk*          head_ = nullptr;
+    chunk*          tail_ = nullptr;
+    size_type       headOffset_ = 0;    // NOTE: The number of consumed bytes in head_.
+    size_type       tailSize_ = 0;      // NOTE: The number of written bytes in tail_.
+    size_type       size_ = 0;
+
+    chunk* append_chunk_()
+    {
+        const auto newChunk = pool_->allocate();
+        newChunk->next = nullptr;
+
+        if (tail_)
+        {
+            tail_->next = newChunk;
+        }
+        else
+        {
+            head_ = newChunk;
+        }
+
+        tail_ = newChunk;
+        tailSize_ = 0;
+
+        return newChunk;
+    }
+
+    void release_chunks_() noexcept
+    {
+        while (head_)
+        {
+            const auto next = head_->next;
+            pool_->deallocate(head_);
+            head_ = next;
+        }
+
+        tail_ = nullptr;
+    }
+
+    size_type get_chunk_begin_(const chunk* c) const noexcept
+    {
+        return (c == head_) ? headOffset_ : 0;
+    }
+
+    size_type get_chunk_end_(const chunk* c) const noexcept
+    {
+        return (c == tail_) ? tailSize_ : ChunkSize;
+    }
+
+public:
+    inline pool_type& pool() const noexcept
+    {
+        return *pool_;
+    }
+
+    /// @brief Returns the total number of (unconsumed) bytes within this buffer.
+    inline size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    /// @brief Returns the number of chunks which contain at least one unconsumed byte.
+    size_type chunk_count() const noexcept
+    {
+        size_type count = 0;
+
+        for (auto c = head_; c; c = c->next)
+        {
+            count += (get_chunk_begin_(c) != get_chunk_end_(c));
+        }
+
+        return count;
+    }
+
+    /// @brief Returns the unconsumed bytes within the first chunk.
+    ///
+    /// This allows streaming parsers to parse data in-place, and
+    /// then call consume with however many bytes they processed.
+    span<const unsigned char> front() const noexcept
+    {
+        if (!head_)
+        {
+            return span<const unsigned char>();
+        }
+
+        return span<const unsigned char>(head_->data + headOffset_,
+            get_chunk_end_(head_) - headOffset_);
+    }
+
+    /// @brief Calls the given function on the unconsumed bytes within
+    /// each chunk, in order, skipping over empty chunks.
+    /// @param func The function to call; must accept a span<const unsigned char>.
+    template<typename Func>
+    void for_each_chunk(Func&& func) const
+    {
+        for (auto c = head_; c; c = c->next)
+        {
+            const auto begin = get_chunk_begin_(c);
+            const auto end = get_chunk_end_(c);
+
+            if (begin != end)
+            {
+                func(span<const unsigned char>(c->data + begin, end - begin));
+            }
+        }
+    }
+
+    /// @brief Copies the given data onto the end of this buffer.
+    void append(const void* data, size_type size)
+    {
+        auto src = static_cast<const unsigned char*>(data);
+
+        while (size > 0)
+        {
+            if (!tail_ || tailSize_ == ChunkSize)
+            {
+                append_chunk_();
+            }
+
+            const auto copySize = std::min(size, ChunkSize - tailSize_);
+            std::memcpy(tail_->data + tailSize_, src, copySize);
+
+            tailSize_ += copySize;
+            size_ += copySize;
+            src += copySize;
+            size -= copySize;
+        }
+    }
+
+    /// @brief Returns the writable space at the end of the last chunk, linking
+    /// a new chunk onto the end first if the last chunk is full.
+    ///
+    /// This allows data to be written directly into the buffer without an extra
+    /// copy; call commit_append with however many bytes were actually written.
+    span<unsigned char> prepare_append()
+    {
+        if (!tail_ || tailSize_ == ChunkSize)
+        {
+            append_chunk_();
+        }
+
+        return span<unsigned char>(tail_->data + tailSize_, ChunkSize - tailSize_);
+    }
+
+    /// @brief Marks the given number of bytes written via prepare_append as part of this buffer.
+    void commit_append(size_type count) noexcept
+    {
+        assert(tail_ && count <= (ChunkSize - tailSize_) &&
+            "The given count was greater than the space returned by prepare_append()");
+
+        tailSize_ += count;
+        size_ += count;
+    }
+
+    /// @brief Removes the given number of bytes from the front of this buffer,
+    /// returning any chunks which have been fully consumed to the pool.
+    void consume(size_type count) noexcept
+    {
+        assert(count <= size_ && "The given count was greater than the buffer's size");
+
+        size_ -= count;
+
+        while (head_)
+        {
+            const auto available = (get_chunk_end_(head_) - headOffset_);
+
+            if (count < available)
+            {
+                headOffset_ += count;
+                break;
+            }
+
+            count -= available;
+
+            // Keep the last chunk around so it can be re-used by future appends.
+            if (head_ == tail_)
+            {
+                headOffset_ = tailSize_ = 0;
+                break;
+            }
+
+            const auto next = head_->next;
+            pool_->deallocate(head_);
+
+            head_ = next;
+            headOffset_ = 0;
+        }
+    }
+
+#ifndef _WIN32
+    /// @brief Fills the given iovec array with the unconsumed bytes within
+    /// each chunk, in order, so that they can be written via writev.
+    /// @param iovecs The iovec array to fill.
+    /// @return The number of iovecs which were filled. If this is equal to
+    /// iovecs.size(), there may still be more chunks left over.
+    size_type gather(span<iovec> iovecs) const noexcept
+    {
+        size_type count = 0;
+
+        for (auto c = head_; c && count < iovecs.size(); c = c->next)
+        {
+            const auto begin = get_chunk_begin_(c);
+            const auto end = get_chunk_end_(c);
+
+            if (begin != end)
+            {
+                iovecs[count].iov_base = c->data + begin;
+                iovecs[count].iov_len = (end - begin);
+                ++count;
+            }
+        }
+
+        return count;
+    }
+#endif
+
+    /// @brief Copies all of the unconsumed bytes within this buffer into the given buffer.
+    /// @param dst The buffer to copy into. Must be at least size() bytes large.
+    void copy_to(void* dst) const noexcept
+    {
+        auto dstBytes = static_cast<unsigned char*>(dst);
+
+        for_each_chunk([&](span<const unsigned char> bytes)
+        {
+            std::memcpy(dstBytes, bytes.data(), bytes.size());
+            dstBytes += bytes.size();
+        });
+    }
+
+    /// @brief Copies all of the unconsumed bytes within this buffer into a single new buffer.
+    buffer_slice linearize() const
+    {
+        if (empty())
+        {
+            return buffer_slice();
+        }
+
+        auto buffer = shared_buffer::create(size_);
+        copy_to(buffer->mutable_data());
+
+        return buffer_slice(std::move(buffer));
+    }
+
+    /// @brief Removes all bytes from this buffer, returning all of its chunks to the pool.
+    void clear() noexcept
+    {
+        release_chunks_();
+
+        headOffset_ = tailSize_ = size_ = 0;
+    }
+
+    chunk_buffer& operator=(const chunk_buffer& other) = delete;
+
+    chunk_buffer& operator=(chunk_buffer&& other) noexcept
+    {
+        if (&other != this)
+        {
+            release_chunks_();
+
+            pool_ = other.pool_;
+            head_ = other.head_;
+            tail_ = other.tail_;
+            headOffset_ = other.headOffset_;
+            tailSize_ = other.tailSize_;
+            size_ = other.size_;
+
+            other.head_ = other.tail_ = nullptr;
+            other.headOffset_ = other.tailSize_ = other.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    explicit chunk_buffer(pool_type& pool) noexcept
+        : pool_(&pool)
+    {
+    }
+
+    chunk_buffer(const chunk_buffer& other) = delete;
+
+    chunk_buffer(chunk_buffer&& other) noexcept
+        : pool_(other.pool_)
+        , head_(other.head_)
+        , tail_(other.tail_)
+        , headOffset_(other.headOffset_)
+        , tailSize_(other.tailSize_)
+        , size_(other.size_)
+    {
+        other.head_ = other.tail_ = nullptr;
+        other.headOffset_ = other.tailSize_ = other.size_ = 0;
+    }
+
+    inline ~chunk_buffer()
+    {
+        release_chunks_();
+    }
+};
+}
+
+#endif
@@ -0,0 +1,548 @@
+/// @file rad_enum_containers.h
+/// @author Graham Scott
+/// @brief Header file providing rad::enum_array and rad::enum_set, dense
+/// containers which are indexed directly by the values of a scoped enum.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_ENUM_CONTAINERS_H_INCLUDED
+#define RAD_ENUM_CONTAINERS_H_INCLUDED
+
+#include "rad_base.h"
+#include "rad_scoped_enum_helpers.h"
+#include <type_traits>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace rad
+{
+namespace detail_
+{
+    template<typename E>
+    constexpr std::size_t enum_index_(E value) noexcept
+    {
+        return static_cast<std::size_t>(static_cast<std::underlying_type_t<E>>(value));
+    }
+
+    template<typename E>
+    constexpr void validate_enum_container_type_() noexcept
+    {
+        static_assert(std::is_enum_v<E>, "Enum containers can only be indexed by enums");
+        static_assert(enum_count_v<E> != 0, "Enum containers require the enum to have "
+            "a count enumerator, or a specialization of rad::enum_count");
+    }
+
+    constexpr std::size_t enum_set_popcount_(std::uint64_t bits) noexcept
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(bits));
+    #else
+        // NOTE: MSVC's popcount intrinsics aren't constexpr, and require
+        // hardware support, so we just count the bits in parallel instead.
+        bits = bits - ((bits >> 1) & 0x5555555555555555ull);
+        bits = (bits & 0x3333333333333333ull) + ((bits >> 2) & 0x3333333333333333ull);
+        bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<std::size_t>((bits * 0x0101010101010101ull) >> 56);
+    #endif
+    }
+
+    /// @brief Returns the index of the lowest set bit; bits must not be 0.
+    constexpr std::size_t enum_set_find_first_set_(std::uint64_t bits) noexcept
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(bits));
+    #else
+        // NOTE: MSVC's bit scan intrinsics aren't constexpr.
+        return enum_set_popcount_((bits & (0 - bits)) - 1);
+    #endif
+    }
+}
+
+/// @brief A fixed-size array, indexed directly by the values of the given scoped enum.
+///
+/// This is a drop-in replacement for e.g. a std::unordered_map keyed on a small
+/// enum; looking up a value is just an array access, with no hashing involved.
+///
+/// @tparam E The enum type; must have a count enumerator, or a specialization
+/// of rad::enum_count, and its values must be sequential, starting from 0.
+/// @tparam T The type of values stored within the array.
+template<typename E, typename T>
+class enum_array
+{
+    static constexpr std::size_t count_ = (detail_::validate_enum_container_type_<E>(),
+        enum_count_v<E>);
+
+    T   elements_[count_]{};
+
+    void validate_range_(E key) const
+    {
+        if (detail_::enum_index_(key) >= count_)
+        {
+            throw std::out_of_range(
+                "The given enum value was outside of the enum_array's range"
+            );
+        }
+    }
+
+public:
+    using key_type          = E;
+    using value_type        = T;
+    using size_type         = std::size_t;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using iterator          = T*;
+    using const_iterator    = const T*;
+
+    static constexpr size_type size() noexcept
+    {
+        return count_;
+    }
+
+    constexpr const T* data() const noexcept
+    {
+        return elements_;
+    }
+
+    constexpr T* data() noexcept
+    {
+        return elements_;
+    }
+
+    constexpr const_iterator begin() const noexcept
+    {
+        return elements_;
+    }
+
+    constexpr iterator begin() noexcept
+    {
+        return elements_;
+    }
+
+    constexpr const_iterator end() const noexcept
+    {
+        return (elements_ + count_);
+    }
+
+    constexpr iterator end() noexcept
+    {
+        return (elements_ + count_);
+    }
+
+    constexpr void fill(const T& value)
+    {
+        for (auto& element : elements_)
+        {
+            element = value;
+        }
+    }
+
+    const_reference at(E key) const
+    {
+        validate_range_(key);
+        return elements_[detail_::enum_index_(key)];
+    }
+
+    reference at(E key)
+    {
+        validate_range_(key);
+        return elements_[detail_::enum_index_(key)];
+    }
+
+    constexpr const_reference operator[](E key) const noexcept
+    {
+    #if RAD_USE_STRICT_BOUNDS_CHECKING == 1
+        assert(detail_::enum_index_(key) < count_ &&
+            "The given enum value was outside of the enum_array's range");
+    #endif
+
+        return elements_[detail_::enum_index_(key)];
+    }
+
+    constexpr reference operator[](E key) noexcept
+    {
+    #if RAD_USE_STRICT_BOUNDS_CHECKING == 1
+        assert(detail_::enum_index_(key) < count_ &&
+            "The given enum value was outside of the enum_array's range");
+    #endif
+
+        return elements_[detail_::enum_index_(key)];
+    }
+
+    constexpr enum_array() = default;
+
+    /// @brief Constructs an array with every element set to the given value.
+    constexpr explicit enum_array(const T& value)
+    {
+        fill(value);
+    }
+};
+
+/// @brief A set of the values of the given scoped enum, stored as a bitset.
+///
+/// Each enum value is stored as a single bit, within the smallest unsigned integer
+/// which can hold every value (or an array of 64-bit words, if there are more than
+/// 64 values), so set operations on small enums compile to single instructions, and
+/// size() is a popcount. Iterating over the set yields its members in ascending order,
+/// and is usable within constant expressions.
+///
+/// Unlike the flag enums which RAD_ENABLE_SCOPED_ENUM_BITWISE_OPS is intended for,
+/// the enum's values should be sequential indices (0, 1, 2...), not bit masks.
+///
+/// @tparam E The enum type; must have a count enumerator, or a specialization
+/// of rad::enum_count, and its values must be sequential, starting from 0.
+template<typename E>
+class enum_set
+{
+    static constexpr std::size_t count_ = (detail_::validate_enum_container_type_<E>(),
+        enum_count_v<E>);
+
+public:
+    /// @brief The type of integer each group of bits within the set is stored in.
+    using word_type = std::conditional_t<(count_ <= 8), std::uint8_t,
+        std::conditional_t<(count_ <= 16), std::uint16_t,
+        std::conditional_t<(count_ <= 32), std::uint32_t, std::uint64_t>>>;
+
+private:
+    static constexpr std::size_t word_bits_ = (sizeof(word_type) * 8);
+    static constexpr std::size_t word_count_ = ((count_ + word_bits_ - 1) / word_bits_);
+
+    /// @brief The bits within the last word which correspond to actual enum values.
+    static constexpr word_type last_word_mask_ = ((count_ % word_bits_) == 0) ?
+        static_cast<word_type>(~word_type(0)) :
+        static_cast<word_type>((word_type(1) << (count_ % word_bits_)) - 1);
+
+    word_type   words_[word_count_]{};
+
+    static constexpr word_type bit_(std::size_t index) noexcept
+    {
+        return static_cast<word_type>(word_type(1) << (index % word_bits_));
+    }
+
+    /// @brief Returns the index of the first member at or after the given index, or count_.
+    constexpr std::size_t find_next_(std::size_t index) const noexcept
+    {
+        if (index >= count_)
+        {
+            return count_;
+        }
+
+        auto wordIndex = (index / word_bits_);
+        auto word = static_cast<word_type>(words_[wordIndex] &
+            (static_cast<word_type>(~word_type(0)) << (index % word_bits_)));
+
+        while (true)
+        {
+            if (word)
+            {
+                return ((wordIndex * word_bits_) +
+                    detail_::enum_set_find_first_set_(word));
+            }
+
+            if (++wordIndex == word_count_)
+            {
+                return count_;
+            }
+
+            word = words_[wordIndex];
+        }
+    }
+
+public:
+    class const_iterator
+    {
+        friend class enum_set;
+
+        const enum_set*     set_ = nullptr;
+        std::size_t         index_ = 0;
+
+        constexpr const_iterator(const enum_set* set, std::size_t index) noexcept
+            : set_(set)
+            , index_(index)
+        {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = E;
+        using reference         = E;
+        using pointer           = void;
+
+        constexpr E operator*() const noexcept
+        {
+            return static_cast<E>(index_);
+        }
+
+        constexpr const_iterator& operator++() noexcept
+        {
+            index_ = set_->find_next_(index_ + 1);
+            return *this;
+        }
+
+        constexpr const_iterator operator++(int) noexcept
+        {
+            const auto it = *this;
+            ++(*this);
+            return it;
+        }
+
+        constexpr bool operator==(const const_iterator& other) const noexcept
+        {
+            return (index_ == other.index_);
+        }
+
+        constexpr bool operator!=(const const_iterator& other) const noexcept
+        {
+            return (index_ != other.index_);
+        }
+
+        constexpr const_iterator() noexcept = default;
+    };
+
+    using key_type      = E;
+    using value_type    = E;
+    using size_type     = std::size_t;
+    using iterator      = const_iterator;
+
+    /// @brief Returns a set containing every value of the enum.
+    static constexpr enum_set all() noexcept
+    {
+        enum_set set;
+
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            set.words_[i] = static_cast<word_type>(~word_type(0));
+        }
+
+        set.words_[word_count_ - 1] = last_word_mask_;
+        return set;
+    }
+
+    /// @brief Returns the maximum number of values the set can hold.
+    static constexpr size_type max_size() noexcept
+    {
+        return count_;
+    }
+
+    /// @brief Returns the number of values within the set.
+    constexpr size_type size() const noexcept
+    {
+        size_type result = 0;
+
+        for (const auto word : words_)
+        {
+            result += detail_::enum_set_popcount_(word);
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        word_type bits = 0;
+
+        for (const auto word : words_)
+        {
+            bits |= word;
+        }
+
+        return (bits == 0);
+    }
+
+    /// @brief Returns the words the set's bits are stored within, where bit i
+    /// of word w corresponds to the enum value (w * (sizeof(word_type) * 8)) + i.
+    constexpr const word_type* words() const noexcept
+    {
+        return words_;
+    }
+
+    constexpr const_iterator begin() const noexcept
+    {
+        return const_iterator(this, find_next_(0));
+    }
+
+    constexpr const_iterator end() const noexcept
+    {
+        return const_iterator(this, count_);
+    }
+
+    constexpr bool contains(E value) const noexcept
+    {
+        const auto index = detail_::enum_index_(value);
+        assert(index < count_ && "The given enum value was outside of the enum_set's range");
+
+        return ((words_[index / word_bits_] & bit_(index)) != 0);
+    }
+
+    /// @brief Returns whether every value within the given set is also within this set.
+    constexpr bool contains_all(const enum_set& other) const noexcept
+    {
+        word_type missing = 0;
+
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            missing |= static_cast<word_type>(other.words_[i] & ~words_[i]);
+        }
+
+        return (missing == 0);
+    }
+
+    /// @brief Returns whether any value within the given set is also within this set.
+    constexpr bool contains_any(const enum_set& other) const noexcept
+    {
+        word_type common = 0;
+
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            common |= static_cast<word_type>(other.words_[i] & words_[i]);
+        }
+
+        return (common != 0);
+    }
+
+    constexpr void insert(E value) noexcept
+    {
+        const auto index = detail_::enum_index_(value);
+        assert(index < count_ && "The given enum value was outside of the enum_set's range");
+
+        words_[index / word_bits_] |= bit_(index);
+    }
+
+    constexpr void erase(E value) noexcept
+    {
+        const auto index = detail_::enum_index_(value);
+        assert(index < count_ && "The given enum value was outside of the enum_set's range");
+
+        words_[index / word_bits_] &= static_cast<word_type>(~bit_(index));
+    }
+
+    /// @brief Inserts the given value if it isn't within the set, or erases it otherwise.
+    constexpr void flip(E value) noexcept
+    {
+        const auto index = detail_::enum_index_(value);
+        assert(index < count_ && "The given enum value was outside of the enum_set's range");
+
+        words_[index / word_bits_] ^= bit_(index);
+    }
+
+    constexpr void clear() noexcept
+    {
+        for (auto& word : words_)
+        {
+            word = 0;
+        }
+    }
+
+    constexpr enum_set& operator|=(const enum_set& other) noexcept
+    {
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            words_[i] |= other.words_[i];
+        }
+
+        return *this;
+    }
+
+    constexpr enum_set& operator&=(const enum_set& other) noexcept
+    {
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            words_[i] &= other.words_[i];
+        }
+
+        return *this;
+    }
+
+    constexpr enum_set& operator^=(const enum_set& other) noexcept
+    {
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            words_[i] ^= other.words_[i];
+        }
+
+        return *this;
+    }
+
+    /// @brief Erases every value within the given set from this set.
+    constexpr enum_set& operator-=(const enum_set& other) noexcept
+    {
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            words_[i] &= static_cast<word_type>(~other.words_[i]);
+        }
+
+        return *this;
+    }
+
+    constexpr enum_set operator|(const enum_set& other) const noexcept
+    {
+        auto result = *this;
+        return (result |= other);
+    }
+
+    constexpr enum_set operator&(const enum_set& other) const noexcept
+    {
+        auto result = *this;
+        return (result &= other);
+    }
+
+    constexpr enum_set operator^(const enum_set& other) const noexcept
+    {
+        auto result = *this;
+        return (result ^= other);
+    }
+
+    constexpr enum_set operator-(const enum_set& other) const noexcept
+    {
+        auto result = *this;
+        return (result -= other);
+    }
+
+    /// @brief Returns the set of every enum value which is not within this set.
+    constexpr enum_set operator~() const noexcept
+    {
+        auto result = *this;
+
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            result.words_[i] = static_cast<word_type>(~result.words_[i]);
+        }
+
+        result.words_[word_count_ - 1] &= last_word_mask_;
+        return result;
+    }
+
+    constexpr bool operator==(const enum_set& other) const noexcept
+    {
+        word_type diff = 0;
+
+        for (std::size_t i = 0; i < word_count_; ++i)
+        {
+            diff |= static_cast<word_type>(words_[i] ^ other.words_[i]);
+        }
+
+        return (diff == 0);
+    }
+
+    constexpr bool operator!=(const enum_set& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    constexpr enum_set() noexcept = default;
+
+    constexpr enum_set(std::initializer_list<E> values) noexcept
+    {
+        for (const auto value : values)
+        {
+            insert(value);
+        }
+    }
+};
+}
+
+#endif
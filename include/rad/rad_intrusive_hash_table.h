@@ -0,0 +1,479 @@
+/// @file rad_intrusive_hash_table.h
+/// @author Graham Scott
+/// @brief Header file providing rad::intrusive_hash_table; a chained hash
+/// table whose links are stored within the objects themselves.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_INTRUSIVE_HASH_TABLE_H_INCLUDED
+#define RAD_INTRUSIVE_HASH_TABLE_H_INCLUDED
+
+#include "rad_intrusive_list.h"
+#include "rad_span.h"
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <cstddef>
+#include <cassert>
+
+namespace rad
+{
+/// @brief The links which allow an object to be stored within an intrusive_hash_table.
+///
+/// Copying an object doesn't copy its hook's links; the copy starts out unlinked.
+class intrusive_hash_hook
+{
+    template<typename T, intrusive_hash_hook T::*Hook,
+        typename KeyOf, typename Hash, typename KeyEqual>
+    friend class intrusive_hash_table;
+
+    intrusive_hash_hook*    next_ = nullptr;
+
+    // NOTE: Points to whichever pointer (either a bucket or the previous hook's next_)
+    // currently points to this hook, so that the hook can be unlinked in O(1).
+    intrusive_hash_hook**   prevNext_ = nullptr;
+
+    // NOTE: Cached, so that rehashing never has to re-hash any keys, and most
+    // mismatching keys can be skipped during lookups without comparing them.
+    std::size_t             hash_ = 0;
+
+public:
+    /// @brief Returns whether this hook is currently linked into a hash table.
+    inline bool is_linked() const noexcept
+    {
+        return (prevNext_ != nullptr);
+    }
+
+    intrusive_hash_hook& operator=(const intrusive_hash_hook&) noexcept
+    {
+        return *this;
+    }
+
+    intrusive_hash_hook() noexcept = default;
+
+    intrusive_hash_hook(const intrusive_hash_hook&) noexcept
+    {
+    }
+
+    inline ~intrusive_hash_hook()
+    {
+        assert(!is_linked() &&
+            "An object was destroyed while it was still linked into an intrusive_hash_table");
+    }
+};
+
+/// @brief A bucket of an intrusive_hash_table. Buckets are provided by the caller.
+struct intrusive_hash_bucket
+{
+    intrusive_hash_hook*    first = nullptr;
+};
+
+namespace detail_
+{
+    template<typename T, typename KeyOf>
+    using intrusive_key_t_ = std::decay_t<std::invoke_result_t<const KeyOf&, const T&>>;
+}
+
+/// @brief A chained hash table of objects of type T, whose links are stored within the
+/// objects themselves (in the given intrusive_hash_hook member), so it never allocates.
+///
+/// The buckets are also provided by the caller, as a span of intrusive_hash_buckets whose
+/// size must be a power of 2; the table can be moved to a larger set of buckets via rehash.
+/// Keys are unique, and any object can be removed from the table in O(1).
+///
+///     struct connection
+///     {
+///         int                         id;
+///         rad::intrusive_hash_hook    idHook;
+///     };
+///
+///     struct connection_id
+///     {
+///         int operator()(const connection& c) const noexcept { return c.id; }
+///     };
+///
+///     rad::intrusive_hash_bucket buckets[256];
+///     rad::intrusive_hash_table<connection, &connection::idHook, connection_id> table(buckets);
+///
+/// NOTE: The table doesn't own its objects or its buckets; objects must be removed
+/// from the table before they're destroyed (or before the table is destroyed), and
+/// the buckets must outlive the table.
+///
+/// @tparam KeyOf A function object type which returns the key of a given const T&.
+/// NOTE: An object's key must not be changed while the object is within the table.
+template<typename T, intrusive_hash_hook T::*Hook, typename KeyOf,
+    typename Hash = std::hash<detail_::intrusive_key_t_<T, KeyOf>>,
+    typename KeyEqual = std::equal_to<detail_::intrusive_key_t_<T, KeyOf>>>
+class intrusive_hash_table
+{
+public:
+    using key_type          = detail_::intrusive_key_t_<T, KeyOf>;
+    using value_type        = T;
+    using size_type         = std::size_t;
+    using hasher            = Hash;
+    using key_equal         = KeyEqual;
+
+private:
+    span<intrusive_hash_bucket>     buckets_;
+    size_type                       size_ = 0;
+    KeyOf                           keyOf_;
+    Hash                            hash_;
+    KeyEqual                        keyEqual_;
+
+    static inline intrusive_hash_hook& get_hook_(T& obj) noexcept
+    {
+        return (obj.*Hook);
+    }
+
+    static inline T& get_owner_(intrusive_hash_hook* hook) noexcept
+    {
+        return *detail_::get_intrusive_owner_(hook, Hook);
+    }
+
+    static inline void validate_buckets_(span<intrusive_hash_bucket> buckets) noexcept
+    {
+        assert(buckets.size() > 0 && (buckets.size() & (buckets.size() - 1)) == 0 &&
+            "The number of buckets must be a non-zero power of 2");
+    }
+
+    inline intrusive_hash_bucket& get_bucket_(std::size_t hash) const noexcept
+    {
+        return buckets_.data()[hash & (buckets_.size() - 1)];
+    }
+
+    static inline void link_(intrusive_hash_bucket& bucket, intrusive_hash_hook& hook) noexcept
+    {
+        hook.next_ = bucket.first;
+        hook.prevNext_ = &bucket.first;
+
+        if (bucket.first)
+        {
+            bucket.first->prevNext_ = &hook.next_;
+        }
+
+        bucket.first = &hook;
+    }
+
+    intrusive_hash_hook* find_hook_(const key_type& key, std::size_t hash) const
+    {
+        if (buckets_.size() == 0)
+        {
+            return nullptr;
+        }
+
+        for (auto hook = get_bucket_(hash).first; hook; hook = hook->next_)
+        {
+            if (hook->hash_ == hash && keyEqual_(keyOf_(get_owner_(hook)), key))
+            {
+                return hook;
+            }
+        }
+
+        return nullptr;
+    }
+
+public:
+    template<bool IsConst>
+    class basic_iterator
+    {
+        friend class intrusive_hash_table;
+
+        template<bool OtherIsConst>
+        friend class basic_iterator;
+
+        intrusive_hash_bucket*  bucket_ = nullptr;
+        intrusive_hash_bucket*  bucketsEnd_ = nullptr;
+        intrusive_hash_hook*    hook_ = nullptr;
+
+        void skip_empty_buckets_() noexcept
+        {
+            while (!hook_ && ++bucket_ != bucketsEnd_)
+            {
+                hook_ = bucket_->first;
+            }
+        }
+
+        basic_iterator(intrusive_hash_bucket* bucket,
+            intrusive_hash_bucket* bucketsEnd) noexcept
+            : bucket_(bucket)
+            , bucketsEnd_(bucketsEnd)
+            , hook_((bucket != bucketsEnd) ? bucket->first : nullptr)
+        {
+            if (bucket_ != bucketsEnd_)
+            {
+                skip_empty_buckets_();
+            }
+        }
+
+    public:
+        using iterator_category     = std::forward_iterator_tag;
+        using value_type            = T;
+        using difference_type       = std::ptrdiff_t;
+        using pointer               = std::conditional_t<IsConst, const T*, T*>;
+        using reference             = std::conditional_t<IsConst, const T&, T&>;
+
+        inline reference operator*() const noexcept
+        {
+            return get_owner_(hook_);
+        }
+
+        inline pointer operator->() const noexcept
+        {
+            return &get_owner_(hook_);
+        }
+
+        inline basic_iterator& operator++() noexcept
+        {
+            hook_ = hook_->next_;
+            skip_empty_buckets_();
+            return *this;
+        }
+
+        inline basic_iterator operator++(int) noexcept
+        {
+            auto prev = *this;
+            ++(*this);
+            return prev;
+        }
+
+        friend inline bool operator==(basic_iterator a, basic_iterator b) noexcept
+        {
+            return (a.hook_ == b.hook_);
+        }
+
+        friend inline bool operator!=(basic_iterator a, basic_iterator b) noexcept
+        {
+            return (a.hook_ != b.hook_);
+        }
+
+        basic_iterator() noexcept = default;
+
+        template<bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+        basic_iterator(basic_iterator<OtherIsConst> other) noexcept
+            : bucket_(other.bucket_)
+            , bucketsEnd_(other.bucketsEnd_)
+            , hook_(other.hook_)
+        {
+        }
+    };
+
+    using iterator          = basic_iterator<false>;
+    using const_iterator    = basic_iterator<true>;
+
+    inline size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    inline bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    inline size_type bucket_count() const noexcept
+    {
+        return buckets_.size();
+    }
+
+    /// @brief Returns the average number of objects per bucket.
+    inline float load_factor() const noexcept
+    {
+        return (buckets_.size() > 0) ?
+            (static_cast<float>(size_) / buckets_.size()) : 0.0f;
+    }
+
+    inline iterator begin() noexcept
+    {
+        return iterator(buckets_.data(), buckets_.data() + buckets_.size());
+    }
+
+    inline const_iterator begin() const noexcept
+    {
+        return const_iterator(buckets_.data(), buckets_.data() + buckets_.size());
+    }
+
+    inline iterator end() noexcept
+    {
+        return iterator();
+    }
+
+    inline const_iterator end() const noexcept
+    {
+        return const_iterator();
+    }
+
+    /// @brief Returns the object with the given key, or nullptr if there isn't one.
+    inline T* find(const key_type& key) noexcept
+    {
+        const auto hook = find_hook_(key, hash_(key));
+        return (hook) ? &get_owner_(hook) : nullptr;
+    }
+
+    /// @brief Returns the object with the given key, or nullptr if there isn't one.
+    inline const T* find(const key_type& key) const noexcept
+    {
+        const auto hook = find_hook_(key, hash_(key));
+        return (hook) ? &get_owner_(hook) : nullptr;
+    }
+
+    inline bool contains(const key_type& key) const noexcept
+    {
+        return (find(key) != nullptr);
+    }
+
+    /// @brief Inserts the given object, unless an object with the same key is already present.
+    /// @return true if the object was inserted, or false if an object with the same key
+    /// was already present (in which case the given object is left unlinked).
+    bool insert(T& obj) noexcept
+    {
+        assert(buckets_.size() > 0 && "Cannot insert into a table without any buckets");
+
+        auto& hook = get_hook_(obj);
+        assert(!hook.is_linked() &&
+            "The given object is already linked into a table via this hook");
+
+        const auto hash = hash_(keyOf_(obj));
+        if (find_hook_(keyOf_(obj), hash))
+        {
+            return false;
+        }
+
+        hook.hash_ = hash;
+        link_(get_bucket_(hash), hook);
+        ++size_;
+
+        return true;
+    }
+
+    /// @brief Removes the given object, which must be within this table, from this table in O(1).
+    void remove(T& obj) noexcept
+    {
+        auto& hook = get_hook_(obj);
+        assert(hook.is_linked() &&
+            "The given object isn't linked into a table via this hook");
+
+        *hook.prevNext_ = hook.next_;
+        if (hook.next_)
+        {
+            hook.next_->prevNext_ = hook.prevNext_;
+        }
+
+        hook.next_ = nullptr;
+        hook.prevNext_ = nullptr;
+        --size_;
+    }
+
+    /// @brief Removes the object with the given key from this table, if there is one.
+    /// @return The removed object, or nullptr if there was no object with the given key.
+    T* erase(const key_type& key) noexcept
+    {
+        const auto obj = find(key);
+        if (obj)
+        {
+            remove(*obj);
+        }
+
+        return obj;
+    }
+
+    /// @brief Moves every object within this table into the given buckets, which
+    /// must all be empty, and which must outlive this table. Any objects within the
+    /// table's previous buckets are unlinked from them, so those buckets may be freed.
+    ///
+    /// NOTE: This doesn't need to hash any keys, since each hook caches its key's hash.
+    void rehash(span<intrusive_hash_bucket> newBuckets) noexcept
+    {
+        validate_buckets_(newBuckets);
+
+        const auto oldBuckets = buckets_;
+        buckets_ = newBuckets;
+
+        for (auto& oldBucket : oldBuckets)
+        {
+            auto hook = oldBucket.first;
+            while (hook)
+            {
+                const auto next = hook->next_;
+                link_(get_bucket_(hook->hash_), *hook);
+                hook = next;
+            }
+
+            oldBucket.first = nullptr;
+        }
+    }
+
+    /// @brief Removes every object from this table.
+    void clear() noexcept
+    {
+        for (auto& bucket : buckets_)
+        {
+            auto hook = bucket.first;
+            while (hook)
+            {
+                const auto next = hook->next_;
+                hook->next_ = nullptr;
+                hook->prevNext_ = nullptr;
+                hook = next;
+            }
+
+            bucket.first = nullptr;
+        }
+
+        size_ = 0;
+    }
+
+    intrusive_hash_table& operator=(const intrusive_hash_table& other) = delete;
+
+    intrusive_hash_table& operator=(intrusive_hash_table&& other) noexcept
+    {
+        if (&other != this)
+        {
+            clear();
+
+            buckets_ = other.buckets_;
+            size_ = other.size_;
+            keyOf_ = std::move(other.keyOf_);
+            hash_ = std::move(other.hash_);
+            keyEqual_ = std::move(other.keyEqual_);
+
+            other.buckets_ = span<intrusive_hash_bucket>();
+            other.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    intrusive_hash_table() = default;
+
+    explicit intrusive_hash_table(span<intrusive_hash_bucket> buckets,
+        const KeyOf& keyOf = KeyOf(), const Hash& hash = Hash(),
+        const KeyEqual& keyEqual = KeyEqual())
+        : buckets_(buckets)
+        , keyOf_(keyOf)
+        , hash_(hash)
+        , keyEqual_(keyEqual)
+    {
+        validate_buckets_(buckets);
+    }
+
+    intrusive_hash_table(const intrusive_hash_table& other) = delete;
+
+    intrusive_hash_table(intrusive_hash_table&& other) noexcept
+        : buckets_(other.buckets_)
+        , size_(other.size_)
+        , keyOf_(std::move(other.keyOf_))
+        , hash_(std::move(other.hash_))
+        , keyEqual_(std::move(other.keyEqual_))
+    {
+        other.buckets_ = span<intrusive_hash_bucket>();
+        other.size_ = 0;
+    }
+
+    ~intrusive_hash_table()
+    {
+        clear();
+    }
+};
+}
+
+#endif
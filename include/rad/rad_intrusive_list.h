@@ -0,0 +1,708 @@
+/// @file rad_intrusive_list.h
+/// @author Graham Scott
+/// @brief Header file providing rad::intrusive_list and rad::intrusive_slist;
+/// linked lists whose links are stored within the objects themselves.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_INTRUSIVE_LIST_H_INCLUDED
+#define RAD_INTRUSIVE_LIST_H_INCLUDED
+
+#include <iterator>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace rad
+{
+namespace detail_
+{
+    /// @brief Returns the offset of the given hook member within T.
+    template<typename T, typename Hook>
+    inline std::size_t get_intrusive_hook_offset_(Hook T::*hookMember) noexcept
+    {
+        // NOTE: We compute the hook's offset from the address of the member within
+        // real (suitably-aligned) storage for a T; only the member's address is
+        // computed, so nothing is ever read from (or written to) the storage.
+        // Compilers fold this into a constant.
+        alignas(T) unsigned char storage[sizeof(T)];
+        const auto obj = reinterpret_cast<T*>(storage);
+
+        return static_cast<std::size_t>(
+            reinterpret_cast<unsigned char*>(&(obj->*hookMember)) - storage);
+    }
+
+    /// @brief Returns the object which contains the given hook.
+    template<typename T, typename Hook>
+    inline T* get_intrusive_owner_(Hook* hook, Hook T::*hookMember) noexcept
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(hook) -
+            get_intrusive_hook_offset_(hookMember));
+    }
+
+    template<typename T, typename Hook>
+    inline const T* get_intrusive_owner_(const Hook* hook, Hook T::*hookMember) noexcept
+    {
+        return get_intrusive_owner_(const_cast<Hook*>(hook), hookMember);
+    }
+}
+
+/// @brief The links which allow an object to be stored within an intrusive_list.
+///
+/// An object can be stored within as many intrusive_lists at once as it has hooks.
+/// Copying an object doesn't copy its hooks' links; the copy starts out unlinked.
+class intrusive_list_hook
+{
+    template<typename T, intrusive_list_hook T::*Hook>
+    friend class intrusive_list;
+
+    intrusive_list_hook*    prev_ = nullptr;
+    intrusive_list_hook*    next_ = nullptr;
+
+public:
+    /// @brief Returns whether this hook is currently linked into a list.
+    inline bool is_linked() const noexcept
+    {
+        return (next_ != nullptr);
+    }
+
+    intrusive_list_hook& operator=(const intrusive_list_hook&) noexcept
+    {
+        return *this;
+    }
+
+    intrusive_list_hook() noexcept = default;
+
+    intrusive_list_hook(const intrusive_list_hook&) noexcept
+    {
+    }
+
+    inline ~intrusive_list_hook()
+    {
+        assert(!is_linked() &&
+            "An object was destroyed while it was still linked into an intrusive_list");
+    }
+};
+
+/// @brief A doubly-linked list of objects of type T, whose links are stored within the
+/// objects themselves (in the given intrusive_list_hook member), so it never allocates.
+///
+/// Any object can be removed from the list in O(1), which makes this a good fit for
+/// pool-allocated objects which need to be tracked in one or more lists at once:
+///
+///     struct connection
+///     {
+///         rad::intrusive_list_hook    allHook;
+///         rad::intrusive_list_hook    idleHook;
+///     };
+///
+///     rad::intrusive_list<connection, &connection::allHook> allConnections;
+///     rad::intrusive_list<connection, &connection::idleHook> idleConnections;
+///
+/// NOTE: The list doesn't own its objects; they must be removed from
+/// the list before they're destroyed (or before the list is destroyed).
+template<typename T, intrusive_list_hook T::*Hook>
+class intrusive_list
+{
+    intrusive_list_hook     sentinel_;
+    std::size_t             size_ = 0;
+
+    static inline intrusive_list_hook& get_hook_(T& obj) noexcept
+    {
+        return (obj.*Hook);
+    }
+
+    static inline T& get_owner_(intrusive_list_hook* hook) noexcept
+    {
+        return *detail_::get_intrusive_owner_(hook, Hook);
+    }
+
+    inline void link_before_(intrusive_list_hook& pos, intrusive_list_hook& hook) noexcept
+    {
+        assert(!hook.is_linked() &&
+            "The given object is already linked into a list via this hook");
+
+        hook.prev_ = pos.prev_;
+        hook.next_ = &pos;
+        pos.prev_->next_ = &hook;
+        pos.prev_ = &hook;
+        ++size_;
+    }
+
+    inline void unlink_(intrusive_list_hook& hook) noexcept
+    {
+        assert(hook.is_linked() &&
+            "The given object isn't linked into a list via this hook");
+
+        hook.prev_->next_ = hook.next_;
+        hook.next_->prev_ = hook.prev_;
+        hook.prev_ = nullptr;
+        hook.next_ = nullptr;
+        --size_;
+    }
+
+    inline void reset_() noexcept
+    {
+        sentinel_.prev_ = &sentinel_;
+        sentinel_.next_ = &sentinel_;
+        size_ = 0;
+    }
+
+    void take_(intrusive_list& other) noexcept
+    {
+        if (other.empty())
+        {
+            reset_();
+            return;
+        }
+
+        sentinel_.prev_ = other.sentinel_.prev_;
+        sentinel_.next_ = other.sentinel_.next_;
+        sentinel_.prev_->next_ = &sentinel_;
+        sentinel_.next_->prev_ = &sentinel_;
+        size_ = other.size_;
+
+        other.reset_();
+    }
+
+public:
+    template<bool IsConst>
+    class basic_iterator
+    {
+        friend class intrusive_list;
+
+        template<bool OtherIsConst>
+        friend class basic_iterator;
+
+        intrusive_list_hook*    hook_ = nullptr;
+
+        explicit basic_iterator(intrusive_list_hook* hook) noexcept
+            : hook_(hook)
+        {
+        }
+
+    public:
+        using iterator_category     = std::bidirectional_iterator_tag;
+        using value_type            = T;
+        using difference_type       = std::ptrdiff_t;
+        using pointer               = std::conditional_t<IsConst, const T*, T*>;
+        using reference             = std::conditional_t<IsConst, const T&, T&>;
+
+        inline reference operator*() const noexcept
+        {
+            return get_owner_(hook_);
+        }
+
+        inline pointer operator->() const noexcept
+        {
+            return &get_owner_(hook_);
+        }
+
+        inline basic_iterator& operator++() noexcept
+        {
+            hook_ = hook_->next_;
+            return *this;
+        }
+
+        inline basic_iterator operator++(int) noexcept
+        {
+            auto prev = *this;
+            hook_ = hook_->next_;
+            return prev;
+        }
+
+        inline basic_iterator& operator--() noexcept
+        {
+            hook_ = hook_->prev_;
+            return *this;
+        }
+
+        inline basic_iterator operator--(int) noexcept
+        {
+            auto prev = *this;
+            hook_ = hook_->prev_;
+            return prev;
+        }
+
+        friend inline bool operator==(basic_iterator a, basic_iterator b) noexcept
+        {
+            return (a.hook_ == b.hook_);
+        }
+
+        friend inline bool operator!=(basic_iterator a, basic_iterator b) noexcept
+        {
+            return (a.hook_ != b.hook_);
+        }
+
+        basic_iterator() noexcept = default;
+
+        template<bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+        basic_iterator(basic_iterator<OtherIsConst> other) noexcept
+            : hook_(other.hook_)
+        {
+        }
+    };
+
+    using value_type        = T;
+    using size_type         = std::size_t;
+    using iterator          = basic_iterator<false>;
+    using const_iterator    = basic_iterator<true>;
+
+    inline size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    inline bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    inline iterator begin() noexcept
+    {
+        return iterator(sentinel_.next_);
+    }
+
+    inline const_iterator begin() const noexcept
+    {
+        return const_iterator(sentinel_.next_);
+    }
+
+    inline iterator end() noexcept
+    {
+        return iterator(&sentinel_);
+    }
+
+    inline const_iterator end() const noexcept
+    {
+        return const_iterator(const_cast<intrusive_list_hook*>(&sentinel_));
+    }
+
+    inline T& front() noexcept
+    {
+        assert(!empty() && "Cannot call front() on an empty list");
+        return get_owner_(sentinel_.next_);
+    }
+
+    inline const T& front() const noexcept
+    {
+        assert(!empty() && "Cannot call front() on an empty list");
+        return get_owner_(sentinel_.next_);
+    }
+
+    inline T& back() noexcept
+    {
+        assert(!empty() && "Cannot call back() on an empty list");
+        return get_owner_(sentinel_.prev_);
+    }
+
+    inline const T& back() const noexcept
+    {
+        assert(!empty() && "Cannot call back() on an empty list");
+        return get_owner_(sentinel_.prev_);
+    }
+
+    /// @brief Returns an iterator to the given object, which must be within this list.
+    inline iterator iterator_to(T& obj) noexcept
+    {
+        return iterator(&get_hook_(obj));
+    }
+
+    inline void push_front(T& obj) noexcept
+    {
+        link_before_(*sentinel_.next_, get_hook_(obj));
+    }
+
+    inline void push_back(T& obj) noexcept
+    {
+        link_before_(sentinel_, get_hook_(obj));
+    }
+
+    inline void pop_front() noexcept
+    {
+        assert(!empty() && "Cannot call pop_front() on an empty list");
+        unlink_(*sentinel_.next_);
+    }
+
+    inline void pop_back() noexcept
+    {
+        assert(!empty() && "Cannot call pop_back() on an empty list");
+        unlink_(*sentinel_.prev_);
+    }
+
+    /// @brief Inserts the given object before the given position.
+    inline iterator insert(const_iterator pos, T& obj) noexcept
+    {
+        auto& hook = get_hook_(obj);
+        link_before_(*pos.hook_, hook);
+
+        return iterator(&hook);
+    }
+
+    /// @brief Removes the object at the given position from this list.
+    /// @return An iterator to the object which followed the removed object.
+    inline iterator erase(const_iterator pos) noexcept
+    {
+        const auto next = pos.hook_->next_;
+        unlink_(*pos.hook_);
+
+        return iterator(next);
+    }
+
+    /// @brief Removes the given object, which must be within this list, from this list in O(1).
+    inline void remove(T& obj) noexcept
+    {
+        unlink_(get_hook_(obj));
+    }
+
+    /// @brief Removes every object from this list.
+    void clear() noexcept
+    {
+        auto hook = sentinel_.next_;
+        while (hook != &sentinel_)
+        {
+            const auto next = hook->next_;
+            hook->prev_ = nullptr;
+            hook->next_ = nullptr;
+            hook = next;
+        }
+
+        reset_();
+    }
+
+    intrusive_list& operator=(const intrusive_list& other) = delete;
+
+    intrusive_list& operator=(intrusive_list&& other) noexcept
+    {
+        if (&other != this)
+        {
+            clear();
+            take_(other);
+        }
+
+        return *this;
+    }
+
+    intrusive_list() noexcept
+    {
+        reset_();
+    }
+
+    intrusive_list(const intrusive_list& other) = delete;
+
+    intrusive_list(intrusive_list&& other) noexcept
+    {
+        take_(other);
+    }
+
+    ~intrusive_list()
+    {
+        clear();
+
+        // NOTE: The sentinel is never considered linked once the list is gone.
+        sentinel_.prev_ = nullptr;
+        sentinel_.next_ = nullptr;
+    }
+};
+
+/// @brief The link which allows an object to be stored within an intrusive_slist.
+///
+/// Copying an object doesn't copy its hook's link; the copy starts out unlinked.
+class intrusive_slist_hook
+{
+    template<typename T, intrusive_slist_hook T::*Hook>
+    friend class intrusive_slist;
+
+    /// @brief The next hook within the list, or this hook if it's the last one within
+    /// the list (so that every linked hook has a non-null next_), or nullptr if unlinked.
+    intrusive_slist_hook*   next_ = nullptr;
+
+    inline intrusive_slist_hook* get_next_() const noexcept
+    {
+        return (next_ != this) ? next_ : nullptr;
+    }
+
+public:
+    /// @brief Returns whether this hook is currently linked into a list.
+    inline bool is_linked() const noexcept
+    {
+        return (next_ != nullptr);
+    }
+
+    intrusive_slist_hook& operator=(const intrusive_slist_hook&) noexcept
+    {
+        return *this;
+    }
+
+    intrusive_slist_hook() noexcept = default;
+
+    intrusive_slist_hook(const intrusive_slist_hook&) noexcept
+    {
+    }
+
+    inline ~intrusive_slist_hook()
+    {
+        assert(!is_linked() &&
+            "An object was destroyed while it was still linked into an intrusive_slist");
+    }
+};
+
+/// @brief A singly-linked list of objects of type T, whose links are stored within the
+/// objects themselves (in the given intrusive_slist_hook member), so it never allocates.
+///
+/// This is smaller than an intrusive_list (one pointer per hook rather than two), but objects
+/// can only be removed in O(1) from the front of the list, or after a known object; use an
+/// intrusive_list if arbitrary objects need to be removed quickly.
+///
+/// NOTE: The list doesn't own its objects; they must be removed from
+/// the list before they're destroyed (or before the list is destroyed).
+template<typename T, intrusive_slist_hook T::*Hook>
+class intrusive_slist
+{
+    intrusive_slist_hook    head_;
+    std::size_t             size_ = 0;
+
+    static inline intrusive_slist_hook& get_hook_(T& obj) noexcept
+    {
+        return (obj.*Hook);
+    }
+
+    static inline T& get_owner_(intrusive_slist_hook* hook) noexcept
+    {
+        return *detail_::get_intrusive_owner_(hook, Hook);
+    }
+
+public:
+    template<bool IsConst>
+    class basic_iterator
+    {
+        friend class intrusive_slist;
+
+        template<bool OtherIsConst>
+        friend class basic_iterator;
+
+        intrusive_slist_hook*   hook_ = nullptr;
+
+        explicit basic_iterator(intrusive_slist_hook* hook) noexcept
+            : hook_(hook)
+        {
+        }
+
+    public:
+        using iterator_category     = std::forward_iterator_tag;
+        using value_type            = T;
+        using difference_type       = std::ptrdiff_t;
+        using pointer               = std::conditional_t<IsConst, const T*, T*>;
+        using reference             = std::conditional_t<IsConst, const T&, T&>;
+
+        inline reference operator*() const noexcept
+        {
+            return get_owner_(hook_);
+        }
+
+        inline pointer operator->() const noexcept
+        {
+            return &get_owner_(hook_);
+        }
+
+        inline basic_iterator& operator++() noexcept
+        {
+            hook_ = hook_->get_next_();
+            return *this;
+        }
+
+        inline basic_iterator operator++(int) noexcept
+        {
+            auto prev = *this;
+            hook_ = hook_->get_next_();
+            return prev;
+        }
+
+        friend inline bool operator==(basic_iterator a, basic_iterator b) noexcept
+        {
+            return (a.hook_ == b.hook_);
+        }
+
+        friend inline bool operator!=(basic_iterator a, basic_iterator b) noexcept
+        {
+            return (a.hook_ != b.hook_);
+        }
+
+        basic_iterator() noexcept = default;
+
+        template<bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+        basic_iterator(basic_iterator<OtherIsConst> other) noexcept
+            : hook_(other.hook_)
+        {
+        }
+    };
+
+    using value_type        = T;
+    using size_type         = std::size_t;
+    using iterator          = basic_iterator<false>;
+    using const_iterator    = basic_iterator<true>;
+
+    inline size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    inline bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    /// @brief Returns an iterator to the position before the first object,
+    /// for use with insert_after and erase_after.
+    inline iterator before_begin() noexcept
+    {
+        return iterator(&head_);
+    }
+
+    inline iterator begin() noexcept
+    {
+        return iterator(head_.next_);
+    }
+
+    inline const_iterator begin() const noexcept
+    {
+        return const_iterator(head_.next_);
+    }
+
+    inline iterator end() noexcept
+    {
+        return iterator();
+    }
+
+    inline const_iterator end() const noexcept
+    {
+        return const_iterator();
+    }
+
+    inline T& front() noexcept
+    {
+        assert(!empty() && "Cannot call front() on an empty list");
+        return get_owner_(head_.next_);
+    }
+
+    inline const T& front() const noexcept
+    {
+        assert(!empty() && "Cannot call front() on an empty list");
+        return get_owner_(head_.next_);
+    }
+
+    /// @brief Returns an iterator to the given object, which must be within this list.
+    inline iterator iterator_to(T& obj) noexcept
+    {
+        return iterator(&get_hook_(obj));
+    }
+
+    inline void push_front(T& obj) noexcept
+    {
+        insert_after(before_begin(), obj);
+    }
+
+    inline void pop_front() noexcept
+    {
+        assert(!empty() && "Cannot call pop_front() on an empty list");
+        erase_after(before_begin());
+    }
+
+    /// @brief Inserts the given object after the given position.
+    inline iterator insert_after(const_iterator pos, T& obj) noexcept
+    {
+        auto& hook = get_hook_(obj);
+        assert(!hook.is_linked() &&
+            "The given object is already linked into a list via this hook");
+
+        // NOTE: If the object is being inserted at the end of the
+        // list, it becomes the last hook, so it links to itself.
+        const auto next = pos.hook_->get_next_();
+        hook.next_ = (next) ? next : &hook;
+        pos.hook_->next_ = &hook;
+        ++size_;
+
+        return iterator(&hook);
+    }
+
+    /// @brief Removes the object which follows the given position from this list.
+    /// @return An iterator to the object which followed the removed object.
+    inline iterator erase_after(const_iterator pos) noexcept
+    {
+        const auto hook = pos.hook_->get_next_();
+        assert(hook && "There is no object after the given position to erase");
+
+        const auto next = hook->get_next_();
+
+        if (next)
+        {
+            pos.hook_->next_ = next;
+        }
+        else
+        {
+            // NOTE: The erased object was the last one, so the given position becomes
+            // the last hook (and links to itself), unless it's the list's head.
+            pos.hook_->next_ = (pos.hook_ != &head_) ? pos.hook_ : nullptr;
+        }
+
+        hook->next_ = nullptr;
+        --size_;
+
+        return iterator(next);
+    }
+
+    /// @brief Removes every object from this list.
+    void clear() noexcept
+    {
+        auto hook = head_.next_;
+        while (hook)
+        {
+            const auto next = hook->get_next_();
+            hook->next_ = nullptr;
+            hook = next;
+        }
+
+        head_.next_ = nullptr;
+        size_ = 0;
+    }
+
+    intrusive_slist& operator=(const intrusive_slist& other) = delete;
+
+    intrusive_slist& operator=(intrusive_slist&& other) noexcept
+    {
+        if (&other != this)
+        {
+            clear();
+
+            head_.next_ = other.head_.next_;
+            size_ = other.size_;
+
+            other.head_.next_ = nullptr;
+            other.size_ = 0;
+        }
+
+        return *this;
+    }
+
+    intrusive_slist() noexcept = default;
+
+    intrusive_slist(const intrusive_slist& other) = delete;
+
+    intrusive_slist(intrusive_slist&& other) noexcept
+        : size_(other.size_)
+    {
+        head_.next_ = other.head_.next_;
+
+        other.head_.next_ = nullptr;
+        other.size_ = 0;
+    }
+
+    ~intrusive_slist()
+    {
+        clear();
+    }
+};
+}
+
+#endif
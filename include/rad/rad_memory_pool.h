@@ -10,13 +10,94 @@
 #include "rad_memory.h"
 #include "rad_object_utils.h"
 #include "rad_vector.h"
+#include "rad_default_allocator.h"
+#include <algorithm>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
+#include <cstring>
+#include <cstdio>
+#include <limits>
+#include <cstdint>
 #include <cstddef>
 #include <cassert>
 
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
 namespace rad
 {
+/// @brief The order in which a memory pool hands out its free elements.
+enum class memory_pool_order
+{
+    /// @brief The most recently freed element is allocated first. This is the fastest
+    /// order, but after a lot of churn, consecutive allocations can land far apart.
+    lifo,
+
+    /// @brief The free element with the lowest address is allocated first, so that
+    /// consecutive allocations stay sequential in memory, no matter how long the
+    /// pool has been running. Tracked with a per-block bitmap of free elements.
+    address,
+
+    /// @brief Free elements are allocated from the fullest block which has any, so that
+    /// the live elements stay packed into as few blocks as possible; within that block,
+    /// the free element with the lowest address is allocated first. Tracked with a
+    /// per-block bitmap of free elements.
+    block_affine
+};
+
+struct memory_pool_stats
+{
+    /// @brief The number of blocks allocated by the pool.
+    std::size_t             blockCount = 0;
+
+    /// @brief The number of elements within each block.
+    std::size_t             elementsPerBlock = 0;
+
+    /// @brief The number of elements which are currently allocated.
+    std::size_t             liveElementCount = 0;
+
+    /// @brief The number of elements which are currently free.
+    std::size_t             freeElementCount = 0;
+
+    /// @brief The number of blocks which contain no live elements.
+    std::size_t             emptyBlockCount = 0;
+
+    /// @brief The number of times two consecutive free list entries (i.e. two free
+    /// elements which would be allocated one after the other) are located within
+    /// different blocks.
+    std::size_t             freeListBlockSwitchCount = 0;
+
+    /// @brief The average distance, in bytes, between the addresses of
+    /// consecutive free list entries. In a freshly-created pool, this is
+    /// just the size of one element; it grows as the free list gets scrambled.
+    double                  freeListAverageDistance = 0;
+
+    /// @brief A score from 0 to 1 describing how scattered the free elements are.
+    ///
+    /// 0 means the free elements are packed into as few blocks as possible (i.e. as
+    /// many blocks as possible are empty). 1 means that, although there are enough free
+    /// elements to fill at least one whole block, every block contains live elements.
+    double                  fragmentation = 0;
+
+    /// @brief The number of live elements within each block, in allocation order.
+    vector<std::size_t>     liveElementsPerBlock;
+
+    inline std::size_t capacity() const noexcept
+    {
+        return (blockCount * elementsPerBlock);
+    }
+
+    /// @brief Returns the fraction (from 0 to 1) of the pool's elements which are live.
+    inline double utilization() const noexcept
+    {
+        return (capacity() > 0) ?
+            (static_cast<double>(liveElementCount) / capacity()) : 0.0;
+    }
+};
+
 namespace detail_
 {
     template<typename T>
@@ -45,51 +126,516 @@ namespace detail_
             // Validate arguments.
             assert((elementCount > 0) &&
                 "elementCount must be non-zero");
+        }
+    };
+
+    /// @brief The address of a memory pool block, and its index within the pool.
+    using memory_pool_block_address_ = std::pair<std::uintptr_t, std::size_t>;
+
+    template<typename T>
+    vector<memory_pool_block_address_> sort_memory_pool_blocks_(
+        const memory_pool_block<T>* blocks, std::size_t blockCount)
+    {
+        vector<memory_pool_block_address_> sortedBlocks;
+        sortedBlocks.reserve(blockCount);
+
+        for (std::size_t i = 0; i < blockCount; ++i)
+        {
+            sortedBlocks.emplace_back(reinterpret_cast<std::uintptr_t>(blocks[i].data()), i);
+        }
+
+        std::sort(sortedBlocks.begin(), sortedBlocks.end());
+        return sortedBlocks;
+    }
+
+    /// @brief Returns the index of the block which contains the given element.
+    /// @param sortedBlocks The pool's blocks, as returned by sort_memory_pool_blocks_.
+    template<typename T>
+    std::size_t find_memory_pool_block_(const vector<memory_pool_block_address_>& sortedBlocks,
+        std::size_t elementsPerBlock, const memory_pool_element<T>* element) noexcept
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(element);
+        const auto blockIt = (std::upper_bound(sortedBlocks.begin(), sortedBlocks.end(),
+            address, [](std::uintptr_t addr, const memory_pool_block_address_& block)
+            {
+                return (addr < block.first);
+            }) - 1);
+
+        assert(address >= blockIt->first && address < (blockIt->first +
+            (sizeof(memory_pool_element<T>) * elementsPerBlock)) &&
+            "The given element doesn't belong to this pool");
+
+        return blockIt->second;
+    }
+
+    inline std::size_t find_first_set_(std::uint64_t bits) noexcept
+    {
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<std::size_t>(index);
+    #else
+        return static_cast<std::size_t>(__builtin_ctzll(bits));
+    #endif
+    }
+
+    /// @brief Tracks which elements of a memory pool's blocks are free, and
+    /// hands them out in the given order. See memory_pool_order.
+    template<typename T, memory_pool_order Order>
+    class memory_pool_free_list_
+    {
+        struct block_
+        {
+            memory_pool_element<T>*     elements;
+            std::size_t                 elementCount;
+            std::size_t                 freeCount;
+            std::size_t                 firstWordIndex;
+        };
+
+        static constexpr std::size_t bitsPerWord_ = 64;
+
+        // NOTE: Sorted by address, so the block containing an element can be found quickly.
+        vector<block_>              blocks_;
+
+        // NOTE: Each block's bit for an element is set if the element is free.
+        vector<std::uint64_t>       words_;
+
+        // NOTE: For address order, the lowest block which may contain free elements.
+        // For block-affine order, the block elements are currently being allocated from.
+        std::size_t                 blockIndex_ = 0;
+
+        static inline std::uintptr_t get_address_(const memory_pool_element<T>* element) noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(element);
+        }
+
+        std::size_t find_block_(const memory_pool_element<T>* element) const noexcept
+        {
+            const auto address = get_address_(element);
+            const auto blockIt = (std::upper_bound(blocks_.begin(), blocks_.end(),
+                address, [](std::uintptr_t addr, const block_& block)
+                {
+                    return (addr < get_address_(block.elements));
+                }) - 1);
+
+            assert(address >= get_address_(blockIt->elements) &&
+                address < get_address_(blockIt->elements + blockIt->elementCount) &&
+                "The given element doesn't belong to this pool");
+
+            return static_cast<std::size_t>(blockIt - blocks_.begin());
+        }
+
+        std::size_t find_fullest_block_() const noexcept
+        {
+            auto fullestBlockIndex = blocks_.size();
+
+            for (std::size_t i = 0; i < blocks_.size(); ++i)
+            {
+                if (blocks_[i].freeCount > 0 && (fullestBlockIndex == blocks_.size() ||
+                    blocks_[i].freeCount < blocks_[fullestBlockIndex].freeCount))
+                {
+                    fullestBlockIndex = i;
+                }
+            }
+
+            return fullestBlockIndex;
+        }
+
+        template<typename Func>
+        void for_each_in_block_(const block_& block, Func& func) const
+        {
+            const auto wordCount = ((block.elementCount + (bitsPerWord_ - 1)) / bitsPerWord_);
+
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                for (auto bits = words_[block.firstWordIndex + i]; bits; bits &= (bits - 1))
+                {
+                    func(&block.elements[(i * bitsPerWord_) + find_first_set_(bits)]);
+                }
+            }
+        }
+
+    public:
+        /// @brief Calls the given function for every free element, in allocation order.
+        template<typename Func>
+        void for_each(Func&& func) const
+        {
+            if constexpr (Order == memory_pool_order::address)
+            {
+                for (const auto& block : blocks_)
+                {
+                    for_each_in_block_(block, func);
+                }
+            }
+            else
+            {
+                // NOTE: The current block is used until it's full; after that,
+                // blocks are used from fullest to emptiest.
+                vector<std::size_t> blockOrder;
+                for (std::size_t i = 0; i < blocks_.size(); ++i)
+                {
+                    if (blocks_[i].freeCount > 0 && i != blockIndex_)
+                    {
+                        blockOrder.push_back(i);
+                    }
+                }
+
+                std::stable_sort(blockOrder.begin(), blockOrder.end(),
+                    [this](std::size_t a, std::size_t b)
+                    {
+                        return (blocks_[a].freeCount < blocks_[b].freeCount);
+                    });
+
+                if (blockIndex_ < blocks_.size())
+                {
+                    for_each_in_block_(blocks_[blockIndex_], func);
+                }
+
+                for (const auto i : blockOrder)
+                {
+                    for_each_in_block_(blocks_[i], func);
+                }
+            }
+        }
+
+        [[nodiscard]] memory_pool_element<T>* pop() noexcept
+        {
+            // Find the block to allocate from.
+            if constexpr (Order == memory_pool_order::address)
+            {
+                while (blockIndex_ < blocks_.size() && blocks_[blockIndex_].freeCount == 0)
+                {
+                    ++blockIndex_;
+                }
+            }
+            else
+            {
+                if (blockIndex_ >= blocks_.size() || blocks_[blockIndex_].freeCount == 0)
+                {
+                    blockIndex_ = find_fullest_block_();
+                }
+            }
+
+            if (blockIndex_ >= blocks_.size())
+            {
+                return nullptr;
+            }
+
+            // Find and claim the first free element within the block.
+            auto& block = blocks_[blockIndex_];
+            auto wordIndex = block.firstWordIndex;
+
+            while (words_[wordIndex] == 0)
+            {
+                ++wordIndex;
+            }
+
+            const auto bitIndex = find_first_set_(words_[wordIndex]);
+            words_[wordIndex] &= (words_[wordIndex] - 1);
+            --block.freeCount;
+
+            return &block.elements[((wordIndex - block.firstWordIndex) * bitsPerWord_) + bitIndex];
+        }
+
+        void push(memory_pool_element<T>* element) noexcept
+        {
+            const auto blockIndex = find_block_(element);
+            auto& block = blocks_[blockIndex];
+            const auto elementIndex = static_cast<std::size_t>(element - block.elements);
+
+            words_[block.firstWordIndex + (elementIndex / bitsPerWord_)] |=
+                (std::uint64_t(1) << (elementIndex % bitsPerWord_));
+
+            ++block.freeCount;
+
+            if constexpr (Order == memory_pool_order::address)
+            {
+                blockIndex_ = std::min(blockIndex_, blockIndex);
+            }
+        }
+
+        /// @brief Adds a block to the free list.
+        /// @param isElementFree Which of the block's elements are free, or
+        /// nullptr if every element within the block is free.
+        void add_block(memory_pool_element<T>* elements, std::size_t elementCount,
+            const unsigned char* isElementFree = nullptr)
+        {
+            // Add the block's bits.
+            block_ newBlock = { elements, elementCount, 0, words_.size() };
+            const auto wordCount = ((elementCount + (bitsPerWord_ - 1)) / bitsPerWord_);
+
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                words_.push_back(0);
+            }
+
+            for (std::size_t i = 0; i < elementCount; ++i)
+            {
+                if (!isElementFree || isElementFree[i])
+                {
+                    words_[newBlock.firstWordIndex + (i / bitsPerWord_)] |=
+                        (std::uint64_t(1) << (i % bitsPerWord_));
+
+                    ++newBlock.freeCount;
+                }
+            }
+
+            // Insert the block, keeping the blocks sorted by address.
+            const auto address = get_address_(elements);
+            const auto newBlockIndex = static_cast<std::size_t>(std::upper_bound(
+                blocks_.begin(), blocks_.end(), address,
+                [](std::uintptr_t addr, const block_& block)
+                {
+                    return (addr < get_address_(block.elements));
+                }) - blocks_.begin());
 
-            // Initialize all elements.
-            auto element = data();
-            const auto lastElement = (element + (elementCount - 1));
+            blocks_.push_back(newBlock);
+            std::rotate(blocks_.begin() + newBlockIndex, blocks_.end() - 1, blocks_.end());
 
-            while (element != lastElement)
+            if (blockIndex_ >= newBlockIndex)
             {
-                element->next = (element + 1);
-                ++element;
+                ++blockIndex_;
             }
 
-            element->next = nullptr;
+            if constexpr (Order == memory_pool_order::address)
+            {
+                if (newBlock.freeCount > 0)
+                {
+                    blockIndex_ = std::min(blockIndex_, newBlockIndex);
+                }
+            }
+        }
+
+        /// @brief Removes every block from the free list.
+        ///
+        /// NOTE: The free list's memory is kept, so that re-adding (at most) as many
+        /// blocks as were removed can't throw; dynamic_memory_pool::compact relies on this.
+        inline void clear() noexcept
+        {
+            blocks_.erase(blocks_.begin(), blocks_.end());
+            words_.erase(words_.begin(), words_.end());
+            blockIndex_ = 0;
         }
     };
+
+    template<typename T>
+    class memory_pool_free_list_<T, memory_pool_order::lifo>
+    {
+        memory_pool_element<T>*     first_ = nullptr;
+
+    public:
+        /// @brief Calls the given function for every free element, in allocation order.
+        template<typename Func>
+        void for_each(Func&& func) const
+        {
+            for (auto element = first_; element; element = element->next)
+            {
+                func(element);
+            }
+        }
+
+        [[nodiscard]] inline memory_pool_element<T>* pop() noexcept
+        {
+            const auto element = first_;
+            if (element)
+            {
+                first_ = element->next;
+            }
+
+            return element;
+        }
+
+        inline void push(memory_pool_element<T>* element) noexcept
+        {
+            element->next = first_;
+            first_ = element;
+        }
+
+        /// @brief Adds a block's free elements to the front of the free list, in address order.
+        /// @param isElementFree Which of the block's elements are free, or
+        /// nullptr if every element within the block is free.
+        void add_block(memory_pool_element<T>* elements, std::size_t elementCount,
+            const unsigned char* isElementFree = nullptr) noexcept
+        {
+            auto prevNext = &first_;
+            const auto oldFirst = first_;
+
+            for (std::size_t i = 0; i < elementCount; ++i)
+            {
+                if (!isElementFree || isElementFree[i])
+                {
+                    *prevNext = &elements[i];
+                    prevNext = &elements[i].next;
+                }
+            }
+
+            *prevNext = oldFirst;
+        }
+
+        /// @brief Removes every element from the free list.
+        inline void clear() noexcept
+        {
+            first_ = nullptr;
+        }
+
+        memory_pool_free_list_& operator=(const memory_pool_free_list_& other) = delete;
+
+        memory_pool_free_list_& operator=(memory_pool_free_list_&& other) noexcept
+        {
+            if (&other != this)
+            {
+                first_ = other.first_;
+                other.first_ = nullptr;
+            }
+
+            return *this;
+        }
+
+        memory_pool_free_list_() noexcept = default;
+
+        memory_pool_free_list_(const memory_pool_free_list_& other) = delete;
+
+        memory_pool_free_list_(memory_pool_free_list_&& other) noexcept
+            : first_(other.first_)
+        {
+            other.first_ = nullptr;
+        }
+    };
+
+    /// @brief Moves the object at src into the uninitialized memory at dst, and
+    /// destroys the (now moved-from) object at src.
+    template<typename T>
+    void relocate_memory_pool_object_(T* src, T* dst) noexcept
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            // NOTE: trivially-copyable types are safe to perform bitwise-copies on.
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T));
+        }
+        else
+        {
+            static_assert(std::is_nothrow_move_constructible_v<T>,
+                "T must be trivially-copyable or nothrow move constructible to be relocated");
+
+            new (dst) T(std::move(*src));
+            rad::destruct(*src);
+        }
+    }
+
+    template<typename T, typename FreeList>
+    memory_pool_stats compute_memory_pool_stats_(const memory_pool_block<T>* blocks,
+        std::size_t blockCount, std::size_t elementsPerBlock, const FreeList& freeList)
+    {
+        memory_pool_stats stats;
+        stats.blockCount = blockCount;
+        stats.elementsPerBlock = elementsPerBlock;
+
+        if (blockCount == 0)
+        {
+            return stats;
+        }
+
+        // Sort the blocks by address, so we can quickly find which block each free element is in.
+        const auto sortedBlocks = sort_memory_pool_blocks_(blocks, blockCount);
+
+        // Walk the free list.
+        vector<std::size_t> freeElementsPerBlock(blockCount, std::size_t(0));
+        std::uintptr_t prevAddress = 0;
+        std::size_t prevBlockIndex = 0;
+        double totalDistance = 0;
+
+        freeList.for_each([&](const memory_pool_element<T>* element)
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(element);
+            const auto blockIndex = find_memory_pool_block_(sortedBlocks,
+                elementsPerBlock, element);
+
+            ++freeElementsPerBlock[blockIndex];
+
+            if (stats.freeElementCount++ > 0)
+            {
+                totalDistance += static_cast<double>((address > prevAddress) ?
+                    (address - prevAddress) : (prevAddress - address));
+
+                stats.freeListBlockSwitchCount += (blockIndex != prevBlockIndex);
+            }
+
+            prevAddress = address;
+            prevBlockIndex = blockIndex;
+        });
+
+        if (stats.freeElementCount > 1)
+        {
+            stats.freeListAverageDistance = (totalDistance / (stats.freeElementCount - 1));
+        }
+
+        // Compute per-block occupancy.
+        stats.liveElementsPerBlock.reserve(blockCount);
+
+        for (const auto freeCount : freeElementsPerBlock)
+        {
+            const auto liveCount = (elementsPerBlock - freeCount);
+
+            stats.liveElementsPerBlock.push_back(liveCount);
+            stats.liveElementCount += liveCount;
+            stats.emptyBlockCount += (liveCount == 0);
+        }
+
+        // Compute fragmentation by comparing the number of empty blocks against the
+        // number of blocks which would be empty if the free elements were fully packed.
+        const auto idealEmptyBlockCount = (stats.freeElementCount / elementsPerBlock);
+
+        if (idealEmptyBlockCount > 0)
+        {
+            stats.fragmentation = (1.0 - (static_cast<double>(stats.emptyBlockCount) /
+                idealEmptyBlockCount));
+        }
+
+        return stats;
+    }
 }
 
-template<typename T>
+/// @tparam T The type of object to allocate.
+/// @tparam Order The order in which free elements are allocated; see memory_pool_order.
+template<typename T, memory_pool_order Order = memory_pool_order::lifo>
 class fixed_memory_pool
 {
-    detail_::memory_pool_block<T>       block_;
-    detail_::memory_pool_element<T>*    firstFreeElement_ = nullptr;
+    detail_::memory_pool_block<T>               block_;
+    detail_::memory_pool_free_list_<T, Order>   freeList_;
+    std::size_t                                 elementCount_ = 0;
 
 public:
+    /// @brief Returns the total number of elements (both live and free) within this pool.
+    inline std::size_t capacity() const noexcept
+    {
+        return elementCount_;
+    }
+
+    /// @brief Computes statistics about this pool's occupancy and free list.
+    ///
+    /// NOTE: This walks the entire free list, so it's intended for debugging and profiling.
+    memory_pool_stats get_stats() const
+    {
+        return detail_::compute_memory_pool_stats_(&block_,
+            (elementCount_ > 0) ? 1 : 0, elementCount_, freeList_);
+    }
+
     [[nodiscard]] T* allocate() noexcept
     {
         // If no elements are free, the allocation failed; return nullptr.
-        if (!firstFreeElement_)
+        const auto element = freeList_.pop();
+        if (!element)
         {
             return nullptr;
         }
 
-        // Return pointer to the first free element's data, and update our pointer.
-        const auto element = firstFreeElement_;
-        firstFreeElement_ = element->next;
-
         return &element->data;
     }
 
     void deallocate(T* ptr) noexcept
     {
-        const auto element = reinterpret_cast<detail_::memory_pool_element<T>*>(ptr);
-
-        // Reclaim the given element, and update our pointer.
-        element->next = firstFreeElement_;
-        firstFreeElement_ = element;
+        // Reclaim the given element.
+        freeList_.push(reinterpret_cast<detail_::memory_pool_element<T>*>(ptr));
     }
 
     fixed_memory_pool& operator=(const fixed_memory_pool& other) = delete;
@@ -99,9 +645,10 @@ public:
         if (&other != this)
         {
             block_ = std::move(other.block_);
-            firstFreeElement_ = other.firstFreeElement_;
+            freeList_ = std::move(other.freeList_);
+            elementCount_ = other.elementCount_;
 
-            other.firstFreeElement_ = nullptr;
+            other.elementCount_ = 0;
         }
 
         return *this;
@@ -111,56 +658,216 @@ public:
 
     fixed_memory_pool(std::size_t elementCount)
         : block_(elementCount)
-        , firstFreeElement_(block_.data())
+        , elementCount_(elementCount)
     {
+        freeList_.add_block(block_.data(), elementCount);
     }
 
     fixed_memory_pool(const fixed_memory_pool& other) = delete;
 
     fixed_memory_pool(fixed_memory_pool&& other) noexcept
         : block_(std::move(other.block_))
-        , firstFreeElement_(other.firstFreeElement_)
+        , freeList_(std::move(other.freeList_))
+        , elementCount_(other.elementCount_)
     {
-        other.firstFreeElement_ = nullptr;
+        other.elementCount_ = 0;
     }
 };
 
-template<typename T>
+/// @tparam T The type of object to allocate.
+/// @tparam Order The order in which free elements are allocated; see memory_pool_order.
+template<typename T, memory_pool_order Order = memory_pool_order::lifo>
 class dynamic_memory_pool
 {
-    vector<detail_::memory_pool_block<T>>   blocks_;
-    detail_::memory_pool_element<T>*        firstFreeElement_ = nullptr;
-    std::size_t                             elementsPerBlock_;
+    vector<detail_::memory_pool_block<T>>       blocks_;
+    detail_::memory_pool_free_list_<T, Order>   freeList_;
+    std::size_t                                 elementsPerBlock_;
 
 public:
-    [[nodiscard]] T* allocate()
+    /// @brief Returns the number of blocks which have been allocated by this pool.
+    inline std::size_t block_count() const noexcept
     {
-        // If no elements are free, allocate a new block.
-        detail_::memory_pool_element<T>* element;
+        return blocks_.size();
+    }
+
+    inline std::size_t elements_per_block() const noexcept
+    {
+        return elementsPerBlock_;
+    }
+
+    /// @brief Returns the total number of elements (both live and free) within this pool.
+    inline std::size_t capacity() const noexcept
+    {
+        return (blocks_.size() * elementsPerBlock_);
+    }
+
+    /// @brief Computes statistics about this pool's occupancy and free list.
+    ///
+    /// NOTE: This walks the entire free list, so it's intended for debugging and profiling.
+    memory_pool_stats get_stats() const
+    {
+        return detail_::compute_memory_pool_stats_(blocks_.data(),
+            blocks_.size(), elementsPerBlock_, freeList_);
+    }
 
-        if (!firstFreeElement_)
+    /// @brief Moves live objects out of the pool's sparsest blocks and into free
+    /// elements within its densest blocks, frees any blocks which were emptied
+    /// as a result, and rebuilds the free list in address order.
+    ///
+    /// This gives memory back to the system, and restores the locality of future
+    /// allocations after a long period of scattered allocations/deallocations.
+    ///
+    /// Objects are relocated via memcpy if T is trivially-copyable; otherwise, they're
+    /// move-constructed into their new location and the old objects are destroyed.
+    ///
+    /// NOTE: Every pointer to a relocated object is invalidated. The given callback
+    /// is called for every relocated object, so that such pointers (or any indirection
+    /// tables that map handles to objects) can be updated.
+    ///
+    /// @param relocate A function with the signature void(T* oldPtr, T* newPtr), which
+    /// is called after each object has been moved from oldPtr to newPtr.
+    /// @return The number of blocks which were freed.
+    template<typename RelocateFunc>
+    std::size_t compact(RelocateFunc&& relocate)
+    {
+        if (blocks_.empty())
         {
-            const auto& newestBlock = blocks_.emplace_back(elementsPerBlock_);
-            element = newestBlock.data();
+            return 0;
         }
-        else
+
+        // Mark which elements are free.
+        const auto blockCount = blocks_.size();
+        const auto sortedBlocks = detail_::sort_memory_pool_blocks_(blocks_.data(), blockCount);
+        vector<unsigned char> isElementFree(blockCount * elementsPerBlock_, (unsigned char)0);
+        vector<std::size_t> liveElementsPerBlock(blockCount, elementsPerBlock_);
+        std::size_t liveElementCount = capacity();
+
+        freeList_.for_each([&](const detail_::memory_pool_element<T>* element)
+        {
+            const auto blockIndex = detail_::find_memory_pool_block_(
+                sortedBlocks, elementsPerBlock_, element);
+
+            const auto elementIndex = static_cast<std::size_t>(
+                element - blocks_[blockIndex].data());
+
+            isElementFree[(blockIndex * elementsPerBlock_) + elementIndex] = 1;
+            --liveElementsPerBlock[blockIndex];
+            --liveElementCount;
+        });
+
+        // Order the blocks from densest to sparsest, and determine how
+        // many of the densest blocks are needed to hold every live object.
+        vector<std::size_t> blockOrder;
+        blockOrder.reserve(blockCount);
+
+        for (const auto& sortedBlock : sortedBlocks)
         {
-            element = firstFreeElement_;
+            blockOrder.push_back(sortedBlock.second);
         }
 
-        // Return pointer to the first free element's data, and update our pointer.
-        firstFreeElement_ = element->next;
+        std::stable_sort(blockOrder.begin(), blockOrder.end(),
+            [&liveElementsPerBlock](std::size_t a, std::size_t b)
+            {
+                return (liveElementsPerBlock[a] > liveElementsPerBlock[b]);
+            });
+
+        const auto keptBlockCount = std::max<std::size_t>(1,
+            (liveElementCount + (elementsPerBlock_ - 1)) / elementsPerBlock_);
+
+        vector<unsigned char> isBlockKept(blockCount, (unsigned char)0);
+        for (std::size_t i = 0; i < keptBlockCount; ++i)
+        {
+            isBlockKept[blockOrder[i]] = 1;
+        }
+
+        // NOTE: We reserve space for the kept blocks before relocating anything, so
+        // that nothing can throw once the first object has been relocated (rebuilding
+        // the free list below re-uses its existing memory, so that can't throw either).
+        vector<detail_::memory_pool_block<T>> keptBlocks;
+        keptBlocks.reserve(keptBlockCount);
+
+        // Move every live object within the sparsest blocks into the densest blocks.
+        std::size_t dstOrderIndex = 0, dstElementIndex = 0;
+
+        for (std::size_t srcOrderIndex = keptBlockCount; srcOrderIndex < blockCount; ++srcOrderIndex)
+        {
+            const auto srcBlockIndex = blockOrder[srcOrderIndex];
+            const auto srcElements = blocks_[srcBlockIndex].data();
+
+            for (std::size_t srcElementIndex = 0;
+                srcElementIndex < elementsPerBlock_; ++srcElementIndex)
+            {
+                if (isElementFree[(srcBlockIndex * elementsPerBlock_) + srcElementIndex])
+                {
+                    continue;
+                }
+
+                // Find the next free element within the densest blocks.
+                while (!isElementFree[(blockOrder[dstOrderIndex] *
+                    elementsPerBlock_) + dstElementIndex])
+                {
+                    if (++dstElementIndex == elementsPerBlock_)
+                    {
+                        dstElementIndex = 0;
+                        ++dstOrderIndex;
+                    }
+                }
+
+                const auto dstBlockIndex = blockOrder[dstOrderIndex];
+                const auto src = &srcElements[srcElementIndex].data;
+                const auto dst = &blocks_[dstBlockIndex].data()[dstElementIndex].data;
+
+                detail_::relocate_memory_pool_object_(src, dst);
+                isElementFree[(dstBlockIndex * elementsPerBlock_) + dstElementIndex] = 0;
+
+                relocate(src, dst);
+            }
+        }
+
+        // Keep only the densest blocks (in address order), and rebuild the free list.
+        // NOTE: The blocks are added to the free list in reverse address order, as
+        // each block's free elements are added to the front of the free list.
+        freeList_.clear();
+
+        for (auto it = sortedBlocks.end(); it != sortedBlocks.begin();)
+        {
+            const auto blockIndex = (--it)->second;
+            if (!isBlockKept[blockIndex])
+            {
+                continue;
+            }
+
+            freeList_.add_block(blocks_[blockIndex].data(), elementsPerBlock_,
+                &isElementFree[blockIndex * elementsPerBlock_]);
+
+            keptBlocks.push_back(std::move(blocks_[blockIndex]));
+        }
+
+        std::reverse(keptBlocks.begin(), keptBlocks.end());
+        blocks_ = std::move(keptBlocks);
+        return (blockCount - keptBlockCount);
+    }
+
+    [[nodiscard]] T* allocate()
+    {
+        // If no elements are free, allocate a new block.
+        auto element = freeList_.pop();
+
+        if (!element)
+        {
+            const auto& newestBlock = blocks_.emplace_back(elementsPerBlock_);
+            freeList_.add_block(newestBlock.data(), elementsPerBlock_);
+
+            element = freeList_.pop();
+        }
 
         return &element->data;
     }
 
     void deallocate(T* ptr) noexcept
     {
-        const auto element = reinterpret_cast<detail_::memory_pool_element<T>*>(ptr);
-
-        // Reclaim the given element, and update our pointer.
-        element->next = firstFreeElement_;
-        firstFreeElement_ = element;
+        // Reclaim the given element.
+        freeList_.push(reinterpret_cast<detail_::memory_pool_element<T>*>(ptr));
     }
 
     dynamic_memory_pool& operator=(const dynamic_memory_pool& other) = delete;
@@ -170,10 +877,8 @@ public:
         if (&other != this)
         {
             blocks_ = std::move(other.blocks_);
-            firstFreeElement_ = other.firstFreeElement_;
+            freeList_ = std::move(other.freeList_);
             elementsPerBlock_ = other.elementsPerBlock_;
-
-            other.firstFreeElement_ = nullptr;
         }
 
         return *this;
@@ -183,21 +888,450 @@ public:
 
     dynamic_memory_pool(std::size_t elementsPerBlock)
         : blocks_(1, elementsPerBlock)
-        , firstFreeElement_(blocks_[0].data())
         , elementsPerBlock_(elementsPerBlock)
     {
+        freeList_.add_block(blocks_[0].data(), elementsPerBlock);
     }
 
     dynamic_memory_pool(const dynamic_memory_pool& other) = delete;
 
     dynamic_memory_pool(dynamic_memory_pool&& other) noexcept
         : blocks_(std::move(other.blocks_))
-        , firstFreeElement_(other.firstFreeElement_)
+        , freeList_(std::move(other.freeList_))
         , elementsPerBlock_(other.elementsPerBlock_)
     {
-        other.firstFreeElement_ = nullptr;
     }
 };
+
+/// @brief A 32-bit index of an object allocated from an indexed_memory_pool.
+///
+/// Unlike a T*, a pool_index stays valid when the pool grows (and moves its objects).
+template<typename T>
+class pool_index
+{
+    std::uint32_t value_ = invalid_value;
+
+public:
+    static constexpr std::uint32_t invalid_value = (std::numeric_limits<std::uint32_t>::max)();
+
+    inline constexpr std::uint32_t value() const noexcept
+    {
+        return value_;
+    }
+
+    inline constexpr bool is_valid() const noexcept
+    {
+        return (value_ != invalid_value);
+    }
+
+    inline constexpr explicit operator bool() const noexcept
+    {
+        return is_valid();
+    }
+
+    friend inline constexpr bool operator==(pool_index a, pool_index b) noexcept
+    {
+        return (a.value_ == b.value_);
+    }
+
+    friend inline constexpr bool operator!=(pool_index a, pool_index b) noexcept
+    {
+        return (a.value_ != b.value_);
+    }
+
+    constexpr pool_index() noexcept = default;
+
+    constexpr explicit pool_index(std::uint32_t value) noexcept
+        : value_(value)
+    {
+    }
+};
+
+namespace detail_
+{
+    template<typename T>
+    union indexed_memory_pool_element
+    {
+        std::uint32_t   next;
+        T               data;
+    };
+}
+
+/// @brief A memory pool which stores all of its elements within a single contiguous
+/// region, and hands out 32-bit pool_index values instead of pointers.
+///
+/// On 64-bit platforms, this halves the size of every reference to a pooled object
+/// (and of every free list entry), which helps a lot for pointer-dense structures such
+/// as graphs. Converting an index to a pointer is just an addition.
+///
+/// The region grows (by doubling) whenever no elements are free. Growing moves every live
+/// object, so it invalidates all pointers to them; indices, however, stay valid. Objects
+/// are moved via memcpy if T is trivially-copyable; otherwise, they're move-constructed.
+///
+/// Like the other pools, allocate returns uninitialized memory, and deallocate
+/// doesn't destroy the object; that's up to the caller.
+template<typename T>
+class indexed_memory_pool
+{
+    using element_ = detail_::indexed_memory_pool_element<T>;
+    using allocator_ = default_allocator<element_>;
+
+    static constexpr std::uint32_t invalid_index_ = pool_index<T>::invalid_value;
+
+    element_*       elements_ = nullptr;
+    std::uint32_t   capacity_ = 0;
+    std::uint32_t   usedCount_ = 0;         // NOTE: Elements past this have never been allocated.
+    std::uint32_t   liveCount_ = 0;
+    std::uint32_t   firstFreeIndex_ = invalid_index_;
+
+    void grow_()
+    {
+        // NOTE: invalid_index_ can never be a valid element index.
+        constexpr std::size_t maxCapacity = invalid_index_;
+        if (capacity_ == maxCapacity)
+        {
+            throw std::bad_alloc();
+        }
+
+        reserve(std::min<std::size_t>(std::max<std::size_t>(
+            static_cast<std::size_t>(capacity_) * 2, 16), maxCapacity));
+    }
+
+public:
+    using index_type = pool_index<T>;
+
+    /// @brief Returns the number of elements which are currently allocated.
+    inline std::size_t size() const noexcept
+    {
+        return liveCount_;
+    }
+
+    /// @brief Returns the total number of elements (both live and free) within this pool.
+    inline std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    inline T* get(pool_index<T> index) noexcept
+    {
+        assert(index.value() < usedCount_ && "The given index is out of range");
+        return &elements_[index.value()].data;
+    }
+
+    inline const T* get(pool_index<T> index) const noexcept
+    {
+        assert(index.value() < usedCount_ && "The given index is out of range");
+        return &elements_[index.value()].data;
+    }
+
+    inline T& operator[](pool_index<T> index) noexcept
+    {
+        return *get(index);
+    }
+
+    inline const T& operator[](pool_index<T> index) const noexcept
+    {
+        return *get(index);
+    }
+
+    /// @brief Returns the index of the given object, which must have been allocated from this pool.
+    inline pool_index<T> get_index(const T* ptr) const noexcept
+    {
+        const auto element = reinterpret_cast<const element_*>(ptr);
+
+        assert(element >= elements_ && element < (elements_ + usedCount_) &&
+            "The given object wasn't allocated from this pool");
+
+        return pool_index<T>(static_cast<std::uint32_t>(element - elements_));
+    }
+
+    /// @brief Computes statistics about this pool's occupancy and free list.
+    /// The pool's region is reported as a single block.
+    ///
+    /// NOTE: This walks the entire free list, so it's intended for debugging and profiling.
+    memory_pool_stats get_stats() const
+    {
+        memory_pool_stats stats;
+        if (capacity_ == 0)
+        {
+            return stats;
+        }
+
+        stats.blockCount = 1;
+        stats.elementsPerBlock = capacity_;
+        stats.liveElementCount = liveCount_;
+        stats.freeElementCount = (capacity_ - liveCount_);
+        stats.emptyBlockCount = (liveCount_ == 0);
+        stats.liveElementsPerBlock.push_back(liveCount_);
+
+        // NOTE: Elements which have never been allocated are handed out in
+        // order once the free list is empty, so they're treated as the end
+        // of the free list here.
+        double totalDistance = 0;
+        std::uint32_t prevIndex = 0;
+        bool isFirstFreeElement = true;
+
+        const auto visitFreeElement = [&](std::uint32_t index)
+        {
+            if (!isFirstFreeElement)
+            {
+                totalDistance += static_cast<double>((index > prevIndex) ?
+                    (index - prevIndex) : (prevIndex - index));
+            }
+
+            prevIndex = index;
+            isFirstFreeElement = false;
+        };
+
+        for (auto index = firstFreeIndex_; index != invalid_index_; index = elements_[index].next)
+        {
+            visitFreeElement(index);
+        }
+
+        for (auto index = usedCount_; index < capacity_; ++index)
+        {
+            visitFreeElement(index);
+        }
+
+        if (stats.freeElementCount > 1)
+        {
+            stats.freeListAverageDistance = ((totalDistance * sizeof(element_)) /
+                (stats.freeElementCount - 1));
+        }
+
+        return stats;
+    }
+
+    /// @brief Ensures that the pool can hold at least the given number of elements
+    /// without growing again.
+    ///
+    /// NOTE: If this grows the pool, all pointers to its objects are invalidated;
+    /// indices stay valid.
+    void reserve(std::size_t newCapacity)
+    {
+        if (newCapacity <= capacity_)
+        {
+            return;
+        }
+
+        if (newCapacity > invalid_index_)
+        {
+            throw std::bad_alloc();
+        }
+
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            elements_ = allocator_::reallocate(elements_, usedCount_,
+                capacity_, newCapacity RAD_IF_DEBUG_MEMORY(,
+                RAD_GET_DEBUG_MEMORY_ALLOC_INFO()));
+        }
+        else
+        {
+            static_assert(std::is_nothrow_move_constructible_v<T>,
+                "T must be trivially-copyable or nothrow move constructible to be relocated");
+
+            // Find which of the used elements are free.
+            // NOTE: We do this before allocating the new elements, so
+            // that they can't be leaked if this allocation throws.
+            vector<unsigned char> isElementFree(usedCount_, (unsigned char)0);
+
+            for (auto index = firstFreeIndex_; index != invalid_index_;
+                index = elements_[index].next)
+            {
+                isElementFree[index] = 1;
+            }
+
+            const auto newElements = allocator_::allocate(newCapacity
+                RAD_IF_DEBUG_MEMORY(, RAD_GET_DEBUG_MEMORY_ALLOC_INFO()));
+
+            if (elements_)
+            {
+                // Move the live objects, and copy the free list.
+                for (std::uint32_t i = 0; i < usedCount_; ++i)
+                {
+                    if (isElementFree[i])
+                    {
+                        newElements[i].next = elements_[i].next;
+                    }
+                    else
+                    {
+                        detail_::relocate_memory_pool_object_(
+                            &elements_[i].data, &newElements[i].data);
+                    }
+                }
+
+                allocator_::deallocate(elements_, capacity_);
+            }
+
+            elements_ = newElements;
+        }
+
+        capacity_ = static_cast<std::uint32_t>(newCapacity);
+    }
+
+    /// @brief Allocates an element, growing the pool if no elements are free.
+    /// @return The index of the allocated (uninitialized) element.
+    [[nodiscard]] pool_index<T> allocate()
+    {
+        std::uint32_t index;
+
+        if (firstFreeIndex_ != invalid_index_)
+        {
+            index = firstFreeIndex_;
+            firstFreeIndex_ = elements_[index].next;
+        }
+        else
+        {
+            if (usedCount_ == capacity_)
+            {
+                grow_();
+            }
+
+            index = usedCount_++;
+        }
+
+        ++liveCount_;
+        return pool_index<T>(index);
+    }
+
+    void deallocate(pool_index<T> index) noexcept
+    {
+        assert(index.value() < usedCount_ && "The given index is out of range");
+
+        // Reclaim the given element, and update our index.
+        elements_[index.value()].next = firstFreeIndex_;
+        firstFreeIndex_ = index.value();
+        --liveCount_;
+    }
+
+    indexed_memory_pool& operator=(const indexed_memory_pool& other) = delete;
+
+    indexed_memory_pool& operator=(indexed_memory_pool&& other) noexcept
+    {
+        if (&other != this)
+        {
+            if (elements_)
+            {
+                allocator_::deallocate(elements_, capacity_);
+            }
+
+            elements_ = other.elements_;
+            capacity_ = other.capacity_;
+            usedCount_ = other.usedCount_;
+            liveCount_ = other.liveCount_;
+            firstFreeIndex_ = other.firstFreeIndex_;
+
+            other.elements_ = nullptr;
+            other.capacity_ = 0;
+            other.usedCount_ = 0;
+            other.liveCount_ = 0;
+            other.firstFreeIndex_ = invalid_index_;
+        }
+
+        return *this;
+    }
+
+    indexed_memory_pool() noexcept = default;
+
+    explicit indexed_memory_pool(std::size_t initialCapacity)
+    {
+        reserve(initialCapacity);
+    }
+
+    indexed_memory_pool(const indexed_memory_pool& other) = delete;
+
+    indexed_memory_pool(indexed_memory_pool&& other) noexcept
+        : elements_(other.elements_)
+        , capacity_(other.capacity_)
+        , usedCount_(other.usedCount_)
+        , liveCount_(other.liveCount_)
+        , firstFreeIndex_(other.firstFreeIndex_)
+    {
+        other.elements_ = nullptr;
+        other.capacity_ = 0;
+        other.usedCount_ = 0;
+        other.liveCount_ = 0;
+        other.firstFreeIndex_ = invalid_index_;
+    }
+
+    ~indexed_memory_pool()
+    {
+        if (elements_)
+        {
+            allocator_::deallocate(elements_, capacity_);
+        }
+    }
+};
+
+/// @brief Prints the given pool statistics to the given file, including
+/// a histogram of the occupancy of each of the pool's blocks.
+inline void dump_pool_report(const memory_pool_stats& stats, std::FILE* file = stdout)
+{
+    constexpr std::size_t barWidth = 40;
+    constexpr std::size_t bucketCount = 10;
+
+    std::fprintf(file, "memory pool: %zu block(s) x %zu element(s) (%zu total)\n"
+        "  live elements:   %zu (%.1f%%)\n"
+        "  free elements:   %zu\n"
+        "  empty blocks:    %zu\n"
+        "  free list:       %.1f byte(s) average distance, %zu block switch(es)\n"
+        "  fragmentation:   %.2f\n",
+        stats.blockCount, stats.elementsPerBlock, stats.capacity(),
+        stats.liveElementCount, stats.utilization() * 100.0,
+        stats.freeElementCount, stats.emptyBlockCount,
+        stats.freeListAverageDistance, stats.freeListBlockSwitchCount,
+        stats.fragmentation);
+
+    if (stats.blockCount == 0)
+    {
+        return;
+    }
+
+    // Print the occupancy of each block.
+    std::size_t buckets[bucketCount] = {};
+    char bar[barWidth + 1];
+
+    std::fprintf(file, "  block occupancy:\n");
+
+    for (std::size_t i = 0; i < stats.liveElementsPerBlock.size(); ++i)
+    {
+        const auto liveCount = stats.liveElementsPerBlock[i];
+        const auto occupancy = (static_cast<double>(liveCount) / stats.elementsPerBlock);
+        const auto filledWidth = static_cast<std::size_t>((occupancy * barWidth) + 0.5);
+
+        std::fill(bar, bar + filledWidth, '#');
+        std::fill(bar + filledWidth, bar + barWidth, '-');
+        bar[barWidth] = '\0';
+
+        std::fprintf(file, "    %6zu [%s] %5.1f%% (%zu/%zu)\n", i, bar,
+            occupancy * 100.0, liveCount, stats.elementsPerBlock);
+
+        ++buckets[std::min(static_cast<std::size_t>(occupancy * bucketCount), bucketCount - 1)];
+    }
+
+    // Print a histogram of the number of blocks within each occupancy range.
+    std::fprintf(file, "  occupancy histogram:\n");
+
+    for (std::size_t i = 0; i < bucketCount; ++i)
+    {
+        const auto filledWidth = ((buckets[i] * barWidth) + (stats.blockCount - 1)) / stats.blockCount;
+
+        std::fill(bar, bar + filledWidth, '#');
+        bar[filledWidth] = '\0';
+
+        std::fprintf(file, "    %3zu-%3zu%% %6zu%s%s\n", i * (100 / bucketCount),
+            (i + 1) * (100 / bucketCount), buckets[i], (filledWidth > 0) ? " " : "", bar);
+    }
+}
+
+/// @brief Prints statistics about the given pool to the given file, including
+/// a histogram of the occupancy of each of the pool's blocks.
+/// @param pool The fixed_memory_pool or dynamic_memory_pool to print statistics about.
+template<typename Pool>
+void dump_pool_report(const Pool& pool, std::FILE* file = stdout)
+{
+    dump_pool_report(pool.get_stats(), file);
+}
 }
 
 #endif
@@ -122,6 +122,17 @@ namespace detail_
         is_nothrow_iterable_<InputIt, OutputIt>::value;
 }
 
+/// @brief Whether objects of type T can be relocated (i.e. moved to a new address,
+/// ending the lifetime of the old object) by simply copying their bytes, e.g. via memmove.
+///
+/// This is true for every trivially-copyable type, and can be specialized for any other
+/// type which doesn't point into itself (e.g. most types which just own a heap pointer).
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 template<typename T>
 constexpr void destruct(T& obj) noexcept
 {
@@ -39,7 +39,7 @@ constexpr bool is_separator(char c) noexcept
 #endif
 }
 
-inline bool has_trailing_separator(std::string_view path) noexcept
+constexpr bool has_trailing_separator(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return has_trailing_separator_win32(path);
@@ -48,7 +48,7 @@ inline bool has_trailing_separator(std::string_view path) noexcept
 #endif
 }
 
-inline bool has_leading_separator(const char* path) noexcept
+constexpr bool has_leading_separator(const char* path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return has_leading_separator_win32(path);
@@ -66,7 +66,7 @@ inline bool has_leading_separator(const std::string& path) noexcept
 #endif
 }
 
-inline bool has_leading_separator(std::string_view path) noexcept
+constexpr bool has_leading_separator(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return has_leading_separator_win32(path);
@@ -75,7 +75,7 @@ inline bool has_leading_separator(std::string_view path) noexcept
 #endif
 }
 
-inline std::string_view get_no_trailing_separator_path(std::string_view path) noexcept
+constexpr std::string_view get_no_trailing_separator_path(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_no_trailing_separator_path_win32(path);
@@ -84,7 +84,7 @@ inline std::string_view get_no_trailing_separator_path(std::string_view path) no
 #endif
 }
 
-inline std::string_view get_name(std::string_view path) noexcept
+constexpr std::string_view get_name(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_name_win32(path);
@@ -93,7 +93,7 @@ inline std::string_view get_name(std::string_view path) noexcept
 #endif
 }
 
-inline std::string_view get_extensions(std::string_view path) noexcept
+constexpr std::string_view get_extensions(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_extensions_win32(path);
@@ -102,7 +102,7 @@ inline std::string_view get_extensions(std::string_view path) noexcept
 #endif
 }
 
-inline std::string_view get_parent(std::string_view path) noexcept
+constexpr std::string_view get_parent(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_parent_win32(path);
@@ -120,6 +120,15 @@ inline bool append(std::string& path, std::string_view subpath)
 #endif
 }
 
+inline bool append(rad::string& path, std::string_view subpath)
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return append_win32(path, subpath);
+#else
+    return append_unix(path, subpath);
+#endif
+}
+
 inline std::string combine(std::string_view path1, std::string_view path2)
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
@@ -138,7 +147,16 @@ inline bool remove_trailing_separators(std::string& path)
 #endif
 }
 
-inline bool remove_trailing_separators(std::string_view& path)
+inline bool remove_trailing_separators(rad::string& path)
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return remove_trailing_separators_win32(path);
+#else
+    return remove_trailing_separators_unix(path);
+#endif
+}
+
+constexpr bool remove_trailing_separators(std::string_view& path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return remove_trailing_separators_win32(path);
@@ -156,7 +174,16 @@ inline bool remove_name(std::string& path)
 #endif
 }
 
-inline bool remove_name(std::string_view& path)
+inline bool remove_name(rad::string& path)
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return remove_name_win32(path);
+#else
+    return remove_name_unix(path);
+#endif
+}
+
+constexpr bool remove_name(std::string_view& path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return remove_name_win32(path);
@@ -172,7 +199,7 @@ using component_iterator =
     component_iterator_unix;
 #endif
 
-inline component_iterator get_begin(const char* path)
+constexpr component_iterator get_begin(const char* path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_begin_win32(path);
@@ -181,7 +208,7 @@ inline component_iterator get_begin(const char* path)
 #endif
 }
 
-inline component_iterator get_begin(const std::string& path)
+inline component_iterator get_begin(const std::string& path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_begin_win32(path);
@@ -190,7 +217,7 @@ inline component_iterator get_begin(const std::string& path)
 #endif
 }
 
-inline component_iterator get_begin(std::string_view path)
+constexpr component_iterator get_begin(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_begin_win32(path);
@@ -199,7 +226,7 @@ inline component_iterator get_begin(std::string_view path)
 #endif
 }
 
-inline component_iterator get_end(const char* path)
+constexpr component_iterator get_end(const char* path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_end_win32(path);
@@ -208,7 +235,7 @@ inline component_iterator get_end(const char* path)
 #endif
 }
 
-inline component_iterator get_end(const std::string& path)
+inline component_iterator get_end(const std::string& path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_end_win32(path);
@@ -217,7 +244,7 @@ inline component_iterator get_end(const std::string& path)
 #endif
 }
 
-inline component_iterator get_end(std::string_view path)
+constexpr component_iterator get_end(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return get_end_win32(path);
@@ -233,7 +260,7 @@ using component_iterators =
     component_iterators_unix;
 #endif
 
-inline component_iterators components(const char* path)
+constexpr component_iterators components(const char* path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return components_win32(path);
@@ -242,7 +269,7 @@ inline component_iterators components(const char* path)
 #endif
 }
 
-inline component_iterators components(const std::string& path)
+inline component_iterators components(const std::string& path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return components_win32(path);
@@ -251,7 +278,7 @@ inline component_iterators components(const std::string& path)
 #endif
 }
 
-inline component_iterators components(std::string_view path)
+constexpr component_iterators components(std::string_view path) noexcept
 {
 #if RAD_PATH_IS_WIN32_TARGET == 1
     return components_win32(path);
@@ -260,6 +287,62 @@ inline component_iterators components(std::string_view path)
 #endif
 }
 
+inline std::size_t split_components(std::string_view path,
+    span<std::string_view> components) noexcept
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return split_components_win32(path, components);
+#else
+    return split_components_unix(path, components);
+#endif
+}
+
+inline std::size_t component_count(std::string_view path) noexcept
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return component_count_win32(path);
+#else
+    return component_count_unix(path);
+#endif
+}
+
+inline std::string_view common_prefix(std::string_view path1,
+    std::string_view path2) noexcept
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return common_prefix_win32(path1, path2);
+#else
+    return common_prefix_unix(path1, path2);
+#endif
+}
+
+inline std::string_view common_prefix(span<const std::string_view> paths) noexcept
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return common_prefix_win32(paths);
+#else
+    return common_prefix_unix(paths);
+#endif
+}
+
+inline bool relative(std::string_view from, std::string_view to, std::string& result)
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return relative_win32(from, to, result);
+#else
+    return relative_unix(from, to, result);
+#endif
+}
+
+inline bool relative(std::string_view from, std::string_view to, rad::string& result)
+{
+#if RAD_PATH_IS_WIN32_TARGET == 1
+    return relative_win32(from, to, result);
+#else
+    return relative_unix(from, to, result);
+#endif
+}
+
 enum class entry_type
 {
     other = 0,
@@ -8,8 +8,11 @@
 #define RAD_PATH_WIN32_H_INCLUDED
 
 #include "rad_base.h"
+#include "rad_span.h"
+#include "rad_string.h"
 #include <string_view>
 #include <string>
+#include <iterator>
 #include <cstddef>
 
 namespace rad::path
@@ -19,103 +22,514 @@ constexpr bool is_separator_win32(char c) noexcept
     return (c == '/' || c == '\\');
 }
 
-RAD_API bool has_trailing_separator_win32(std::string_view path) noexcept;
-
-inline bool has_leading_separator_win32(const char* path) noexcept
+namespace detail_
 {
-    // NOTE: This overload exists to take advantage of the fact that
-    // C-strings are supposed to always end with a null-terminator, thus
-    // we don't have to check its length first.
-    return is_separator_win32(*path);
+    constexpr std::size_t get_trailing_separator_count_win32(
+        std::string_view path) noexcept
+    {
+        std::size_t i = path.size();
+
+        while (i > 0)
+        {
+            if (!is_separator_win32(path[i - 1]))
+            {
+                break;
+            }
+
+            --i;
+        }
+
+        return (path.size() - i);
+    }
+
+    constexpr std::size_t get_file_name_index_win32(std::string_view path) noexcept
+    {
+        std::size_t i = path.size();
+
+        while (i > 0)
+        {
+            --i;
+
+            if (is_separator_win32(path[i]) ||
+                path[i] == ':')
+            {
+                return (i + 1);
+            }
+        }
+        
+        return 0;
+    }
+
+    constexpr std::size_t get_extensions_index_win32(std::string_view path) noexcept
+    {
+        std::size_t i = path.size();
+        std::size_t extsIndex = i;
+
+        while (i > 0)
+        {
+            --i;
+
+            if (path[i] == '.')
+            {
+                extsIndex = i;
+            }
+            else if (is_separator_win32(path[i]) ||
+                path[i] == ':')
+            {
+                break;
+            }
+        }
+        
+        return extsIndex;
+    }
+
+    constexpr bool is_device_path_prefix_win32(std::string_view path) noexcept
+    {
+        return (path.size() == 3 &&
+            path[0] == '\\' &&
+            path[1] == '\\' &&
+            path[2] == '.');
+    }
+
+    /// @brief Checks whether the given path (which must not contain any
+    /// trailing separators) ends with a name, rather than a prefix.
+    constexpr bool has_name_win32(std::string_view noSepsPath) noexcept
+    {
+        // OPTIMIZATION: We skip checking anything else in the path
+        // since valid paths can't utilize colons or question mark
+        // characters anywhere but in their prefix anyway.
+        return (!noSepsPath.empty() &&
+            noSepsPath.back() != ':' &&                 // e.g. "C:"
+            noSepsPath.back() != '?' &&                 // e.g. "\\?"
+            !is_device_path_prefix_win32(noSepsPath));  // e.g. "\\."
+    }
 }
 
-inline bool has_leading_separator_win32(const std::string& path) noexcept
+// NOTE: Most of these functions used to be exported from libRad, so they're kept within an
+// inline namespace to give them distinct symbol names; the old exported versions are
+// kept as thin wrappers around these (see rad_path_win32.cpp), for binaries which
+// were built against older versions of libRad.
+inline namespace v2
 {
-    // NOTE: This overload exists to take advantage of the fact that
-    // std::strings are guaranteed to end with a null-terminator, thus
-    // we don't have to check if it's empty first.
-    return is_separator_win32(*path.c_str());
-}
+    constexpr bool has_trailing_separator_win32(std::string_view path) noexcept
+    {
+        return (!path.empty() && is_separator_win32(path.back()));
+    }
+
+    constexpr bool has_leading_separator_win32(const char* path) noexcept
+    {
+        // NOTE: This overload exists to take advantage of the fact that
+        // C-strings are supposed to always end with a null-terminator, thus
+        // we don't have to check its length first.
+        return is_separator_win32(*path);
+    }
+
+    inline bool has_leading_separator_win32(const std::string& path) noexcept
+    {
+        // NOTE: This overload exists to take advantage of the fact that
+        // std::strings are guaranteed to end with a null-terminator, thus
+        // we don't have to check if it's empty first.
+        return is_separator_win32(*path.c_str());
+    }
+
+    constexpr bool has_leading_separator_win32(std::string_view path) noexcept
+    {
+        return (!path.empty() && is_separator_win32(path.front()));
+    }
+
+    constexpr std::string_view get_no_trailing_separator_path_win32(std::string_view path) noexcept
+    {
+        path.remove_suffix(detail_::get_trailing_separator_count_win32(path));
+        return path;
+    }
+
+    constexpr std::string_view get_name_win32(std::string_view path) noexcept
+    {
+        path.remove_suffix(detail_::get_trailing_separator_count_win32(path));
+
+        if (detail_::has_name_win32(path))
+        {
+            path.remove_prefix(detail_::get_file_name_index_win32(path));
+            return path;
+        }
+
+        return std::string_view();
+    }
+
+    constexpr std::string_view get_extensions_win32(std::string_view path) noexcept
+    {
+        path.remove_suffix(detail_::get_trailing_separator_count_win32(path));
+
+        if (!detail_::is_device_path_prefix_win32(path))  // e.g. "\\."
+        {
+            path.remove_prefix(detail_::get_extensions_index_win32(path));
+        }
+
+        return path;
+    }
+
+    constexpr std::string_view get_parent_win32(std::string_view path) noexcept
+    {
+        path.remove_suffix(detail_::get_trailing_separator_count_win32(path));
+
+        if (detail_::has_name_win32(path))
+        {
+            path.remove_suffix(path.size() - detail_::get_file_name_index_win32(path));
+        }
+
+        return path;
+    }
 
-RAD_API bool has_leading_separator_win32(std::string_view path) noexcept;
+    constexpr bool remove_trailing_separators_win32(std::string_view& path) noexcept
+    {
+        const auto trailingSepsCount = detail_::get_trailing_separator_count_win32(path);
+        path.remove_suffix(trailingSepsCount);
+
+        return (trailingSepsCount != 0);
+    }
 
-RAD_API std::string_view get_no_trailing_separator_path_win32(std::string_view path) noexcept;
+    constexpr bool remove_name_win32(std::string_view& path) noexcept
+    {
+        const auto noSepsPath = get_no_trailing_separator_path_win32(path);
 
-RAD_API std::string_view get_name_win32(std::string_view path) noexcept;
+        if (detail_::has_name_win32(noSepsPath))
+        {
+            const auto fileNameIndex = detail_::get_file_name_index_win32(noSepsPath);
+            path = std::string_view(path.data(), fileNameIndex);
 
-RAD_API std::string_view get_extensions_win32(std::string_view path) noexcept;
+            return (fileNameIndex != 0);
+        }
 
-RAD_API std::string_view get_parent_win32(std::string_view path) noexcept;
+        return false;
+    }
+}
 
 RAD_API bool append_win32(std::string& path, std::string_view subpath);
 
+RAD_API bool append_win32(rad::string& path, std::string_view subpath);
+
 RAD_API std::string combine_win32(std::string_view path1, std::string_view path2);
 
 RAD_API bool remove_trailing_separators_win32(std::string& path);
 
-RAD_API bool remove_trailing_separators_win32(std::string_view& path);
+RAD_API bool remove_trailing_separators_win32(rad::string& path);
 
 RAD_API bool remove_name_win32(std::string& path);
 
-RAD_API bool remove_name_win32(std::string_view& path);
+RAD_API bool remove_name_win32(rad::string& path);
+
+/// @brief Replaces every separator ('/' or '\\') within the given path with newSep.
+/// @param path The path whose separators should be replaced.
+/// @param len The length of path, in chars.
+/// @param newSep The separator to replace all existing separators with.
+RAD_API void convert_separators_win32(char* path, std::size_t len, char newSep) noexcept;
+
+inline void convert_separators_win32(std::string& path, char newSep = '\\') noexcept
+{
+    convert_separators_win32(path.data(), path.size(), newSep);
+}
+
+inline void convert_separators_win32(rad::string& path, char newSep = '\\') noexcept
+{
+    convert_separators_win32(path.data(), path.size(), newSep);
+}
+
+/// @brief Converts the given Windows path into a Unix-style path.
+///
+/// All separators are converted to forward-slashes. The "\\?\" prefix
+/// is removed from verbatim paths (e.g. "\\?\C:\a" becomes "C:/a"), and
+/// verbatim UNC paths are turned into regular UNC paths (e.g.
+/// "\\?\UNC\server\share" becomes "//server/share"). Drive letters are
+/// left untouched, so the conversion can be reversed with to_win32.
+///
+/// @param path The Windows path to convert.
+/// @param result The string to store the converted path in; any existing
+/// contents are replaced, but its capacity is re-used if possible.
+RAD_API void to_unix(std::string_view path, std::string& result);
+
+RAD_API void to_unix(std::string_view path, rad::string& result);
+
+inline std::string to_unix(std::string_view path)
+{
+    std::string result;
+    to_unix(path, result);
+    return result;
+}
+
+/// @brief Converts the given Unix-style path into a Windows path.
+///
+/// All forward-slashes are converted to backslashes, which also turns
+/// paths starting with two forward-slashes into UNC paths (e.g.
+/// "//server/share" becomes "\\server\share").
+///
+/// @param path The Unix-style path to convert.
+/// @param result The string to store the converted path in; any existing
+/// contents are replaced, but its capacity is re-used if possible.
+RAD_API void to_win32(std::string_view path, std::string& result);
+
+RAD_API void to_win32(std::string_view path, rad::string& result);
+
+inline std::string to_win32(std::string_view path)
+{
+    std::string result;
+    to_win32(path, result);
+    return result;
+}
+
+/// @brief Checks whether the given Windows paths are equal, ignoring the
+/// case of ASCII letters and treating '/' and '\\' as the same character.
+RAD_API bool equals_win32_insensitive(std::string_view path1, std::string_view path2) noexcept;
+
+/// @brief Computes a hash of the given Windows path which is consistent
+/// with equals_win32_insensitive; that is, paths which compare equal
+/// via equals_win32_insensitive are guaranteed to have the same hash.
+RAD_API std::size_t hash_win32_insensitive(std::string_view path) noexcept;
 
 class component_iterator_win32
 {
-    const char*     path_ = nullptr;
+    const char*     pathBegin_ = nullptr;
+    const char*     pathEnd_ = nullptr; // NOTE: nullptr if the path is null-terminated.
+    const char*     path_ = nullptr;    // NOTE: nullptr if this is the end of a null-terminated path.
     std::size_t     curComponentLen_ = 0;
 
-    static std::size_t get_initial_component_length_(const char* path);
+    constexpr char get_char_(const char* path, std::size_t index) const noexcept
+    {
+        // NOTE: Characters past the end of the path are treated
+        // as null-terminators, so the same logic works for both
+        // null-terminated paths and paths with a known length.
+        return (pathEnd_ && static_cast<std::size_t>(pathEnd_ - path) <= index) ?
+            '\0' : path[index];
+    }
+
+    constexpr std::size_t get_initial_component_length_(const char* path) const noexcept
+    {
+        // Handle path prefixes that can only occur at the very beginning of a valid path.
+        if (get_char_(path, 0) == '\\' && get_char_(path, 1) == '\\')
+        {
+            // Handle the following special prefixes: "\\?\" and "\\.\".
+            if ((get_char_(path, 2) == '?' || get_char_(path, 2) == '.') &&
+                get_char_(path, 3) == '\\')
+            {
+                return 4;
+            }
+
+            // Handle UNC path prefixes: "\\".
+            else
+            {
+                return 2;
+            }
+        }
+        
+        return get_current_component_length_(path);
+    }
+
+    constexpr const char* skip_repeating_separators(const char* path) const noexcept
+    {
+        // NOTE: We do not need to check for the null-terminator
+        // explicitly, since a null-terminator will cause
+        // is_separator_win32 to return false, thus ending the loop.
+        while (is_separator_win32(get_char_(path, 0)))
+        {
+            ++path;
+        }
+
+        return path;
+    }
 
-    static const char* skip_repeating_separators(const char* path);
+    constexpr std::size_t get_current_component_length_(const char* path) const noexcept
+    {
+        std::size_t len = 0;
+
+        while (
+            get_char_(path, len) != '\0' &&
+            !is_separator_win32(get_char_(path, len)) &&
+
+            // NOTE: We purposefully postfix-increment len *here*, so
+            // that ':' characters ARE counted in the component length,
+            // but also cause the while loop to end.
+            get_char_(path, len++) != ':')
+        {
+        }
+        
+        return len;
+    }
 
-    static std::size_t get_current_component_length_(const char* path);
+    constexpr bool is_end_() const noexcept
+    {
+        return (!path_ || (curComponentLen_ == 0 && get_char_(path_, 0) == '\0'));
+    }
 
 public:
     using value_type = std::string_view;
     using difference_type = std::ptrdiff_t;
     using pointer = value_type*;
-    using reference = value_type&;
-    using iterator_category = std::forward_iterator_tag;
+    using reference = value_type;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    constexpr component_iterator_win32& operator++() noexcept
+    {
+        // Handle root directory special case (e.g. the backslash in "C:\whatever").
+        if (curComponentLen_ > 0 &&
+            path_[curComponentLen_ - 1] == ':' &&
+            is_separator_win32(get_char_(path_, curComponentLen_)))
+        {
+            path_ += curComponentLen_;
+            curComponentLen_ = 1;
+        }
+
+        // Get the next component of the path.
+        else
+        {
+            path_ = skip_repeating_separators(path_ + curComponentLen_);
+            curComponentLen_ = get_current_component_length_(path_);
+        }
+
+        return *this;
+    }
+
+    constexpr component_iterator_win32 operator++(int) noexcept
+    {
+        const auto it = *this;
+        ++(*this);
+        return it;
+    }
 
-    RAD_API component_iterator_win32& operator++();
+    constexpr component_iterator_win32& operator--() noexcept
+    {
+        // Find the end of the null-terminated path, if we haven't already.
+        if (!path_)
+        {
+            path_ = (pathBegin_ + std::char_traits<char>::length(pathBegin_));
+        }
+
+        // Skip over the separators which precede the current component.
+        const char* compEnd = path_;
+        while (compEnd > pathBegin_ && is_separator_win32(compEnd[-1]))
+        {
+            --compEnd;
+        }
+
+        // Handle root directory special case (e.g. the backslash in "C:\whatever").
+        if (compEnd != path_ && compEnd > pathBegin_ && compEnd[-1] == ':')
+        {
+            path_ = compEnd;
+            curComponentLen_ = 1;
+            return *this;
+        }
+
+        // Handle the initial component, which may be a special prefix.
+        const std::size_t initialLen = get_initial_component_length_(pathBegin_);
+        if (compEnd <= (pathBegin_ + initialLen))
+        {
+            path_ = pathBegin_;
+            curComponentLen_ = initialLen;
+            return *this;
+        }
+
+        // Find the beginning of the previous component. NOTE: Components
+        // can end with ':' characters, but can't otherwise contain them.
+        path_ = (compEnd[-1] == ':') ? (compEnd - 1) : compEnd;
+        while (!is_separator_win32(path_[-1]) && path_[-1] != ':')
+        {
+            --path_;
+        }
+
+        curComponentLen_ = static_cast<std::size_t>(compEnd - path_);
+        return *this;
+    }
 
-    RAD_API component_iterator_win32 operator++(int);
+    constexpr component_iterator_win32 operator--(int) noexcept
+    {
+        const auto it = *this;
+        --(*this);
+        return it;
+    }
 
-    inline value_type operator*() const noexcept
+    constexpr value_type operator*() const noexcept
     {
         return { path_, curComponentLen_ };
     }
 
-    inline bool operator==(const component_iterator_win32& other) const noexcept
+    constexpr bool operator==(const component_iterator_win32& other) const noexcept
     {
-        return (path_ == other.path_);
+        // NOTE: End iterators over null-terminated paths don't know where
+        // the path ends, so we have to compare them by state instead.
+        return (path_ && other.path_) ? (path_ == other.path_) :
+            (is_end_() && other.is_end_());
     }
 
-    inline bool operator!=(const component_iterator_win32& other) const noexcept
+    constexpr bool operator!=(const component_iterator_win32& other) const noexcept
     {
-        return (path_ != other.path_);
+        return !(*this == other);
     }
 
     constexpr component_iterator_win32() noexcept = default;
 
-    RAD_API explicit component_iterator_win32(const char* path);
+    constexpr explicit component_iterator_win32(const char* path) noexcept
+        : pathBegin_(path)
+        , path_(path)
+        , curComponentLen_(get_initial_component_length_(path))
+    {
+    }
 
-    RAD_API explicit component_iterator_win32(const std::string& path);
+    explicit component_iterator_win32(const std::string& path) noexcept
+        : pathBegin_(path.c_str())
+        , pathEnd_(path.c_str() + path.size())
+        , path_(path.c_str())
+        , curComponentLen_(get_initial_component_length_(path_))
+    {
+    }
+
+    constexpr explicit component_iterator_win32(std::string_view path) noexcept
+        : pathBegin_(path.data())
+        , pathEnd_(path.data() + path.size())
+        , path_(path.data())
+        , curComponentLen_(path.empty() ? 0 : get_initial_component_length_(path_))
+    {
+    }
 
-    RAD_API explicit component_iterator_win32(std::string_view path);
+    /// @brief Creates an end iterator over the given path.
+    /// @param pathBegin The beginning of the path.
+    /// @param pathEnd The end of the path, or nullptr if the path is null-terminated.
+    constexpr component_iterator_win32(const char* pathBegin, const char* pathEnd) noexcept
+        : pathBegin_(pathBegin)
+        , pathEnd_(pathEnd)
+        , path_(pathEnd)
+    {
+    }
 };
 
-RAD_API component_iterator_win32 get_begin_win32(const char* path);
+constexpr component_iterator_win32 get_begin_win32(const char* path) noexcept
+{
+    return component_iterator_win32(path);
+}
 
-RAD_API component_iterator_win32 get_begin_win32(const std::string& path);
+inline component_iterator_win32 get_begin_win32(const std::string& path) noexcept
+{
+    return component_iterator_win32(path);
+}
 
-RAD_API component_iterator_win32 get_begin_win32(std::string_view path);
+constexpr component_iterator_win32 get_begin_win32(std::string_view path) noexcept
+{
+    return component_iterator_win32(path);
+}
 
-RAD_API component_iterator_win32 get_end_win32(const char* path);
+constexpr component_iterator_win32 get_end_win32(const char* path) noexcept
+{
+    // NOTE: We purposefully avoid computing the length of the path here;
+    // the end is found lazily if the returned iterator is ever decremented.
+    return component_iterator_win32(path, nullptr);
+}
 
-RAD_API component_iterator_win32 get_end_win32(const std::string& path);
+inline component_iterator_win32 get_end_win32(const std::string& path) noexcept
+{
+    return component_iterator_win32(path.c_str(), path.c_str() + path.size());
+}
 
-RAD_API component_iterator_win32 get_end_win32(std::string_view path);
+constexpr component_iterator_win32 get_end_win32(std::string_view path) noexcept
+{
+    return component_iterator_win32(path.data(), path.data() + path.size());
+}
 
 class component_iterators_win32
 {
@@ -123,29 +537,104 @@ class component_iterators_win32
     component_iterator_win32 end_;
 
 public:
-    inline component_iterator_win32 begin() const noexcept
+    constexpr component_iterator_win32 begin() const noexcept
     {
         return begin_;
     }
 
-    inline component_iterator_win32 end() const noexcept
+    constexpr component_iterator_win32 end() const noexcept
     {
         return end_;
     }
 
     constexpr component_iterators_win32() noexcept = default;
 
-    RAD_API component_iterators_win32(
+    constexpr component_iterators_win32(
         component_iterator_win32 begin,
-        component_iterator_win32 end
-    ) noexcept;
+        component_iterator_win32 end) noexcept
+        : begin_(begin)
+        , end_(end)
+    {
+    }
 };
 
-RAD_API component_iterators_win32 components_win32(const char* path);
+constexpr component_iterators_win32 components_win32(const char* path) noexcept
+{
+    return component_iterators_win32(
+        get_begin_win32(path),
+        get_end_win32(path)
+    );
+}
 
-RAD_API component_iterators_win32 components_win32(const std::string& path);
+inline component_iterators_win32 components_win32(const std::string& path) noexcept
+{
+    return component_iterators_win32(
+        get_begin_win32(path),
+        get_end_win32(path)
+    );
+}
+
+constexpr component_iterators_win32 components_win32(std::string_view path) noexcept
+{
+    return component_iterators_win32(
+        get_begin_win32(path),
+        get_end_win32(path)
+    );
+}
+
+/// @brief Splits the given path into its components in a single pass.
+///
+/// The resulting components are identical to those produced by components_win32.
+///
+/// @param path The path to split.
+/// @param components The buffer to write the components into. If it is too small
+/// to hold every component, only the first components.size() are written.
+/// @return The total number of components in path, which may be
+/// greater than the number of components actually written.
+RAD_API std::size_t split_components_win32(std::string_view path,
+    span<std::string_view> components) noexcept;
+
+inline std::size_t component_count_win32(std::string_view path) noexcept
+{
+    return split_components_win32(path, nullptr);
+}
 
-RAD_API component_iterators_win32 components_win32(std::string_view path);
+/// @brief Computes the longest sequence of leading components shared by both paths.
+///
+/// Components are compared as a whole, so the common prefix of "C:\a\bc" and "C:\a\b"
+/// is "C:\a\", not "C:\a\b". Like equals_win32_insensitive, the case of ASCII letters
+/// is ignored, and '/' and '\\' are treated as the same character. Paths are otherwise
+/// compared as-is; repeated separators, "." and ".." components are not normalized first.
+///
+/// @param path1 The first path to compare.
+/// @param path2 The second path to compare.
+/// @return The common prefix, as a view into path1. Like get_parent_win32, this
+/// includes the trailing separator if the paths differ after it.
+RAD_API std::string_view common_prefix_win32(std::string_view path1,
+    std::string_view path2) noexcept;
+
+/// @brief Computes the longest sequence of leading components shared by all of the
+/// given paths; see the two-path overload of common_prefix_win32 for details.
+/// @param paths The paths to compare.
+/// @return The common prefix, as a view into paths[0], or an empty view if paths is empty.
+RAD_API std::string_view common_prefix_win32(span<const std::string_view> paths) noexcept;
+
+/// @brief Computes a path which refers to the given target when appended to the given base.
+///
+/// For example, the relative path from "C:\a\b\c" to "C:\a\d" is "..\..\d". The base path
+/// is treated as a directory, and if both paths are equal, the result is ".".
+///
+/// @param from The base path.
+/// @param to The target path.
+/// @param result The string to store the relative path in; any existing
+/// contents are replaced, but its capacity is re-used if possible.
+/// @return true if a relative path could be computed, or false if there is no such
+/// path (e.g. if the given paths are on different drives or network shares, or if the
+/// base path has ".." components which are not shared with the target path), in which
+/// case, result is cleared.
+RAD_API bool relative_win32(std::string_view from, std::string_view to, std::string& result);
+
+RAD_API bool relative_win32(std::string_view from, std::string_view to, rad::string& result);
 }
 
 #endif
@@ -0,0 +1,227 @@
+/// @file rad_perf_counters.h
+/// @author Graham Scott
+/// @brief Header file providing rad::perf_counters, which reads hardware
+/// performance counters (cycles, cache misses, etc.) for named regions of code.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_PERF_COUNTERS_H_INCLUDED
+#define RAD_PERF_COUNTERS_H_INCLUDED
+
+#include "rad_base.h"
+#include "rad_span.h"
+#include "rad_vector.h"
+#include <string_view>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace rad
+{
+enum class perf_counter
+{
+    /// @brief The number of CPU cycles.
+    cycles,
+
+    /// @brief The number of retired instructions.
+    instructions,
+
+    /// @brief The number of last-level cache misses.
+    cache_misses,
+
+    /// @brief The number of mispredicted branch instructions.
+    branch_misses,
+
+    /// @brief The number of data TLB misses.
+    dtlb_misses
+};
+
+inline constexpr std::size_t perf_counter_count = 5;
+
+/// @brief Returns a short, human-readable name for the given counter (e.g. "cycles").
+RAD_API const char* get_perf_counter_name(perf_counter counter) noexcept;
+
+struct perf_counter_values
+{
+    std::uint64_t values[perf_counter_count] = {};
+
+    inline std::uint64_t& operator[](perf_counter counter) noexcept
+    {
+        return values[static_cast<std::size_t>(counter)];
+    }
+
+    inline std::uint64_t operator[](perf_counter counter) const noexcept
+    {
+        return values[static_cast<std::size_t>(counter)];
+    }
+
+    perf_counter_values& operator+=(const perf_counter_values& other) noexcept
+    {
+        for (std::size_t i = 0; i < perf_counter_count; ++i)
+        {
+            values[i] += other.values[i];
+        }
+
+        return *this;
+    }
+
+    perf_counter_values& operator-=(const perf_counter_values& other) noexcept
+    {
+        for (std::size_t i = 0; i < perf_counter_count; ++i)
+        {
+            // NOTE: Multiplexed counters are scaled estimates, so a later reading
+            // can occasionally be slightly lower than an earlier one; clamp to 0.
+            values[i] = (values[i] > other.values[i]) ? (values[i] - other.values[i]) : 0;
+        }
+
+        return *this;
+    }
+
+    friend inline perf_counter_values operator-(
+        perf_counter_values a, const perf_counter_values& b) noexcept
+    {
+        a -= b;
+        return a;
+    }
+};
+
+struct perf_region_stats
+{
+    /// @brief The name of the region.
+    const char*             name;
+
+    /// @brief The sum of all counter values measured within the region.
+    perf_counter_values     totals;
+
+    /// @brief The number of times the region has been entered.
+    std::uint64_t           count;
+};
+
+/// @brief A set of hardware performance counters for the calling thread.
+///
+/// The counters are opened when a perf_counters object is constructed, and are closed
+/// when it is destroyed. On Linux, they are read via perf_event_open; all other
+/// platforms are unsupported (see is_supported), and no counters are available.
+///
+/// Access to some (or all) counters may be denied (e.g. due to perf_event_paranoid,
+/// missing hardware support, or running within a virtual machine); in that case,
+/// is_available returns false for those counters, and they always read as 0.
+///
+/// Counters can be attributed to named regions of code via region():
+///
+///     rad::perf_counters counters;
+///
+///     {
+///         auto region = counters.region("parse");
+///         parse(...);
+///     }
+///
+///     counters.print_report();
+class perf_counters
+{
+    int                             fds_[perf_counter_count];
+    vector<perf_region_stats>       regions_;
+    std::size_t                     openRegionCount_ = 0;
+
+    RAD_API std::size_t get_region_index_(const char* name);
+
+public:
+    /// @brief An RAII object which attributes the counter values measured
+    /// between its construction and destruction to a named region.
+    class scoped_region
+    {
+        perf_counters*          counters_;
+        std::size_t             regionIndex_;
+        perf_counter_values     startValues_;
+
+    public:
+        scoped_region& operator=(const scoped_region& other) = delete;
+
+        scoped_region(perf_counters& counters, std::size_t regionIndex) noexcept
+            : counters_(&counters)
+            , regionIndex_(regionIndex)
+            , startValues_(counters.read())
+        {
+            ++counters_->openRegionCount_;
+        }
+
+        scoped_region(const scoped_region& other) = delete;
+
+        ~scoped_region()
+        {
+            const auto delta = (counters_->read() - startValues_);
+            auto& stats = counters_->regions_[regionIndex_];
+
+            stats.totals += delta;
+            ++stats.count;
+
+            --counters_->openRegionCount_;
+        }
+    };
+
+    /// @brief Returns whether hardware performance counters are supported on this
+    /// platform at all. If not, is_any_available always returns false.
+    RAD_API static bool is_supported() noexcept;
+
+    /// @brief Returns whether the given counter could be opened.
+    inline bool is_available(perf_counter counter) const noexcept
+    {
+        return (fds_[static_cast<std::size_t>(counter)] != -1);
+    }
+
+    /// @brief Returns whether at least one counter could be opened.
+    RAD_API bool is_any_available() const noexcept;
+
+    /// @brief Reads the current value of every counter.
+    ///
+    /// If the kernel had to multiplex counters (because more counters were requested than
+    /// the hardware supports at once), the values are scaled up to estimate the true counts.
+    ///
+    /// @return The current counter values; unavailable counters are always 0.
+    RAD_API perf_counter_values read() const noexcept;
+
+    /// @brief Begins measuring the region with the given name.
+    /// @param name The name of the region. NOTE: Only the pointer is stored,
+    /// so this must outlive this perf_counters object (e.g. a string literal).
+    /// @return An object which ends the region when it is destroyed.
+    inline scoped_region region(const char* name)
+    {
+        return scoped_region(*this, get_region_index_(name));
+    }
+
+    /// @brief Returns the stats of every region which has been measured so far.
+    inline span<const perf_region_stats> regions() const noexcept
+    {
+        return span<const perf_region_stats>(regions_.data(), regions_.size());
+    }
+
+    /// @brief Returns the stats of the region with the given name, or nullptr if
+    /// no region with the given name has been measured yet.
+    RAD_API const perf_region_stats* find_region(std::string_view name) const noexcept;
+
+    /// @brief Resets the stats of every region.
+    /// @pre No regions may currently be open (i.e. no scoped_regions may be alive),
+    /// as they refer to their regions by index.
+    inline void clear_regions() noexcept
+    {
+        assert(openRegionCount_ == 0 &&
+            "Cannot clear regions while a scoped_region is still alive");
+
+        regions_.clear();
+    }
+
+    /// @brief Prints a table containing the stats of every region to the given file.
+    RAD_API void print_report(std::FILE* file = stdout) const;
+
+    perf_counters& operator=(const perf_counters& other) = delete;
+
+    RAD_API perf_counters() noexcept;
+
+    perf_counters(const perf_counters& other) = delete;
+
+    RAD_API ~perf_counters();
+};
+}
+
+#endif
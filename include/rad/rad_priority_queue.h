@@ -0,0 +1,600 @@
+/// @file rad_priority_queue.h
+/// @author Graham Scott
+/// @brief Header file providing rad::priority_queue and rad::indexed_priority_queue,
+/// d-ary heaps stored within a rad::vector.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_PRIORITY_QUEUE_H_INCLUDED
+#define RAD_PRIORITY_QUEUE_H_INCLUDED
+
+#include "rad_base.h"
+#include "rad_vector.h"
+#include "rad_span.h"
+#include <functional>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace rad
+{
+namespace detail_
+{
+    /// @brief Moves the element at the given index up the heap until its parent is not
+    /// ordered before it, calling onMove(element, newIndex) for every element which moves.
+    template<std::size_t Arity, typename T, typename Compare, typename OnMove>
+    void heap_sift_up_(T* data, std::size_t index,
+        const Compare& compare, const OnMove& onMove)
+    {
+        T value = std::move(data[index]);
+
+        while (index > 0)
+        {
+            const auto parentIndex = ((index - 1) / Arity);
+            if (!compare(data[parentIndex], value))
+            {
+                break;
+            }
+
+            data[index] = std::move(data[parentIndex]);
+            onMove(data[index], index);
+            index = parentIndex;
+        }
+
+        data[index] = std::move(value);
+        onMove(data[index], index);
+    }
+
+    /// @brief Moves the element at the given index down the heap until none of its children
+    /// are ordered after it, calling onMove(element, newIndex) for every element which moves.
+    template<std::size_t Arity, typename T, typename Compare, typename OnMove>
+    void heap_sift_down_(T* data, std::size_t size, std::size_t index,
+        const Compare& compare, const OnMove& onMove)
+    {
+        T value = std::move(data[index]);
+
+        while (true)
+        {
+            // Find the child which should be closest to the top.
+            // NOTE: All of a node's children are stored next to each other, so with a
+            // 4-ary heap of small elements, they usually all share a single cache line.
+            const auto firstChildIndex = ((index * Arity) + 1);
+            if (firstChildIndex >= size)
+            {
+                break;
+            }
+
+            const auto endChildIndex = std::min<std::size_t>(firstChildIndex + Arity, size);
+            auto bestChildIndex = firstChildIndex;
+
+            for (auto i = (firstChildIndex + 1); i < endChildIndex; ++i)
+            {
+                if (compare(data[bestChildIndex], data[i]))
+                {
+                    bestChildIndex = i;
+                }
+            }
+
+            if (!compare(value, data[bestChildIndex]))
+            {
+                break;
+            }
+
+            data[index] = std::move(data[bestChildIndex]);
+            onMove(data[index], index);
+            index = bestChildIndex;
+        }
+
+        data[index] = std::move(value);
+        onMove(data[index], index);
+    }
+
+    /// @brief Turns the given range into a heap in O(n), by sifting
+    /// down every element which has children, from the bottom up.
+    template<std::size_t Arity, typename T, typename Compare, typename OnMove>
+    void make_heap_(T* data, std::size_t size,
+        const Compare& compare, const OnMove& onMove)
+    {
+        if (size < 2)
+        {
+            return;
+        }
+
+        for (auto i = (((size - 2) / Arity) + 1); i-- > 0;)
+        {
+            heap_sift_down_<Arity>(data, size, i, compare, onMove);
+        }
+    }
+
+    struct heap_no_op_on_move_
+    {
+        template<typename T>
+        constexpr void operator()(const T&, std::size_t) const noexcept
+        {
+        }
+    };
+}
+
+/// @brief A priority queue, implemented as a d-ary heap stored within a rad::vector.
+///
+/// Like std::priority_queue, top() returns the element which is ordered last by the
+/// given comparison function (so the largest element by default; use std::greater for
+/// a min-queue). Unlike std::priority_queue, each node has Arity children rather than 2,
+/// which halves the height of the heap (with the default Arity of 4), and keeps all of a
+/// node's children next to each other in memory.
+///
+/// @tparam T The type of elements stored within the queue.
+/// @tparam Compare The comparison function used to order elements.
+/// @tparam Arity The number of children each node within the heap has.
+/// @tparam Allocator The allocator used by the underlying vector.
+template<typename T, typename Compare = std::less<T>,
+    std::size_t Arity = 4, class Allocator = default_allocator<T>>
+class priority_queue
+{
+    static_assert(Arity >= 2, "rad::priority_queue requires an arity of at least 2");
+
+    Compare                 compare_;
+    vector<T, Allocator>    elements_;
+
+public:
+    using value_type        = T;
+    using value_compare     = Compare;
+    using allocator_type    = Allocator;
+    using size_type         = typename vector<T, Allocator>::size_type;
+    using const_reference   = const T&;
+
+    static constexpr std::size_t arity = Arity;
+
+    inline size_type size() const noexcept
+    {
+        return elements_.size();
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept
+    {
+        return elements_.empty();
+    }
+
+    /// @brief Returns every element within the queue, in heap order.
+    inline span<const T> elements() const noexcept
+    {
+        return span<const T>(elements_.data(), elements_.size());
+    }
+
+    /// @brief Returns the element at the top of the queue; the queue must not be empty.
+    inline const_reference top() const noexcept
+    {
+        assert(!empty() && "Cannot call top() on an empty priority queue");
+        return elements_.front();
+    }
+
+    inline void reserve(size_type count)
+    {
+        elements_.reserve(count);
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args)
+    {
+        elements_.emplace_back(std::forward<Args>(args)...);
+
+        detail_::heap_sift_up_<Arity>(elements_.data(), elements_.size() - 1,
+            compare_, detail_::heap_no_op_on_move_());
+    }
+
+    inline void push(const T& value)
+    {
+        emplace(value);
+    }
+
+    inline void push(T&& value)
+    {
+        emplace(std::move(value));
+    }
+
+    /// @brief Pushes every element within the given range onto the queue.
+    ///
+    /// If the range is at least as large as the queue already is, the whole heap is
+    /// rebuilt in O(n) afterwards, which is faster than pushing each element one-by-one.
+    ///
+    /// If copying an element (or advancing the iterator) throws, none of the elements
+    /// within the range are pushed, and the exception is propagated.
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last)
+    {
+        const auto oldSize = elements_.size();
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+            typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            elements_.reserve(oldSize + static_cast<size_type>(std::distance(first, last)));
+        }
+
+        try
+        {
+            for (; first != last; ++first)
+            {
+                elements_.emplace_back(*first);
+            }
+        }
+        catch (...)
+        {
+            // NOTE: Remove any elements which were appended, as they haven't been
+            // sifted into place yet, and would otherwise break the heap.
+            elements_.erase(elements_.begin() + oldSize, elements_.end());
+            throw;
+        }
+
+        const auto newSize = elements_.size();
+
+        if ((newSize - oldSize) >= oldSize)
+        {
+            detail_::make_heap_<Arity>(elements_.data(), newSize,
+                compare_, detail_::heap_no_op_on_move_());
+        }
+        else
+        {
+            for (auto i = oldSize; i < newSize; ++i)
+            {
+                detail_::heap_sift_up_<Arity>(elements_.data(), i,
+                    compare_, detail_::heap_no_op_on_move_());
+            }
+        }
+    }
+
+    /// @brief Removes the element at the top of the queue; the queue must not be empty.
+    void pop()
+    {
+        assert(!empty() && "Cannot call pop() on an empty priority queue");
+
+        const auto newSize = (elements_.size() - 1);
+
+        if (newSize != 0)
+        {
+            elements_.front() = std::move(elements_.back());
+        }
+
+        elements_.pop_back();
+
+        if (newSize > 1)
+        {
+            detail_::heap_sift_down_<Arity>(elements_.data(), newSize, 0,
+                compare_, detail_::heap_no_op_on_move_());
+        }
+    }
+
+    inline void clear() noexcept
+    {
+        elements_.clear();
+    }
+
+    priority_queue() = default;
+
+    explicit priority_queue(const Compare& compare)
+        : compare_(compare)
+    {
+    }
+
+    /// @brief Constructs a queue containing every element within the given range,
+    /// via a single O(n) heap construction.
+    template<typename InputIt>
+    priority_queue(InputIt first, InputIt last, const Compare& compare = Compare())
+        : compare_(compare)
+    {
+        push_range(first, last);
+    }
+};
+
+/// @brief A handle to an element within an indexed_priority_queue.
+class priority_queue_handle
+{
+    std::uint32_t value_ = invalid_value;
+
+public:
+    static constexpr std::uint32_t invalid_value = (std::numeric_limits<std::uint32_t>::max)();
+
+    inline constexpr std::uint32_t value() const noexcept
+    {
+        return value_;
+    }
+
+    inline constexpr bool is_valid() const noexcept
+    {
+        return (value_ != invalid_value);
+    }
+
+    inline constexpr bool operator==(priority_queue_handle other) const noexcept
+    {
+        return (value_ == other.value_);
+    }
+
+    inline constexpr bool operator!=(priority_queue_handle other) const noexcept
+    {
+        return (value_ != other.value_);
+    }
+
+    constexpr priority_queue_handle() noexcept = default;
+
+    inline constexpr explicit priority_queue_handle(std::uint32_t value) noexcept
+        : value_(value)
+    {
+    }
+};
+
+/// @brief A priority queue which hands out a handle for every element pushed onto it,
+/// which can later be used to change the element's priority, or to erase it, in
+/// O(log n) time; e.g. for Dijkstra's algorithm, or for timers which can be cancelled.
+///
+/// This avoids the "lazy deletion" work-around commonly used with std::priority_queue
+/// (pushing duplicate elements and skipping stale ones as they're popped), which can
+/// make the heap grow much larger than the number of elements which are actually live.
+///
+/// Handles stay valid until their element is popped or erased, after which
+/// they may be re-used by elements which are pushed afterwards.
+///
+/// @tparam T The type of elements stored within the queue.
+/// @tparam Compare The comparison function used to order elements; see priority_queue.
+/// @tparam Arity The number of children each node within the heap has.
+template<typename T, typename Compare = std::less<T>, std::size_t Arity = 4>
+class indexed_priority_queue
+{
+    static_assert(Arity >= 2, "rad::indexed_priority_queue requires an arity of at least 2");
+
+    struct entry_
+    {
+        T               value;
+        std::uint32_t   handle;
+    };
+
+    struct entry_compare_
+    {
+        const Compare& compare;
+
+        inline bool operator()(const entry_& a, const entry_& b) const
+        {
+            return compare(a.value, b.value);
+        }
+    };
+
+    struct on_move_
+    {
+        std::uint32_t* positions;
+
+        inline void operator()(const entry_& entry, std::size_t index) const noexcept
+        {
+            positions[entry.handle] = static_cast<std::uint32_t>(index);
+        }
+    };
+
+    static constexpr std::uint32_t free_position_ = (std::numeric_limits<std::uint32_t>::max)();
+
+    Compare                     compare_;
+    vector<entry_>              entries_;
+
+    /// @brief The position of every handle's entry within entries_, or free_position_.
+    vector<std::uint32_t>       positions_;
+    vector<std::uint32_t>       freeHandles_;
+
+    inline on_move_ on_move_callback_() noexcept
+    {
+        return on_move_{ positions_.data() };
+    }
+
+    void sift_up_(std::size_t index)
+    {
+        detail_::heap_sift_up_<Arity>(entries_.data(), index,
+            entry_compare_{ compare_ }, on_move_callback_());
+    }
+
+    void sift_down_(std::size_t index)
+    {
+        detail_::heap_sift_down_<Arity>(entries_.data(), entries_.size(), index,
+            entry_compare_{ compare_ }, on_move_callback_());
+    }
+
+    void erase_at_(std::size_t index)
+    {
+        // Free the erased entry's handle.
+        const auto handle = entries_.data()[index].handle;
+        freeHandles_.push_back(handle);
+        positions_.data()[handle] = free_position_;
+
+        // Move the last entry into the erased entry's place.
+        const auto newSize = (entries_.size() - 1);
+
+        if (index != newSize)
+        {
+            auto& entry = entries_.data()[index];
+            entry = std::move(entries_.back());
+            entries_.pop_back();
+
+            // The moved entry could belong either above or below its new position.
+            if (index > 0 && compare_(entries_.data()[(index - 1) / Arity].value, entry.value))
+            {
+                sift_up_(index);
+            }
+            else
+            {
+                sift_down_(index);
+            }
+        }
+        else
+        {
+            entries_.pop_back();
+        }
+    }
+
+    inline std::size_t get_position_(priority_queue_handle handle) const noexcept
+    {
+        assert(contains(handle) && "The given handle does not refer to an element");
+        return positions_.data()[handle.value()];
+    }
+
+public:
+    using value_type        = T;
+    using value_compare     = Compare;
+    using size_type         = std::size_t;
+    using const_reference   = const T&;
+    using handle            = priority_queue_handle;
+
+    static constexpr std::size_t arity = Arity;
+
+    inline size_type size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept
+    {
+        return entries_.empty();
+    }
+
+    /// @brief Returns whether the given handle refers to an element within the queue.
+    inline bool contains(priority_queue_handle handle) const noexcept
+    {
+        return (handle.value() < positions_.size() &&
+            positions_.data()[handle.value()] != free_position_);
+    }
+
+    /// @brief Returns the element at the top of the queue; the queue must not be empty.
+    inline const_reference top() const noexcept
+    {
+        assert(!empty() && "Cannot call top() on an empty priority queue");
+        return entries_.front().value;
+    }
+
+    /// @brief Returns the handle of the element at the top of the queue.
+    inline priority_queue_handle top_handle() const noexcept
+    {
+        assert(!empty() && "Cannot call top_handle() on an empty priority queue");
+        return priority_queue_handle(entries_.front().handle);
+    }
+
+    /// @brief Returns the element which the given handle refers to.
+    inline const_reference get(priority_queue_handle handle) const noexcept
+    {
+        return entries_.data()[get_position_(handle)].value;
+    }
+
+    void reserve(size_type count)
+    {
+        entries_.reserve(count);
+        positions_.reserve(count);
+    }
+
+    /// @brief Pushes the given element onto the queue.
+    /// @return A handle which refers to the pushed element.
+    template<typename... Args>
+    priority_queue_handle emplace(Args&&... args)
+    {
+        // Re-use a free handle if there is one, or create a new one otherwise.
+        const bool reusesHandle = !freeHandles_.empty();
+        std::uint32_t handle;
+
+        if (reusesHandle)
+        {
+            handle = freeHandles_.back();
+        }
+        else
+        {
+            assert(positions_.size() < free_position_ &&
+                "rad::indexed_priority_queue cannot hold any more handles");
+
+            handle = static_cast<std::uint32_t>(positions_.size());
+            positions_.push_back(free_position_);
+        }
+
+        // NOTE: We only take the free handle once the entry has been pushed, so
+        // that the handle isn't lost if constructing or pushing the entry throws.
+        entries_.push_back(entry_{ T(std::forward<Args>(args)...), handle });
+
+        if (reusesHandle)
+        {
+            freeHandles_.pop_back();
+        }
+
+        sift_up_(entries_.size() - 1);
+        return priority_queue_handle(handle);
+    }
+
+    inline priority_queue_handle push(const T& value)
+    {
+        return emplace(value);
+    }
+
+    inline priority_queue_handle push(T&& value)
+    {
+        return emplace(std::move(value));
+    }
+
+    /// @brief Removes the element at the top of the queue; the queue must not be empty.
+    inline void pop()
+    {
+        assert(!empty() && "Cannot call pop() on an empty priority queue");
+        erase_at_(0);
+    }
+
+    /// @brief Removes the element which the given handle refers to.
+    inline void erase(priority_queue_handle handle)
+    {
+        erase_at_(get_position_(handle));
+    }
+
+    /// @brief Replaces the element which the given handle refers to, and moves
+    /// it up or down the heap as necessary.
+    void update(priority_queue_handle handle, T value)
+    {
+        const auto index = get_position_(handle);
+        auto& entry = entries_.data()[index];
+        const bool movesUp = compare_(entry.value, value);
+
+        entry.value = std::move(value);
+
+        if (movesUp)
+        {
+            sift_up_(index);
+        }
+        else
+        {
+            sift_down_(index);
+        }
+    }
+
+    /// @brief Replaces the element which the given handle refers to with an element which
+    /// must not be ordered before it, and moves it up the heap as necessary.
+    ///
+    /// NOTE: This is named after the classic operation on min-queues (i.e. when Compare is
+    /// std::greater), as used by Dijkstra's algorithm, where the element's key decreases,
+    /// and it moves closer to the top of the queue.
+    void decrease_key(priority_queue_handle handle, T value)
+    {
+        const auto index = get_position_(handle);
+        auto& entry = entries_.data()[index];
+
+        assert(!compare_(value, entry.value) &&
+            "decrease_key cannot move an element further away from the top of the queue");
+
+        entry.value = std::move(value);
+        sift_up_(index);
+    }
+
+    void clear() noexcept
+    {
+        entries_.clear();
+        positions_.clear();
+        freeHandles_.clear();
+    }
+
+    indexed_priority_queue() = default;
+
+    explicit indexed_priority_queue(const Compare& compare)
+        : compare_(compare)
+    {
+    }
+};
+}
+
+#endif
@@ -47,6 +47,17 @@ public:
         return (prevRefCount == 1);
     }
 
+    /// @brief Atomically reads the current value of the reference counter.
+    ///
+    /// Unless the caller holds the only reference, other threads may add or
+    /// release references at any time, so the returned value may be stale.
+    /// In particular, a value of 1 while the caller holds a reference means
+    /// the caller's reference is the only one.
+    std::size_t get_ref_count() const noexcept
+    {
+        return refCount_.load(std::memory_order_acquire);
+    }
+
     /// @brief Constructs a new ref_count_object, with the
     /// reference counter set to 0.
     constexpr ref_count_object() noexcept
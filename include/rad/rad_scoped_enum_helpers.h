@@ -8,11 +8,21 @@
 #define RAD_SCOPED_ENUM_HELPERS_H_INCLUDED
 
 #include <type_traits>
+#include <cstddef>
 
 namespace rad
 {
 namespace detail_
 {
+    template<typename ScopedEnumType, typename = void>
+    struct enum_count_from_sentinel_ : std::integral_constant<std::size_t, 0> {};
+
+    template<typename ScopedEnumType>
+    struct enum_count_from_sentinel_<ScopedEnumType,
+        std::void_t<decltype(ScopedEnumType::count)>> :
+        std::integral_constant<std::size_t,
+            static_cast<std::size_t>(ScopedEnumType::count)> {};
+
     template<typename ScopedEnumType>
     class scoped_enum_bitwise_val
     {
@@ -38,6 +48,18 @@ namespace detail_
     };
 }
 
+/// @brief The number of values of the given scoped enum, whose values are
+/// expected to be sequential, starting from 0.
+///
+/// By default, this is the value of the enum's `count` enumerator, if it has one
+/// (e.g. `enum class color { red, green, blue, count };`). Otherwise, this trait
+/// can be specialized for the enum type.
+template<typename ScopedEnumType>
+struct enum_count : detail_::enum_count_from_sentinel_<ScopedEnumType> {};
+
+template<typename ScopedEnumType>
+inline constexpr std::size_t enum_count_v = enum_count<ScopedEnumType>::value;
+
 #define RAD_ENABLE_SCOPED_ENUM_BITWISE_OPS(scopedEnumType)\
     constexpr ::rad::detail_::scoped_enum_bitwise_val<scopedEnumType> operator&(\
         scopedEnumType a, scopedEnumType b) noexcept\
@@ -0,0 +1,476 @@
+/// @file rad_shared_buffer.h
+/// @author Graham Scott
+/// @brief Header file providing rad::shared_buffer, an immutable reference-counted
+/// block of bytes, and rad::buffer_slice, which references a sub-range of one.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_SHARED_BUFFER_H_INCLUDED
+#define RAD_SHARED_BUFFER_H_INCLUDED
+
+#include "rad_memory.h"
+#include "rad_ref_count_object.h"
+#include "rad_ref_count_ptr.h"
+#include "rad_vector.h"
+#include <string_view>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <new>
+#include <cstring>
+#include <cstddef>
+#include <cassert>
+
+namespace rad
+{
+/// @brief An immutable, reference-counted block of bytes.
+///
+/// The bytes are stored inline, directly after the reference counter and
+/// size, so creating a shared_buffer only requires a single allocation.
+/// shared_buffers are always owned via ref_count_ptr; use create to make one.
+class shared_buffer final : public ref_count_object
+{
+    std::size_t size_;
+
+    static constexpr std::size_t get_header_size_() noexcept
+    {
+        // NOTE: We round the header size up so that the data is default-aligned.
+        return ((sizeof(shared_buffer) + (default_alignment - 1)) &
+            ~(default_alignment - 1));
+    }
+
+    explicit shared_buffer(std::size_t size) noexcept
+        : size_(size)
+    {
+    }
+
+public:
+    inline const unsigned char* data() const noexcept
+    {
+        return (reinterpret_cast<const unsigned char*>(this) + get_header_size_());
+    }
+
+    inline std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// @brief Returns true if the caller holds the only reference to this buffer.
+    inline bool is_unique() const noexcept
+    {
+        return (get_ref_count() == 1);
+    }
+
+    /// @brief Returns a writable pointer to the buffer's data.
+    ///
+    /// This must only be used while the caller holds the only reference to the
+    /// buffer (e.g. to fill a buffer in right after it's been created), since
+    /// other references expect the data to never change.
+    inline unsigned char* mutable_data() noexcept
+    {
+        assert(is_unique() &&
+            "mutable_data() was called on a shared_buffer which is shared");
+
+        return (reinterpret_cast<unsigned char*>(this) + get_header_size_());
+    }
+
+    /// @brief Creates a new shared_buffer of the given size.
+    ///
+    /// The contents of the buffer are left uninitialized; fill them in
+    /// via mutable_data before sharing the buffer with anyone else.
+    ///
+    /// @param size The size of the buffer, in bytes.
+    /// @return A pointer to the new buffer.
+    static ref_count_ptr<shared_buffer> create(std::size_t size)
+    {
+        if (size > (std::numeric_limits<std::size_t>::max() - get_header_size_()))
+        {
+            throw std::bad_alloc();
+        }
+
+        void* const mem = RAD_ALLOC(get_header_size_() + size);
+        if (!mem)
+        {
+            throw std::bad_alloc();
+        }
+
+        return ref_count_ptr<shared_buffer>(new (mem) shared_buffer(size));
+    }
+
+    /// @brief Creates a new shared_buffer containing a copy of the given data.
+    /// @param data The data to copy into the new buffer.
+    /// @param size The size of data, in bytes.
+    /// @return A pointer to the new buffer.
+    static ref_count_ptr<shared_buffer> create(const void* data, std::size_t size)
+    {
+        auto buffer = create(size);
+
+        if (size)
+        {
+            std::memcpy(buffer->mutable_data(), data, size);
+        }
+
+        return buffer;
+    }
+
+    static void operator delete(void* ptr) noexcept
+    {
+        RAD_FREE(ptr);
+    }
+};
+
+class buffer_slice_list;
+
+/// @brief A view of a sub-range of a shared_buffer, which keeps the buffer alive.
+///
+/// Slicing a buffer_slice never copies any bytes; it just adds a reference to
+/// the underlying buffer, so many slices can share the same large payload.
+class buffer_slice
+{
+    friend buffer_slice_list;
+
+    ref_count_ptr<shared_buffer>    buffer_;
+    const unsigned char*            data_ = nullptr;
+    std::size_t                     size_ = 0;
+
+    buffer_slice(ref_count_ptr<shared_buffer> buffer,
+        const unsigned char* data, std::size_t size) noexcept
+        : buffer_(std::move(buffer))
+        , data_(data)
+        , size_(size)
+    {
+    }
+
+public:
+    using value_type = unsigned char;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_pointer = const unsigned char*;
+    using const_reference = const unsigned char&;
+    using const_iterator = const_pointer;
+    using iterator = const_iterator;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    inline const ref_count_ptr<shared_buffer>& buffer() const noexcept
+    {
+        return buffer_;
+    }
+
+    inline const_pointer data() const noexcept
+    {
+        return data_;
+    }
+
+    inline size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    inline const_iterator cbegin() const noexcept
+    {
+        return data_;
+    }
+
+    inline const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    inline const_iterator cend() const noexcept
+    {
+        return (data_ + size_);
+    }
+
+    inline const_iterator end() const noexcept
+    {
+        return (data_ + size_);
+    }
+
+    inline const_reference operator[](size_type index) const noexcept
+    {
+        assert(index < size_ && "The given index was outside of the slice's range");
+        return data_[index];
+    }
+
+    /// @brief Returns a view of this slice's bytes as characters.
+    inline std::string_view to_string_view() const noexcept
+    {
+        return std::string_view(reinterpret_cast<const char*>(data_), size_);
+    }
+
+    /// @brief Returns a slice of the given sub-range of this slice, which
+    /// shares the same underlying buffer. No bytes are copied.
+    /// @param offset The offset of the sub-range within this slice, in bytes.
+    /// @param count The size of the sub-range, in bytes. Clamped to the end of this slice.
+    buffer_slice substr(size_type offset, size_type count = npos) const
+    {
+        if (offset > size_)
+        {
+            throw std::out_of_range(
+                "The given offset was outside of the slice's range"
+            );
+        }
+
+        return buffer_slice(buffer_, data_ + offset,
+            std::min(count, size_ - offset));
+    }
+
+    inline void remove_prefix(size_type count) noexcept
+    {
+        assert(count <= size_ && "The given count was greater than the slice's size");
+
+        data_ += count;
+        size_ -= count;
+    }
+
+    inline void remove_suffix(size_type count) noexcept
+    {
+        assert(count <= size_ && "The given count was greater than the slice's size");
+
+        size_ -= count;
+    }
+
+    /// @brief Returns a writable pointer to this slice's bytes, first copying them
+    /// into a new buffer if the underlying buffer is shared with anyone else.
+    ///
+    /// The returned pointer is only valid until this slice is copied or modified.
+    unsigned char* get_mutable_data()
+    {
+        if (!buffer_ || !buffer_->is_unique())
+        {
+            *this = buffer_slice(shared_buffer::create(data_, size_));
+        }
+
+        // NOTE: This is safe, since we're the only ones referencing the buffer.
+        return const_cast<unsigned char*>(data_);
+    }
+
+    void reset() noexcept
+    {
+        buffer_.reset();
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    buffer_slice() noexcept = default;
+
+    /// @brief Creates a slice of the entirety of the given buffer.
+    buffer_slice(ref_count_ptr<shared_buffer> buffer) noexcept
+        : data_((buffer) ? buffer->data() : nullptr)
+        , size_((buffer) ? buffer->size() : 0)
+    {
+        buffer_ = std::move(buffer);
+    }
+
+    /// @brief Creates a slice of the given sub-range of the given buffer.
+    /// @param buffer The buffer to slice.
+    /// @param offset The offset of the sub-range within the buffer, in bytes.
+    /// @param count The size of the sub-range, in bytes. Clamped to the end of the buffer.
+    buffer_slice(ref_count_ptr<shared_buffer> buffer,
+        size_type offset, size_type count = npos)
+        : buffer_slice(std::move(buffer))
+    {
+        *this = substr(offset, count);
+    }
+};
+
+/// @brief An ordered list of buffer_slices, which can be treated as
+/// one logical sequence of bytes without copying them together.
+class buffer_slice_list
+{
+    vector<buffer_slice>    slices_;
+    std::size_t             size_ = 0;
+
+public:
+    using size_type = std::size_t;
+    using const_iterator = const buffer_slice*;
+    using iterator = const_iterator;
+
+    static constexpr size_type npos = buffer_slice::npos;
+
+    /// @brief Returns the total number of bytes within all slices in this list.
+    inline size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept
+    {
+        return (size_ == 0);
+    }
+
+    inline size_type slice_count() const noexcept
+    {
+        return slices_.size();
+    }
+
+    inline const_iterator begin() const noexcept
+    {
+        return slices_.begin();
+    }
+
+    inline const_iterator end() const noexcept
+    {
+        return slices_.end();
+    }
+
+    inline const buffer_slice& operator[](size_type index) const noexcept
+    {
+        return slices_[index];
+    }
+
+    /// @brief Appends the given slice to the end of this list.
+    ///
+    /// If the slice directly follows the last slice in this list within the same
+    /// buffer, the last slice is simply extended to cover it, so re-joining
+    /// adjacent pieces of the same payload doesn't make the list any longer.
+    void append(buffer_slice slice)
+    {
+        if (slice.empty())
+        {
+            return;
+        }
+
+        if (!slices_.empty())
+        {
+            auto& last = slices_[slices_.size() - 1];
+
+            if (last.buffer_ == slice.buffer_ && last.end() == slice.begin())
+            {
+                last.size_ += slice.size_;
+                size_ += slice.size_;
+                return;
+            }
+        }
+
+        size_ += slice.size_;
+        slices_.push_back(std::move(slice));
+    }
+
+    void append(const buffer_slice_list& other)
+    {
+        slices_.reserve(slices_.size() + other.slices_.size());
+
+        for (const auto& slice : other.slices_)
+        {
+            append(slice);
+        }
+    }
+
+    /// @brief Returns a list of slices covering the given sub-range of
+    /// this list's bytes. No bytes are copied.
+    /// @param offset The offset of the sub-range, in bytes.
+    /// @param count The size of the sub-range, in bytes. Clamped to the end of this list.
+    buffer_slice_list substr(size_type offset, size_type count = npos) const
+    {
+        if (offset > size_)
+        {
+            throw std::out_of_range(
+                "The given offset was outside of the list's range"
+            );
+        }
+
+        buffer_slice_list result;
+        count = std::min(count, size_ - offset);
+
+        for (const auto& slice : slices_)
+        {
+            if (count == 0)
+            {
+                break;
+            }
+
+            // Skip slices which end before the sub-range begins.
+            if (offset >= slice.size())
+            {
+                offset -= slice.size();
+                continue;
+            }
+
+            const auto sliceCount = std::min(count, slice.size() - offset);
+
+            result.append(slice.substr(offset, sliceCount));
+            count -= sliceCount;
+            offset = 0;
+        }
+
+        return result;
+    }
+
+    /// @brief Copies all of the bytes within this list into the given buffer.
+    /// @param dst The buffer to copy into. Must be at least size() bytes large.
+    void copy_to(void* dst) const noexcept
+    {
+        auto dstBytes = static_cast<unsigned char*>(dst);
+
+        for (const auto& slice : slices_)
+        {
+            std::memcpy(dstBytes, slice.data(), slice.size());
+            dstBytes += slice.size();
+        }
+    }
+
+    /// @brief Returns a single slice containing all of the bytes within this list.
+    ///
+    /// If this list consists of only one slice, that slice is returned directly,
+    /// without copying anything. Otherwise, the bytes are copied into a new buffer.
+    buffer_slice linearize() const
+    {
+        if (slices_.empty())
+        {
+            return buffer_slice();
+        }
+
+        if (slices_.size() == 1)
+        {
+            return slices_[0];
+        }
+
+        auto buffer = shared_buffer::create(size_);
+        copy_to(buffer->mutable_data());
+
+        return buffer_slice(std::move(buffer));
+    }
+
+    void clear() noexcept
+    {
+        slices_.clear();
+        size_ = 0;
+    }
+
+    buffer_slice_list() noexcept = default;
+
+    buffer_slice_list(buffer_slice_list&& other) noexcept
+        : slices_(std::move(other.slices_))
+        , size_(other.size_)
+    {
+        other.size_ = 0;
+    }
+
+    buffer_slice_list& operator=(buffer_slice_list&& other) noexcept
+    {
+        slices_ = std::move(other.slices_);
+        size_ = other.size_;
+        other.size_ = 0;
+
+        return *this;
+    }
+};
+
+/// @brief Joins the given slices into a buffer_slice_list without copying any bytes.
+inline buffer_slice_list concat(buffer_slice slice1, buffer_slice slice2)
+{
+    buffer_slice_list result;
+    result.append(std::move(slice1));
+    result.append(std::move(slice2));
+    return result;
+}
+}
+
+#endif
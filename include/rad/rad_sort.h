@@ -0,0 +1,476 @@
+/// @file rad_sort.h
+/// @author Graham Scott
+/// @brief Header file providing rad::radix_sort and rad::parallel_sort.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_SORT_H_INCLUDED
+#define RAD_SORT_H_INCLUDED
+
+#include "rad_base.h"
+#include "rad_span.h"
+#include "rad_vector.h"
+#include "rad_stack_or_heap_memory.h"
+#include <type_traits>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <climits>
+#include <cassert>
+
+namespace rad
+{
+namespace detail_
+{
+    /// @brief Ranges smaller than this are insertion sorted, rather than radix sorted.
+    constexpr std::size_t radix_sort_min_count_ = 64;
+
+    /// @brief Ranges of 32/64-bit keys at least this large are sorted with 11-bit digits,
+    /// which takes fewer passes, but needs histograms too large to be worth clearing
+    /// for smaller ranges.
+    constexpr std::size_t radix_sort_wide_digit_min_count_ = 65536;
+
+    /// @brief Ranges smaller than this are just sorted via std::sort, on the calling thread.
+    constexpr std::size_t parallel_sort_min_count_ = 65536;
+
+    constexpr std::size_t parallel_sort_buckets_per_thread_ = 4;
+    constexpr std::size_t parallel_sort_max_bucket_count_ = 1024;
+
+    /// @brief How many samples are taken per bucket when choosing splitters.
+    constexpr std::size_t parallel_sort_oversampling_ = 32;
+
+    constexpr std::size_t sort_stack_bytes_ = 1024;
+
+    struct radix_identity_key_
+    {
+        template<typename T>
+        constexpr const T& operator()(const T& value) const noexcept
+        {
+            return value;
+        }
+    };
+
+    /// @brief Maps the given key to an unsigned integer which sorts in the same order.
+    template<typename Key>
+    inline auto to_radix_bits_(Key key) noexcept
+    {
+        static_assert(std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool>,
+            "rad::radix_sort keys must be integers or floating-point numbers");
+
+        if constexpr (std::is_floating_point_v<Key>)
+        {
+            static_assert(std::numeric_limits<Key>::is_iec559 &&
+                (sizeof(Key) == 4 || sizeof(Key) == 8),
+                "rad::radix_sort only supports IEEE-754 floats and doubles");
+
+            using bits_t = std::conditional_t<sizeof(Key) == 4, std::uint32_t, std::uint64_t>;
+            constexpr bits_t signBit = (bits_t(1) << ((sizeof(bits_t) * CHAR_BIT) - 1));
+
+            bits_t bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+
+            // NOTE: Negative numbers have all of their bits flipped, so larger magnitudes
+            // sort first, while positive numbers just have their sign bit set, so that
+            // they sort after every negative number.
+            return static_cast<bits_t>((bits & signBit) ? ~bits : (bits | signBit));
+        }
+        else if constexpr (std::is_signed_v<Key>)
+        {
+            using bits_t = std::make_unsigned_t<Key>;
+            constexpr bits_t signBit = static_cast<bits_t>(
+                bits_t(1) << ((sizeof(bits_t) * CHAR_BIT) - 1));
+
+            // NOTE: Flipping the sign bit moves negative numbers before positive numbers.
+            return static_cast<bits_t>(static_cast<bits_t>(key) ^ signBit);
+        }
+        else
+        {
+            return key;
+        }
+    }
+
+    template<typename T, typename KeyFunc>
+    using radix_bits_t_ = decltype(to_radix_bits_(std::declval<std::decay_t<
+        std::invoke_result_t<KeyFunc&, const T&>>>()));
+
+    template<typename T, typename KeyFunc>
+    void radix_insertion_sort_(T* data, std::size_t count, KeyFunc& keyFunc)
+    {
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            const T value = data[i];
+            const auto bits = to_radix_bits_(keyFunc(value));
+            std::size_t j = i;
+
+            for (; j > 0 && bits < to_radix_bits_(keyFunc(data[j - 1])); --j)
+            {
+                data[j] = data[j - 1];
+            }
+
+            data[j] = value;
+        }
+    }
+
+    template<std::size_t DigitBits, typename T, typename KeyFunc>
+    void radix_sort_passes_(T* data, T* scratch, std::size_t count, KeyFunc& keyFunc)
+    {
+        using bits_t = radix_bits_t_<T, KeyFunc>;
+
+        constexpr std::size_t digitCount = (std::size_t(1) << DigitBits);
+        constexpr std::size_t passCount = (((sizeof(bits_t) * CHAR_BIT) + DigitBits - 1) / DigitBits);
+        constexpr bits_t digitMask = static_cast<bits_t>(digitCount - 1);
+
+        // Build the histograms for every pass at once, in a single read over the keys.
+        // NOTE: The histograms for 8-bit digits fit on the stack.
+        stack_or_heap_memory<sizeof(std::size_t) * 256 * 8, alignof(std::size_t)>
+            histogramMemory(sizeof(std::size_t) * digitCount * passCount);
+
+        const auto histograms = histogramMemory.template data<std::size_t>();
+        std::fill(histograms, histograms + (digitCount * passCount), std::size_t(0));
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto bits = to_radix_bits_(keyFunc(data[i]));
+
+            for (std::size_t pass = 0; pass < passCount; ++pass)
+            {
+                ++histograms[(pass * digitCount) +
+                    ((bits >> (pass * DigitBits)) & digitMask)];
+            }
+        }
+
+        // Scatter the elements by each digit, from least to most significant.
+        T* src = data;
+        T* dst = scratch;
+
+        for (std::size_t pass = 0; pass < passCount; ++pass)
+        {
+            const auto offsets = (histograms + (pass * digitCount));
+            const auto shift = (pass * DigitBits);
+
+            // Skip this pass entirely if every key shares the same digit
+            // (e.g. the upper bytes of small integers are usually all 0).
+            const auto firstDigit = ((to_radix_bits_(keyFunc(src[0])) >> shift) & digitMask);
+            if (offsets[firstDigit] == count)
+            {
+                continue;
+            }
+
+            std::size_t offset = 0;
+            for (std::size_t digit = 0; digit < digitCount; ++digit)
+            {
+                const auto digitSize = offsets[digit];
+                offsets[digit] = offset;
+                offset += digitSize;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto digit = ((to_radix_bits_(keyFunc(src[i])) >> shift) & digitMask);
+                dst[offsets[digit]++] = src[i];
+            }
+
+            std::swap(src, dst);
+        }
+
+        // NOTE: If an odd number of passes were performed, the result is in the scratch buffer.
+        if (src != data)
+        {
+            std::copy(src, src + count, data);
+        }
+    }
+
+    template<typename T, typename KeyFunc>
+    void radix_sort_(T* data, T* scratch, std::size_t count, KeyFunc& keyFunc)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "rad::radix_sort can only sort trivially-copyable types");
+
+        if (count < radix_sort_min_count_)
+        {
+            radix_insertion_sort_(data, count, keyFunc);
+            return;
+        }
+
+        if constexpr (sizeof(radix_bits_t_<T, KeyFunc>) >= 4)
+        {
+            if (count >= radix_sort_wide_digit_min_count_)
+            {
+                radix_sort_passes_<11>(data, scratch, count, keyFunc);
+                return;
+            }
+        }
+
+        radix_sort_passes_<8>(data, scratch, count, keyFunc);
+    }
+
+    using parallel_task_func_ = void (*)(void* userData, std::size_t taskIndex);
+
+    /// @brief Returns the number of hardware threads available (always at least 1).
+    RAD_API std::size_t get_hardware_thread_count_() noexcept;
+
+    /// @brief Runs func for every task index in [0, taskCount) across up to
+    /// threadCount threads (including the calling thread), and waits for them all.
+    ///
+    /// NOTE: Every task is run, even if some of them throw; the first exception
+    /// thrown is then re-thrown on the calling thread once every task has finished.
+    RAD_API void run_parallel_tasks_(std::size_t taskCount, std::size_t threadCount,
+        parallel_task_func_ func, void* userData);
+
+    template<typename Func>
+    inline void run_parallel_(std::size_t taskCount, std::size_t threadCount, Func& func)
+    {
+        run_parallel_tasks_(taskCount, threadCount, [](void* userData, std::size_t taskIndex)
+        {
+            (*static_cast<Func*>(userData))(taskIndex);
+        },
+        &func);
+    }
+}
+
+/// @brief Sorts the given elements by their keys via an LSD radix sort, which is stable.
+///
+/// Keys can be unsigned or signed integers, or floats/doubles (which are sorted by
+/// their IEEE-754 bit patterns, so -0.0 sorts before 0.0, and NaNs with the sign bit
+/// set/unset sort before/after every other number, respectively).
+///
+/// Every key's histograms are counted in a single pass over the data, after which
+/// each digit (8 bits, or 11 bits for large ranges of 32/64-bit keys) is scattered in
+/// a separate pass; any pass where every key shares the same digit is skipped.
+///
+/// @param data The elements to sort; must be trivially-copyable.
+/// @param scratch A buffer at least as large as data, used to hold elements between passes.
+/// @param keyFunc Returns the key to sort each element by; by default, the element itself.
+template<typename T, typename KeyFunc = detail_::radix_identity_key_>
+void radix_sort(span<T> data, span<T> scratch, KeyFunc keyFunc = KeyFunc())
+{
+    assert(scratch.size() >= data.size() &&
+        "The scratch buffer must be at least as large as the data being sorted");
+
+    detail_::radix_sort_(data.data(), scratch.data(), data.size(), keyFunc);
+}
+
+/// @brief Sorts the given elements by their keys via an LSD radix sort, which is stable.
+///
+/// This overload allocates the scratch buffer itself, via stack_or_heap_memory;
+/// see the other overload for details.
+///
+/// @param data The elements to sort; must be trivially-copyable.
+/// @param keyFunc Returns the key to sort each element by; by default, the element itself.
+template<typename T, typename KeyFunc = detail_::radix_identity_key_>
+void radix_sort(span<T> data, KeyFunc keyFunc = KeyFunc())
+{
+    // NOTE: Small ranges are insertion sorted in-place, so don't need a scratch buffer.
+    if (data.size() < detail_::radix_sort_min_count_)
+    {
+        detail_::radix_insertion_sort_(data.data(), data.size(), keyFunc);
+        return;
+    }
+
+    stack_or_heap_memory<detail_::sort_stack_bytes_, alignof(T)> scratch(
+        sizeof(T) * data.size());
+
+    detail_::radix_sort_(data.data(), scratch.template data<T>(), data.size(), keyFunc);
+}
+
+template<typename T, typename Allocator, typename KeyFunc = detail_::radix_identity_key_>
+inline void radix_sort(vector<T, Allocator>& data, KeyFunc keyFunc = KeyFunc())
+{
+    radix_sort(span<T>(data.data(), data.size()), std::move(keyFunc));
+}
+
+/// @brief Sorts the given elements across several threads, via a sample sort.
+///
+/// A sample of the elements is sorted to pick splitters, which divide the elements into
+/// several buckets (a few per thread). Each thread then classifies and counts the elements
+/// within its share of the range, after which the elements are moved into their buckets
+/// in parallel, and each bucket is sorted (via std::sort) and moved back in parallel.
+///
+/// NOTE: Threads are started for each call; small ranges (or a threadCount of 1)
+/// are just sorted via std::sort on the calling thread. The sort is not stable.
+///
+/// @param data The elements to sort; must be nothrow move-constructible.
+/// @param compare The comparison function to sort the elements with.
+/// @param threadCount The maximum number of threads to use, or 0 to use every hardware thread.
+template<typename T, typename Compare = std::less<>>
+void parallel_sort(span<T> data, Compare compare = Compare(), std::size_t threadCount = 0)
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+        "rad::parallel_sort can only sort nothrow move-constructible types");
+
+    const auto first = data.data();
+    const auto count = data.size();
+
+    if (threadCount == 0)
+    {
+        threadCount = detail_::get_hardware_thread_count_();
+    }
+
+    if (threadCount <= 1 || count < detail_::parallel_sort_min_count_)
+    {
+        std::sort(first, first + count, compare);
+        return;
+    }
+
+    const auto bucketCount = (std::min)(threadCount * detail_::parallel_sort_buckets_per_thread_,
+        detail_::parallel_sort_max_bucket_count_);
+
+    const auto chunkCount = threadCount;
+
+    // Pick splitters from a sorted sample of the elements.
+    // NOTE: We sample one (pseudo-randomly chosen) element from each of several
+    // evenly-sized strides, so that already-sorted input is sampled evenly.
+    const auto sampleCount = (bucketCount * detail_::parallel_sort_oversampling_);
+    const auto sampleStride = (count / sampleCount);
+
+    stack_or_heap_memory<detail_::sort_stack_bytes_, alignof(std::size_t)> sampleMemory(
+        sizeof(std::size_t) * sampleCount);
+
+    const auto sample = sampleMemory.template data<std::size_t>();
+
+    for (std::size_t i = 0; i < sampleCount; ++i)
+    {
+        const auto hash = static_cast<std::uint64_t>(i + 1) * 0x9E3779B97F4A7C15ull;
+        sample[i] = ((i * sampleStride) + static_cast<std::size_t>((hash >> 32) % sampleStride));
+    }
+
+    std::sort(sample, sample + sampleCount, [&](std::size_t a, std::size_t b)
+    {
+        return compare(first[a], first[b]);
+    });
+
+    const auto splitterCount = (bucketCount - 1);
+
+    stack_or_heap_memory<detail_::sort_stack_bytes_, alignof(const T*)> splitterMemory(
+        sizeof(const T*) * splitterCount);
+
+    const auto splitters = splitterMemory.template data<const T*>();
+
+    for (std::size_t i = 0; i < splitterCount; ++i)
+    {
+        splitters[i] = &first[sample[(i + 1) * detail_::parallel_sort_oversampling_]];
+    }
+
+    // Classify the elements into buckets, and count the size of each bucket within each chunk.
+    stack_or_heap_memory<detail_::sort_stack_bytes_, alignof(std::size_t)> histogramMemory(
+        sizeof(std::size_t) * ((chunkCount * bucketCount) + bucketCount + 1));
+
+    const auto histograms = histogramMemory.template data<std::size_t>();
+    const auto bucketStarts = (histograms + (chunkCount * bucketCount));
+
+    stack_or_heap_memory<detail_::sort_stack_bytes_, alignof(std::uint16_t)> bucketIndexMemory(
+        sizeof(std::uint16_t) * count);
+
+    const auto bucketIndices = bucketIndexMemory.template data<std::uint16_t>();
+
+    auto classifyChunk = [&](std::size_t chunk)
+    {
+        const auto chunkBegin = ((chunk * count) / chunkCount);
+        const auto chunkEnd = (((chunk + 1) * count) / chunkCount);
+        const auto histogram = (histograms + (chunk * bucketCount));
+
+        std::fill(histogram, histogram + bucketCount, std::size_t(0));
+
+        for (auto i = chunkBegin; i < chunkEnd; ++i)
+        {
+            const auto bucket = static_cast<std::size_t>(std::upper_bound(
+                splitters, splitters + splitterCount, first[i],
+                [&](const T& value, const T* splitter)
+                {
+                    return compare(value, *splitter);
+                }) - splitters);
+
+            bucketIndices[i] = static_cast<std::uint16_t>(bucket);
+            ++histogram[bucket];
+        }
+    };
+
+    detail_::run_parallel_(chunkCount, threadCount, classifyChunk);
+
+    // Turn the counts into the offset each chunk will write each of its buckets to.
+    std::size_t offset = 0;
+
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        bucketStarts[bucket] = offset;
+
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            auto& histogramEntry = histograms[(chunk * bucketCount) + bucket];
+            const auto chunkBucketSize = histogramEntry;
+
+            histogramEntry = offset;
+            offset += chunkBucketSize;
+        }
+    }
+
+    bucketStarts[bucketCount] = count;
+
+    // Move the elements into their buckets.
+    stack_or_heap_memory<detail_::sort_stack_bytes_, alignof(T)> scratchMemory(
+        sizeof(T) * count);
+
+    const auto scratch = scratchMemory.template data<T>();
+
+    auto scatterChunk = [&](std::size_t chunk)
+    {
+        const auto chunkBegin = ((chunk * count) / chunkCount);
+        const auto chunkEnd = (((chunk + 1) * count) / chunkCount);
+        const auto offsets = (histograms + (chunk * bucketCount));
+
+        for (auto i = chunkBegin; i < chunkEnd; ++i)
+        {
+            ::new (&scratch[offsets[bucketIndices[i]]++]) T(std::move(first[i]));
+        }
+    };
+
+    detail_::run_parallel_(chunkCount, threadCount, scatterChunk);
+
+    // Sort each bucket, and move it back into place.
+    auto sortBucket = [&](std::size_t bucket)
+    {
+        const auto bucketBegin = (scratch + bucketStarts[bucket]);
+        const auto bucketEnd = (scratch + bucketStarts[bucket + 1]);
+
+        auto moveBack = [&]()
+        {
+            std::move(bucketBegin, bucketEnd, first + bucketStarts[bucket]);
+
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (auto it = bucketBegin; it != bucketEnd; ++it)
+                {
+                    it->~T();
+                }
+            }
+        };
+
+        try
+        {
+            std::sort(bucketBegin, bucketEnd, compare);
+        }
+        catch (...)
+        {
+            moveBack();
+            throw;
+        }
+
+        moveBack();
+    };
+
+    detail_::run_parallel_(bucketCount, threadCount, sortBucket);
+}
+
+template<typename T, typename Allocator, typename Compare = std::less<>>
+inline void parallel_sort(vector<T, Allocator>& data,
+    Compare compare = Compare(), std::size_t threadCount = 0)
+{
+    parallel_sort(span<T>(data.data(), data.size()), std::move(compare), threadCount);
+}
+}
+
+#endif
@@ -0,0 +1,434 @@
+/// @file rad_sparse_set.h
+/// @author Graham Scott
+/// @brief Header file providing rad::sparse_set and rad::sparse_map, which store
+/// integer-keyed data densely packed in memory, with O(1) lookups by key.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_SPARSE_SET_H_INCLUDED
+#define RAD_SPARSE_SET_H_INCLUDED
+
+#include "rad_base.h"
+#include "rad_vector.h"
+#include "rad_memory_pool.h"
+#include "rad_span.h"
+#include <type_traits>
+#include <algorithm>
+#include <limits>
+#include <cstddef>
+#include <cassert>
+
+namespace rad
+{
+/// @brief A set of unsigned integers which are stored densely packed in memory.
+///
+/// A sparse_set is made up of two arrays: a dense array, which holds every key in the
+/// set back-to-back, and a sparse array, which maps each key to its position within
+/// the dense array. This makes insert, erase, and contains all O(1), while iterating
+/// over the set just streams through the dense array.
+///
+/// The sparse array is split into pages of PageSize entries, which are only allocated
+/// (from a dynamic_memory_pool owned by the set) once a key within them is inserted,
+/// so keys which are far apart don't cost memory for every key in-between.
+///
+/// NOTE: Erasing a key moves the last key in the dense array into its place, so the
+/// order of the dense array changes as keys are erased.
+///
+/// @tparam Index The type of keys stored within the set; must be an unsigned integer.
+/// @tparam PageSize The number of keys covered by each page; must be a power of 2.
+template<typename Index, std::size_t PageSize = 1024>
+class sparse_set
+{
+    static_assert(std::is_integral_v<Index> && std::is_unsigned_v<Index>,
+        "rad::sparse_set keys must be unsigned integers");
+
+    static_assert(PageSize != 0 && (PageSize & (PageSize - 1)) == 0,
+        "rad::sparse_set page sizes must be powers of 2");
+
+public:
+    using key_type          = Index;
+    using value_type        = Index;
+    using size_type         = std::size_t;
+    using iterator          = const Index*;
+    using const_iterator    = const Index*;
+
+    static constexpr size_type page_size = PageSize;
+
+    /// @brief The value returned by index_of if the given key is not within the set.
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    struct page_
+    {
+        /// @brief The position of each key within the dense array, or invalid_position_.
+        Index   positions[PageSize];
+    };
+
+    static constexpr Index invalid_position_ = (std::numeric_limits<Index>::max)();
+
+    // NOTE: Pages are fairly large, so we only allocate a few of them per block.
+    static constexpr std::size_t pages_per_block_ = 4;
+
+    vector<Index>                   dense_;
+    vector<page_*>                  pages_;
+    dynamic_memory_pool<page_>      pagePool_;
+
+    inline const page_* find_page_(Index key) const noexcept
+    {
+        const auto pageIndex = static_cast<std::size_t>(key / PageSize);
+        return (pageIndex < pages_.size()) ? pages_.data()[pageIndex] : nullptr;
+    }
+
+    inline page_* find_page_(Index key) noexcept
+    {
+        const auto pageIndex = static_cast<std::size_t>(key / PageSize);
+        return (pageIndex < pages_.size()) ? pages_.data()[pageIndex] : nullptr;
+    }
+
+    static inline Index& get_position_(page_* page, Index key) noexcept
+    {
+        return page->positions[key % PageSize];
+    }
+
+    page_& get_or_create_page_(Index key)
+    {
+        const auto pageIndex = static_cast<std::size_t>(key / PageSize);
+
+        if (pageIndex >= pages_.size())
+        {
+            pages_.reserve(pageIndex + 1);
+
+            while (pages_.size() <= pageIndex)
+            {
+                pages_.push_back(nullptr);
+            }
+        }
+
+        auto& page = pages_.data()[pageIndex];
+
+        if (!page)
+        {
+            // NOTE: The pool doesn't allocate any blocks until the first page is needed.
+            if (pagePool_.block_count() == 0)
+            {
+                pagePool_ = dynamic_memory_pool<page_>(pages_per_block_);
+            }
+
+            page = pagePool_.allocate();
+            std::fill(std::begin(page->positions),
+                std::end(page->positions), invalid_position_);
+        }
+
+        return *page;
+    }
+
+public:
+    inline size_type size() const noexcept
+    {
+        return dense_.size();
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept
+    {
+        return dense_.empty();
+    }
+
+    inline const Index* data() const noexcept
+    {
+        return dense_.data();
+    }
+
+    inline const_iterator begin() const noexcept
+    {
+        return dense_.begin();
+    }
+
+    inline const_iterator end() const noexcept
+    {
+        return dense_.end();
+    }
+
+    /// @brief Returns the number of sparse pages which have been allocated.
+    inline size_type page_count() const noexcept
+    {
+        size_type count = 0;
+
+        for (const auto page : pages_)
+        {
+            count += (page != nullptr);
+        }
+
+        return count;
+    }
+
+    /// @brief Returns the position of the given key within the dense array, or npos.
+    size_type index_of(Index key) const noexcept
+    {
+        const auto page = find_page_(key);
+        if (!page)
+        {
+            return npos;
+        }
+
+        const auto pos = page->positions[key % PageSize];
+        return (pos == invalid_position_) ? npos : static_cast<size_type>(pos);
+    }
+
+    inline bool contains(Index key) const noexcept
+    {
+        return (index_of(key) != npos);
+    }
+
+    /// @brief Reserves room for the given number of keys within the dense array.
+    inline void reserve(size_type count)
+    {
+        dense_.reserve(count);
+    }
+
+    /// @brief Inserts the given key into the set.
+    /// @param key The key to insert.
+    /// @return true if the key was inserted, or false if it was already within the set.
+    bool insert(Index key)
+    {
+        assert(dense_.size() < invalid_position_ &&
+            "rad::sparse_set cannot hold any more keys");
+
+        auto& pos = get_or_create_page_(key).positions[key % PageSize];
+        if (pos != invalid_position_)
+        {
+            return false;
+        }
+
+        dense_.push_back(key);
+        pos = static_cast<Index>(dense_.size() - 1);
+        return true;
+    }
+
+    /// @brief Erases the given key from the set, moving the last
+    /// key within the dense array into the erased key's position.
+    /// @param key The key to erase.
+    /// @return true if the key was erased, or false if it wasn't within the set.
+    bool erase(Index key) noexcept
+    {
+        const auto page = find_page_(key);
+        if (!page)
+        {
+            return false;
+        }
+
+        auto& pos = get_position_(page, key);
+        if (pos == invalid_position_)
+        {
+            return false;
+        }
+
+        // NOTE: If key is the last key, these both refer to the same
+        // entry, which correctly ends up as invalid_position_.
+        const auto lastKey = dense_.back();
+        dense_.data()[pos] = lastKey;
+        get_position_(find_page_(lastKey), lastKey) = pos;
+        pos = invalid_position_;
+
+        dense_.pop_back();
+        return true;
+    }
+
+    /// @brief Erases every key from the set.
+    ///
+    /// NOTE: This keeps the sparse pages around, so that
+    /// re-inserting the same keys doesn't allocate.
+    void clear() noexcept
+    {
+        for (const auto key : dense_)
+        {
+            get_position_(find_page_(key), key) = invalid_position_;
+        }
+
+        dense_.clear();
+    }
+
+    sparse_set() noexcept = default;
+};
+
+/// @brief A map from unsigned integers to values, which are stored densely packed in memory.
+///
+/// A sparse_map is a sparse_set of keys, plus a dense array of values which is kept in
+/// the same order as the set's dense array of keys; see sparse_set for details. Iterating
+/// over the map just streams through the values (and, optionally, the keys) in memory,
+/// which makes it well-suited to storing e.g. per-entity components.
+///
+/// NOTE: Erasing a key moves the last value into the erased value's place, so pointers
+/// to values (and the order of the values) are not stable as keys are erased.
+///
+/// @tparam Index The type of keys stored within the map; must be an unsigned integer.
+/// @tparam T The type of values stored within the map.
+/// @tparam PageSize The number of keys covered by each sparse page; must be a power of 2.
+template<typename Index, typename T, std::size_t PageSize = 1024>
+class sparse_map
+{
+    static_assert(std::is_nothrow_move_constructible_v<T> &&
+        std::is_nothrow_move_assignable_v<T>,
+        "rad::sparse_map values must be nothrow movable");
+
+    sparse_set<Index, PageSize>     keys_;
+    vector<T>                       values_;
+
+public:
+    using key_type          = Index;
+    using mapped_type       = T;
+    using size_type         = std::size_t;
+    using iterator          = T*;
+    using const_iterator    = const T*;
+
+    inline size_type size() const noexcept
+    {
+        return keys_.size();
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept
+    {
+        return keys_.empty();
+    }
+
+    /// @brief Returns every key within the map, in the same order as values().
+    inline span<const Index> keys() const noexcept
+    {
+        return span<const Index>(keys_.data(), keys_.size());
+    }
+
+    /// @brief Returns every value within the map, in the same order as keys().
+    inline span<const T> values() const noexcept
+    {
+        return span<const T>(values_.data(), values_.size());
+    }
+
+    inline span<T> values() noexcept
+    {
+        return span<T>(values_.data(), values_.size());
+    }
+
+    inline const_iterator begin() const noexcept
+    {
+        return values_.begin();
+    }
+
+    inline iterator begin() noexcept
+    {
+        return values_.begin();
+    }
+
+    inline const_iterator end() const noexcept
+    {
+        return values_.end();
+    }
+
+    inline iterator end() noexcept
+    {
+        return values_.end();
+    }
+
+    inline bool contains(Index key) const noexcept
+    {
+        return keys_.contains(key);
+    }
+
+    /// @brief Returns the value associated with the given key, or nullptr if there is none.
+    const T* find(Index key) const noexcept
+    {
+        const auto pos = keys_.index_of(key);
+        return (pos != keys_.npos) ? &values_.data()[pos] : nullptr;
+    }
+
+    T* find(Index key) noexcept
+    {
+        const auto pos = keys_.index_of(key);
+        return (pos != keys_.npos) ? &values_.data()[pos] : nullptr;
+    }
+
+    /// @brief Returns the value associated with the given key, which must be within the map.
+    inline const T& get(Index key) const noexcept
+    {
+        const auto value = find(key);
+        assert(value && "The given key is not within the map");
+        return *value;
+    }
+
+    inline T& get(Index key) noexcept
+    {
+        const auto value = find(key);
+        assert(value && "The given key is not within the map");
+        return *value;
+    }
+
+    /// @brief Reserves room for the given number of keys and values.
+    void reserve(size_type count)
+    {
+        keys_.reserve(count);
+        values_.reserve(count);
+    }
+
+    /// @brief Constructs a value associated with the given key, if the key isn't
+    /// already within the map. Otherwise, returns the existing value untouched.
+    template<typename... Args>
+    T& emplace(Index key, Args&&... args)
+    {
+        if (const auto value = find(key))
+        {
+            return *value;
+        }
+
+        // NOTE: We construct the value first, so that if its
+        // constructor throws, the key isn't left without a value.
+        auto& value = values_.emplace_back(std::forward<Args>(args)...);
+
+        try
+        {
+            keys_.insert(key);
+        }
+        catch (...)
+        {
+            values_.pop_back();
+            throw;
+        }
+
+        return value;
+    }
+
+    /// @brief Erases the given key and its value from the map, moving the
+    /// last value in the map into the erased value's position.
+    /// @param key The key to erase.
+    /// @return true if the key was erased, or false if it wasn't within the map.
+    bool erase(Index key) noexcept
+    {
+        const auto pos = keys_.index_of(key);
+        if (pos == keys_.npos)
+        {
+            return false;
+        }
+
+        // NOTE: sparse_set::erase moves the last key into the erased key's
+        // position, so we do the exact same thing with the values.
+        auto& value = values_.data()[pos];
+        auto& lastValue = values_.back();
+
+        if (&value != &lastValue)
+        {
+            value = std::move(lastValue);
+        }
+
+        values_.pop_back();
+        keys_.erase(key);
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        keys_.clear();
+        values_.clear();
+    }
+
+    sparse_map() noexcept = default;
+};
+}
+
+#endif
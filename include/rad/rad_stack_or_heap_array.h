@@ -10,6 +10,8 @@
 #include "rad_base.h"
 #include "rad_stack_or_heap_memory.h"
 #include "rad_object_utils.h"
+#include <memory>
+#include <type_traits>
 #include <cstddef>
 #include <utility>
 
@@ -102,6 +104,23 @@ public:
         count_ = count;
     }
 
+    /// @brief Replaces the contents of the array with the given number of elements,
+    /// without initializing them, for callers which are about to overwrite them anyway.
+    ///
+    /// NOTE: The elements hold indeterminate values until they're written to.
+    ///
+    /// @param count The new number of elements.
+    void assign_uninitialized(std::size_t count)
+    {
+        static_assert(std::is_trivially_default_constructible_v<T> &&
+            std::is_trivially_destructible_v<T>,
+            "assign_uninitialized can only be used with trivial types");
+
+        count_ = 0;
+        buffer_.reallocate(sizeof(T) * count, false);
+        count_ = count;
+    }
+
     // TODO: Add other overloads of assign.
 
     inline const T& operator[](std::size_t index) const
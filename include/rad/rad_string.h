@@ -0,0 +1,1007 @@
+/// @file rad_string.h
+/// @author Graham Scott
+/// @brief Header file providing rad::basic_string.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_STRING_H_INCLUDED
+#define RAD_STRING_H_INCLUDED
+
+#include "rad_base.h"
+#include "rad_pair.h"
+#include "rad_default_allocator.h"
+#include "rad_allocator_traits.h"
+#include <string_view>
+#include <string>
+#include <type_traits>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cstddef>
+#include <climits>
+#include <cassert>
+
+namespace rad
+{
+namespace detail_
+{
+    constexpr bool is_big_endian_target_ =
+    #if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+        __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        true;
+    #else
+        false;
+    #endif
+
+    template<typename T>
+    struct non_deduced_
+    {
+        using type = T;
+    };
+
+    // NOTE: Wrapping the view type like this stops it from taking part in template
+    // argument deduction, so that anything which is implicitly convertible to a
+    // string view (e.g. string literals) can be passed to the operators below.
+    template<typename CharT>
+    using string_view_arg_t_ = typename non_deduced_<std::basic_string_view<CharT>>::type;
+}
+
+/// @brief A null-terminated string which stores short strings inline, and
+/// grows longer strings via allocator_traits::reallocate.
+///
+/// Strings of up to small_capacity characters (23 chars on 64-bit targets)
+/// are stored within the string object itself, without allocating. Once a
+/// string outgrows that, it moves onto the heap, and from then on grows
+/// geometrically via allocator_traits::reallocate, which (since characters
+/// are trivially copyable) can often enlarge the buffer in-place via realloc.
+///
+/// @tparam CharT The type of characters stored within the string.
+/// @tparam Allocator The allocator used to allocate heap buffers. Heap buffers
+/// always hold (capacity() + 1) characters, to make room for the null-terminator.
+template<typename CharT, class Allocator = default_allocator<CharT>>
+class basic_string
+{
+    static_assert(std::is_trivially_copyable_v<CharT> &&
+        std::is_trivially_default_constructible_v<CharT>,
+        "rad::basic_string only supports trivial character types");
+
+    using allocator_traits_ = allocator_traits<Allocator>;
+    using size_type_        = typename allocator_traits_::size_type;
+    using char_traits_      = std::char_traits<CharT>;
+    using unsigned_char_t_  = std::make_unsigned_t<CharT>;
+    using view_type_        = std::basic_string_view<CharT>;
+
+    struct long_t_
+    {
+        CharT*      data;
+        size_type_  size;
+
+        // NOTE: This is the capacity, combined with a flag which marks the string as
+        // long. The flag is stored in whichever bits of the capacity overlap with the
+        // last character of the short string buffer; see long_capacity_flag_.
+        size_type_  capacityAndFlag;
+    };
+
+    static_assert((sizeof(long_t_) % sizeof(CharT)) == 0,
+        "rad::basic_string requires characters which evenly divide its storage");
+
+    static constexpr size_type_ small_capacity_ = ((sizeof(long_t_) / sizeof(CharT)) - 1);
+
+    /// @brief The storage used by the string.
+    ///
+    /// Short strings store (small_capacity_ - size) in their last character, so that
+    /// it doubles as the null-terminator once the short string is completely full.
+    /// Long strings set the long flag within capacityAndFlag instead, which forces the
+    /// last character above small_capacity_. This lets us tell the two apart without
+    /// spending any extra space on a separate flag.
+    struct storage_t_
+    {
+        // NOTE: This union is wrapped in a struct, as rad::pair
+        // may inherit from its members to compress them.
+        union
+        {
+            long_t_     l;
+            CharT       s[small_capacity_ + 1];
+        };
+    };
+
+    static_assert(sizeof(storage_t_) == sizeof(long_t_));
+
+    static constexpr size_type_ size_type_bit_count_ = (sizeof(size_type_) * CHAR_BIT);
+
+    // NOTE: On little-endian targets, the last character overlaps with the most
+    // significant bits of capacityAndFlag, so we set the top bit. On big-endian
+    // targets, it overlaps with the least significant bits instead, so we shift the
+    // capacity up by a byte and set the top bit of the lowest byte.
+    static constexpr size_type_ long_capacity_flag_ = (detail_::is_big_endian_target_) ?
+        size_type_(0x80) : (size_type_(1) << (size_type_bit_count_ - 1));
+
+    static constexpr size_type_ max_long_capacity_ = (detail_::is_big_endian_target_) ?
+        ((std::numeric_limits<size_type_>::max)() >> CHAR_BIT) :
+        (long_capacity_flag_ - 1);
+
+    pair<Allocator, storage_t_>    data_;
+
+    constexpr const Allocator& allocator_() const noexcept
+    {
+        return data_.first();
+    }
+
+    constexpr Allocator& allocator_() noexcept
+    {
+        return data_.first();
+    }
+
+    constexpr const storage_t_& storage_() const noexcept
+    {
+        return data_.second();
+    }
+
+    constexpr storage_t_& storage_() noexcept
+    {
+        return data_.second();
+    }
+
+    inline bool is_long_() const noexcept
+    {
+        return (static_cast<unsigned_char_t_>(storage_().s[small_capacity_]) >
+            small_capacity_);
+    }
+
+    static constexpr size_type_ encode_long_capacity_(size_type_ capacity) noexcept
+    {
+        return (detail_::is_big_endian_target_) ?
+            ((capacity << CHAR_BIT) | long_capacity_flag_) :
+            (capacity | long_capacity_flag_);
+    }
+
+    static constexpr size_type_ decode_long_capacity_(size_type_ capacityAndFlag) noexcept
+    {
+        return (detail_::is_big_endian_target_) ?
+            (capacityAndFlag >> CHAR_BIT) :
+            (capacityAndFlag & ~long_capacity_flag_);
+    }
+
+    inline void set_short_size_(size_type_ newSize) noexcept
+    {
+        auto& s = storage_().s;
+
+        // NOTE: If newSize == small_capacity_, both of these writes target
+        // the same character, which correctly ends up as the null-terminator.
+        s[newSize] = CharT();
+        s[small_capacity_] = static_cast<CharT>(small_capacity_ - newSize);
+    }
+
+    inline void set_size_(size_type_ newSize) noexcept
+    {
+        if (is_long_())
+        {
+            auto& l = storage_().l;
+            l.size = newSize;
+            l.data[newSize] = CharT();
+        }
+        else
+        {
+            set_short_size_(newSize);
+        }
+    }
+
+    inline void reset_() noexcept
+    {
+        set_short_size_(0);
+    }
+
+    void validate_range_(size_type_ index) const
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range(
+                "The given index was outside of the string's range"
+            );
+        }
+    }
+
+    void validate_position_(size_type_ pos) const
+    {
+        if (pos > size())
+        {
+            throw std::out_of_range(
+                "The given position was past the end of the string"
+            );
+        }
+    }
+
+    void validate_new_size_(size_type_ oldSize, size_type_ addedCount) const
+    {
+        if (addedCount > (max_size() - oldSize))
+        {
+            throw std::length_error(
+                "The resulting string would be longer than max_size()"
+            );
+        }
+    }
+
+    size_type_ compute_new_capacity_(size_type_ newDataCount) const noexcept
+    {
+        // If geometric growth would exceed max_size() and potentially
+        // overflow, we just return max_size() instead.
+        const auto bufCount = capacity();
+        const auto maxCount = max_size();
+
+        if (bufCount > (maxCount - (bufCount / 2)))
+        {
+            return maxCount;
+        }
+
+        // Attempt to geometrically grow from current capacity,
+        // falling back to newDataCount if the computed value is
+        // not sufficient.
+        return std::max<size_type_>(
+            bufCount + (bufCount / 2),
+            newDataCount
+        );
+    }
+
+    /// @brief Moves the string onto a heap buffer which can hold newCapacity characters.
+    /// @param newCapacity The new capacity; must be >= size() and > small_capacity_.
+    void reallocate_(size_type_ newCapacity)
+    {
+        auto& storage = storage_();
+
+        if (is_long_())
+        {
+            // NOTE: Since characters are trivially copyable, this can simply
+            // call realloc, which is often able to grow the buffer in-place.
+            auto& l = storage.l;
+            l.data = allocator_traits_::reallocate(
+                allocator_(),
+                l.data,
+                l.size + 1,
+                decode_long_capacity_(l.capacityAndFlag) + 1,
+                newCapacity + 1
+            );
+
+            l.capacityAndFlag = encode_long_capacity_(newCapacity);
+        }
+        else
+        {
+            const auto oldSize = size();
+            const auto newData = allocator_traits_::allocate(
+                allocator_(), newCapacity + 1);
+
+            char_traits_::copy(newData, storage.s, oldSize + 1);
+
+            storage.l.data = newData;
+            storage.l.size = oldSize;
+            storage.l.capacityAndFlag = encode_long_capacity_(newCapacity);
+        }
+    }
+
+    /// @brief Ensures the string can hold addedCount more characters.
+    void grow_by_(size_type_ oldSize, size_type_ addedCount)
+    {
+        if (addedCount > (capacity() - oldSize))
+        {
+            validate_new_size_(oldSize, addedCount);
+            reallocate_(compute_new_capacity_(oldSize + addedCount));
+        }
+    }
+
+    void destroy_data_() noexcept
+    {
+        if (is_long_())
+        {
+            auto& l = storage_().l;
+            allocator_traits_::deallocate(allocator_(), l.data,
+                decode_long_capacity_(l.capacityAndFlag) + 1);
+        }
+    }
+
+    void init_(const CharT* str, size_type_ count)
+    {
+        reset_();
+
+        if (count > small_capacity_)
+        {
+            validate_new_size_(0, count);
+            reallocate_(count);
+        }
+
+        char_traits_::copy(data(), str, count);
+        set_size_(count);
+    }
+
+    void init_(size_type_ count, CharT ch)
+    {
+        reset_();
+
+        if (count > small_capacity_)
+        {
+            validate_new_size_(0, count);
+            reallocate_(count);
+        }
+
+        char_traits_::assign(data(), count, ch);
+        set_size_(count);
+    }
+
+    inline bool is_within_(const CharT* str) const noexcept
+    {
+        // NOTE: We use std::less_equal to compare pointers which
+        // may point into entirely different objects.
+        const auto dataBegin = data();
+        return (std::less_equal<const CharT*>()(dataBegin, str) &&
+            std::less<const CharT*>()(str, dataBegin + size()));
+    }
+
+public:
+    using traits_type           = char_traits_;
+    using value_type            = CharT;
+    using allocator_type        = Allocator;
+    using size_type             = size_type_;
+    using difference_type       = typename allocator_traits_::difference_type;
+    using reference             = value_type&;
+    using const_reference       = const value_type&;
+    using pointer               = typename allocator_traits_::pointer;
+    using const_pointer         = typename allocator_traits_::const_pointer;
+    using iterator              = value_type*;
+    using const_iterator        = const value_type*;
+
+    /// @brief The maximum number of characters which can be stored without allocating.
+    static constexpr size_type small_capacity = small_capacity_;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    constexpr allocator_type get_allocator() const noexcept
+    {
+        return allocator_();
+    }
+
+    constexpr const allocator_type& allocator() const noexcept
+    {
+        return allocator_();
+    }
+
+    inline const CharT* data() const noexcept
+    {
+        const auto& storage = storage_();
+        return (is_long_()) ? storage.l.data : storage.s;
+    }
+
+    inline CharT* data() noexcept
+    {
+        auto& storage = storage_();
+        return (is_long_()) ? storage.l.data : storage.s;
+    }
+
+    inline const CharT* c_str() const noexcept
+    {
+        return data();
+    }
+
+    inline size_type size() const noexcept
+    {
+        const auto& storage = storage_();
+        return (is_long_()) ? storage.l.size : static_cast<size_type>(
+            small_capacity_ - static_cast<unsigned_char_t_>(storage.s[small_capacity_]));
+    }
+
+    inline size_type length() const noexcept
+    {
+        return size();
+    }
+
+    inline size_type capacity() const noexcept
+    {
+        return (is_long_()) ?
+            decode_long_capacity_(storage_().l.capacityAndFlag) :
+            small_capacity_;
+    }
+
+    constexpr size_type max_size() const noexcept
+    {
+        // The smallest of the following:
+        // - The maximum possible value of difference_type, minus one for the null-terminator
+        // - The maximum count of characters that can be allocated by allocator_traits_, minus one for the null-terminator
+        // - The largest capacity which can be stored alongside the long flag
+
+        return std::min<size_type>({
+            static_cast<size_type>((std::numeric_limits<difference_type>::max)() - 1),
+            static_cast<size_type>(allocator_traits_::max_size(allocator_()) - 1),
+            max_long_capacity_
+        });
+    }
+
+    [[nodiscard]] inline bool empty() const noexcept
+    {
+        return (size() == 0);
+    }
+
+    inline const_iterator cbegin() const noexcept
+    {
+        return data();
+    }
+
+    inline const_iterator begin() const noexcept
+    {
+        return data();
+    }
+
+    inline iterator begin() noexcept
+    {
+        return data();
+    }
+
+    inline const_iterator cend() const noexcept
+    {
+        return (data() + size());
+    }
+
+    inline const_iterator end() const noexcept
+    {
+        return (data() + size());
+    }
+
+    inline iterator end() noexcept
+    {
+        return (data() + size());
+    }
+
+    inline const_reference front() const noexcept
+    {
+        return *data();
+    }
+
+    inline reference front() noexcept
+    {
+        return *data();
+    }
+
+    inline const_reference back() const noexcept
+    {
+        return data()[size() - 1];
+    }
+
+    inline reference back() noexcept
+    {
+        return data()[size() - 1];
+    }
+
+    void reserve(size_type newCapacity)
+    {
+        if (newCapacity > capacity())
+        {
+            validate_new_size_(0, newCapacity);
+            reallocate_(newCapacity);
+        }
+    }
+
+    void resize(size_type newSize, CharT ch = CharT())
+    {
+        const auto oldSize = size();
+
+        if (newSize > oldSize)
+        {
+            grow_by_(oldSize, newSize - oldSize);
+            char_traits_::assign(data() + oldSize, newSize - oldSize, ch);
+        }
+
+        set_size_(newSize);
+    }
+
+    /// @brief Resizes the string without initializing any of the newly-added characters.
+    ///
+    /// This is useful for filling the string directly via data(), such as when
+    /// reading from a file or converting from another string, without paying for
+    /// characters which are just going to be overwritten anyway. The string is still
+    /// null-terminated, but the characters before the null-terminator hold
+    /// indeterminate values until they're written to.
+    ///
+    /// @param newSize The new size of the string.
+    void resize_uninitialized(size_type newSize)
+    {
+        const auto oldSize = size();
+
+        if (newSize > oldSize)
+        {
+            grow_by_(oldSize, newSize - oldSize);
+        }
+
+        set_size_(newSize);
+    }
+
+    void clear() noexcept
+    {
+        // NOTE: Unlike rad::vector::clear, this keeps the buffer
+        // around, so that the string's capacity can be re-used.
+        set_size_(0);
+    }
+
+    void push_back(CharT ch)
+    {
+        const auto oldSize = size();
+        grow_by_(oldSize, 1);
+
+        data()[oldSize] = ch;
+        set_size_(oldSize + 1);
+    }
+
+    inline void pop_back() noexcept
+    {
+        set_size_(size() - 1);
+    }
+
+    basic_string& append(const CharT* str, size_type count)
+    {
+        const auto oldSize = size();
+
+        if (count > (capacity() - oldSize))
+        {
+            // NOTE: str might point into our own buffer, which is
+            // about to move, so we have to find it again afterwards.
+            const bool isWithin = is_within_(str);
+            const auto offset = (isWithin) ?
+                static_cast<size_type>(str - data()) : 0;
+
+            grow_by_(oldSize, count);
+
+            if (isWithin)
+            {
+                str = (data() + offset);
+            }
+        }
+
+        char_traits_::copy(data() + oldSize, str, count);
+        set_size_(oldSize + count);
+        return *this;
+    }
+
+    inline basic_string& append(view_type_ str)
+    {
+        return append(str.data(), str.size());
+    }
+
+    inline basic_string& append(const CharT* str)
+    {
+        return append(str, char_traits_::length(str));
+    }
+
+    basic_string& append(size_type count, CharT ch)
+    {
+        const auto oldSize = size();
+        grow_by_(oldSize, count);
+
+        char_traits_::assign(data() + oldSize, count, ch);
+        set_size_(oldSize + count);
+        return *this;
+    }
+
+    basic_string& assign(const CharT* str, size_type count)
+    {
+        if (count > capacity())
+        {
+            // NOTE: We allocate the new buffer before freeing the old
+            // one, in case str points into our own buffer.
+            basic_string tmp(str, count, allocator_());
+            swap(tmp);
+        }
+        else
+        {
+            char_traits_::move(data(), str, count);
+            set_size_(count);
+        }
+
+        return *this;
+    }
+
+    inline basic_string& assign(view_type_ str)
+    {
+        return assign(str.data(), str.size());
+    }
+
+    inline basic_string& assign(const CharT* str)
+    {
+        return assign(str, char_traits_::length(str));
+    }
+
+    basic_string& insert(size_type index, const CharT* str, size_type count)
+    {
+        validate_position_(index);
+
+        // NOTE: We copy str into the end of the buffer first, and then rotate it
+        // into place, so that this works even if str points into our own buffer.
+        const auto oldSize = size();
+        append(str, count);
+
+        const auto dataBegin = data();
+        std::rotate(dataBegin + index, dataBegin + oldSize, dataBegin + oldSize + count);
+
+        return *this;
+    }
+
+    inline basic_string& insert(size_type index, view_type_ str)
+    {
+        return insert(index, str.data(), str.size());
+    }
+
+    basic_string& erase(size_type index = 0, size_type count = npos)
+    {
+        validate_position_(index);
+
+        const auto oldSize = size();
+        count = std::min<size_type>(count, oldSize - index);
+
+        const auto dataBegin = data();
+        char_traits_::move(dataBegin + index, dataBegin + index + count,
+            oldSize - index - count);
+
+        set_size_(oldSize - count);
+        return *this;
+    }
+
+    inline iterator erase(const_iterator pos)
+    {
+        const auto index = static_cast<size_type>(pos - data());
+        erase(index, 1);
+        return (data() + index);
+    }
+
+    inline basic_string& operator+=(CharT ch)
+    {
+        push_back(ch);
+        return *this;
+    }
+
+    inline basic_string& operator+=(view_type_ str)
+    {
+        return append(str);
+    }
+
+    inline basic_string& operator+=(const CharT* str)
+    {
+        return append(str);
+    }
+
+    inline basic_string& operator+=(const basic_string& str)
+    {
+        return append(str.data(), str.size());
+    }
+
+    int compare(view_type_ str) const noexcept
+    {
+        return view_type_(*this).compare(str);
+    }
+
+    /// @brief Releases ownership of the data buffer
+    /// to the caller and resets the string.
+    ///
+    /// After calling this function, it is the caller's responsibility to
+    /// deallocate the buffer (which holds (capacity + 1) characters) using the
+    /// allocator's deallocate function or equivalent, or to give it back to a
+    /// string via adopt().
+    ///
+    /// NOTE: Short strings do not have a heap buffer to release, so one is
+    /// allocated and the string is copied into it first.
+    ///
+    /// @param capacity If not null, set to the capacity of the returned buffer,
+    /// not counting the null-terminator.
+    /// @return pointer A pointer to the null-terminated data buffer, no longer owned by the string.
+    pointer release(size_type* capacity = nullptr)
+    {
+        if (!is_long_())
+        {
+            const auto oldSize = size();
+            const auto newData = allocator_traits_::allocate(
+                allocator_(), oldSize + 1);
+
+            char_traits_::copy(newData, storage_().s, oldSize + 1);
+
+            if (capacity)
+            {
+                *capacity = oldSize;
+            }
+
+            reset_();
+            return newData;
+        }
+
+        auto& l = storage_().l;
+        const auto dataBuf = l.data;
+
+        if (capacity)
+        {
+            *capacity = decode_long_capacity_(l.capacityAndFlag);
+        }
+
+        reset_();
+        return dataBuf;
+    }
+
+    /// @brief Takes ownership of the given data buffer, freeing the string's
+    /// previous buffer if necessary.
+    /// @param ptr The buffer to adopt. Must have been allocated via an allocator which
+    /// compares equal to this string's allocator, and must hold (capacity + 1) characters.
+    /// @param size The number of characters within the buffer which are part of the
+    /// string. The character at ptr[size] is overwritten with a null-terminator.
+    /// @param capacity The capacity of the buffer, not counting the null-terminator.
+    void adopt(pointer ptr, size_type size, size_type capacity) noexcept
+    {
+        assert(size <= capacity && capacity <= max_size() &&
+            "Cannot adopt a buffer which is smaller than the given size");
+
+        destroy_data_();
+
+        auto& l = storage_().l;
+        l.data = ptr;
+        l.size = size;
+        l.capacityAndFlag = encode_long_capacity_(capacity);
+
+        ptr[size] = CharT();
+    }
+
+    void swap(basic_string& other) noexcept
+    {
+        if constexpr (allocator_traits_::propagate_on_container_swap::value)
+        {
+            std::swap(data_, other.data_);
+        }
+        else
+        {
+            // NOTE: Just like with the standard containers, swapping strings whose
+            // allocators don't propagate on swap and don't compare equal is undefined.
+            assert(allocator_() == other.allocator_() &&
+                "Cannot swap strings whose allocators don't compare equal");
+
+            std::swap(storage_(), other.storage_());
+        }
+    }
+
+    inline const_reference operator[](size_type pos) const noexcept
+    {
+    #if RAD_USE_STRICT_BOUNDS_CHECKING == 1
+        validate_range_(pos);
+    #endif
+
+        return data()[pos];
+    }
+
+    inline reference operator[](size_type pos) noexcept
+    {
+    #if RAD_USE_STRICT_BOUNDS_CHECKING == 1
+        validate_range_(pos);
+    #endif
+
+        return data()[pos];
+    }
+
+    inline operator view_type_() const noexcept
+    {
+        return view_type_(data(), size());
+    }
+
+    basic_string& operator=(const basic_string& other)
+    {
+        if (&other != this)
+        {
+            if constexpr (allocator_traits_::propagate_on_container_copy_assignment::value)
+            {
+                // NOTE: Our buffer must be freed with the allocator which allocated it.
+                if (allocator_() != other.allocator_())
+                {
+                    destroy_data_();
+                    reset_();
+                }
+
+                allocator_() = other.allocator_();
+            }
+
+            assign(other.data(), other.size());
+        }
+
+        return *this;
+    }
+
+    basic_string& operator=(basic_string&& other) noexcept(
+        allocator_traits_::propagate_on_container_move_assignment::value ||
+        allocator_traits_::is_always_equal::value)
+    {
+        if (&other != this)
+        {
+            if constexpr (allocator_traits_::propagate_on_container_move_assignment::value)
+            {
+                destroy_data_();
+
+                data_ = std::move(other.data_);
+                other.reset_();
+            }
+            else
+            {
+                // NOTE: If the allocators don't compare equal, we can't take
+                // ownership of other's buffer, so we have to copy its data instead.
+                if (allocator_traits_::is_always_equal::value ||
+                    allocator_() == other.allocator_())
+                {
+                    destroy_data_();
+
+                    storage_() = other.storage_();
+                    other.reset_();
+                }
+                else
+                {
+                    assign(other.data(), other.size());
+                }
+            }
+        }
+
+        return *this;
+    }
+
+    inline basic_string& operator=(view_type_ str)
+    {
+        return assign(str);
+    }
+
+    inline basic_string& operator=(const CharT* str)
+    {
+        return assign(str);
+    }
+
+    basic_string()
+        noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+    {
+        reset_();
+    }
+
+    explicit basic_string(const Allocator& allocator)
+        noexcept(std::is_nothrow_copy_constructible_v<Allocator>)
+        : data_(allocator, {})
+    {
+        reset_();
+    }
+
+    basic_string(const CharT* str, size_type count,
+        const Allocator& allocator = Allocator())
+        : data_(allocator, {})
+    {
+        init_(str, count);
+    }
+
+    basic_string(const CharT* str, const Allocator& allocator = Allocator())
+        : data_(allocator, {})
+    {
+        init_(str, char_traits_::length(str));
+    }
+
+    explicit basic_string(view_type_ str, const Allocator& allocator = Allocator())
+        : data_(allocator, {})
+    {
+        init_(str.data(), str.size());
+    }
+
+    basic_string(size_type count, CharT ch, const Allocator& allocator = Allocator())
+        : data_(allocator, {})
+    {
+        init_(count, ch);
+    }
+
+    basic_string(const basic_string& other)
+        : data_(other.allocator_(), {})
+    {
+        init_(other.data(), other.size());
+    }
+
+    basic_string(basic_string&& other) noexcept
+        : data_(std::move(other.data_))
+    {
+        other.reset_();
+    }
+
+    inline ~basic_string()
+    {
+        destroy_data_();
+    }
+};
+
+template<typename CharT, class Allocator>
+inline bool operator==(const basic_string<CharT, Allocator>& a,
+    const basic_string<CharT, Allocator>& b) noexcept
+{
+    return (std::basic_string_view<CharT>(a) == std::basic_string_view<CharT>(b));
+}
+
+template<typename CharT, class Allocator>
+inline bool operator==(const basic_string<CharT, Allocator>& a,
+    detail_::string_view_arg_t_<CharT> b) noexcept
+{
+    return (std::basic_string_view<CharT>(a) == b);
+}
+
+template<typename CharT, class Allocator>
+inline bool operator==(detail_::string_view_arg_t_<CharT> a,
+    const basic_string<CharT, Allocator>& b) noexcept
+{
+    return (a == std::basic_string_view<CharT>(b));
+}
+
+template<typename CharT, class Allocator>
+inline bool operator!=(const basic_string<CharT, Allocator>& a,
+    const basic_string<CharT, Allocator>& b) noexcept
+{
+    return !(a == b);
+}
+
+template<typename CharT, class Allocator>
+inline bool operator!=(const basic_string<CharT, Allocator>& a,
+    detail_::string_view_arg_t_<CharT> b) noexcept
+{
+    return !(a == b);
+}
+
+template<typename CharT, class Allocator>
+inline bool operator!=(detail_::string_view_arg_t_<CharT> a,
+    const basic_string<CharT, Allocator>& b) noexcept
+{
+    return !(a == b);
+}
+
+template<typename CharT, class Allocator>
+inline bool operator<(const basic_string<CharT, Allocator>& a,
+    const basic_string<CharT, Allocator>& b) noexcept
+{
+    return (a.compare(b) < 0);
+}
+
+template<typename CharT, class Allocator>
+inline bool operator>(const basic_string<CharT, Allocator>& a,
+    const basic_string<CharT, Allocator>& b) noexcept
+{
+    return (a.compare(b) > 0);
+}
+
+template<typename CharT, class Allocator>
+inline bool operator<=(const basic_string<CharT, Allocator>& a,
+    const basic_string<CharT, Allocator>& b) noexcept
+{
+    return (a.compare(b) <= 0);
+}
+
+template<typename CharT, class Allocator>
+inline bool operator>=(const basic_string<CharT, Allocator>& a,
+    const basic_string<CharT, Allocator>& b) noexcept
+{
+    return (a.compare(b) >= 0);
+}
+
+template<typename CharT, class Allocator>
+basic_string<CharT, Allocator> operator+(basic_string<CharT, Allocator> a,
+    detail_::string_view_arg_t_<CharT> b)
+{
+    a.append(b);
+    return a;
+}
+
+template<typename CharT, class Allocator>
+inline void swap(basic_string<CharT, Allocator>& a,
+    basic_string<CharT, Allocator>& b) noexcept
+{
+    a.swap(b);
+}
+
+using string    = basic_string<char>;
+using wstring   = basic_string<wchar_t>;
+using u16string = basic_string<char16_t>;
+using u32string = basic_string<char32_t>;
+}
+
+template<typename CharT, class Allocator>
+struct std::hash<rad::basic_string<CharT, Allocator>>
+{
+    inline std::size_t operator()(
+        const rad::basic_string<CharT, Allocator>& str) const noexcept
+    {
+        return std::hash<std::basic_string_view<CharT>>()(str);
+    }
+};
+
+#endif
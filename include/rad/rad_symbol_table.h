@@ -0,0 +1,203 @@
+/// @file rad_symbol_table.h
+/// @author Graham Scott
+/// @brief Header file providing rad::symbol_table, which interns
+/// strings into 32-bit symbols that can be compared in O(1).
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_SYMBOL_TABLE_H_INCLUDED
+#define RAD_SYMBOL_TABLE_H_INCLUDED
+
+#include "rad_base.h"
+#include <string_view>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace rad
+{
+/// @brief A handle to a string which has been interned by a symbol_table.
+///
+/// Two symbols from the same table are equal if, and only if, the strings they were
+/// interned from are equal, so comparing and hashing them is just as cheap as comparing
+/// and hashing integers. Default-constructed symbols always refer to the empty string.
+class symbol
+{
+    std::uint32_t   value_ = 0;
+
+public:
+    constexpr std::uint32_t value() const noexcept
+    {
+        return value_;
+    }
+
+    /// @brief Returns whether this symbol refers to the empty string.
+    constexpr bool empty() const noexcept
+    {
+        return (value_ == 0);
+    }
+
+    constexpr bool operator==(symbol other) const noexcept
+    {
+        return (value_ == other.value_);
+    }
+
+    constexpr bool operator!=(symbol other) const noexcept
+    {
+        return (value_ != other.value_);
+    }
+
+    /// @brief Orders symbols by the order in which they were interned,
+    /// NOT by the strings they refer to.
+    constexpr bool operator<(symbol other) const noexcept
+    {
+        return (value_ < other.value_);
+    }
+
+    constexpr symbol() noexcept = default;
+
+    constexpr explicit symbol(std::uint32_t value) noexcept
+        : value_(value)
+    {
+    }
+};
+
+namespace detail_
+{
+    struct symbol_table_entry_
+    {
+        const char*     data;
+        std::size_t     size;
+    };
+
+    inline std::size_t find_last_set_(std::uint64_t bits) noexcept
+    {
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, bits);
+        return static_cast<std::size_t>(index);
+    #else
+        return static_cast<std::size_t>(63 - __builtin_clzll(bits));
+    #endif
+    }
+}
+
+/// @brief A thread-safe table which interns strings into 32-bit symbols.
+///
+/// Interning a string copies it into an arena owned by the table (unless an equal string
+/// has already been interned), and returns a symbol which refers to it. Interned strings
+/// are never moved or freed until the table is destroyed, so the views returned by
+/// get_view remain valid for the table's entire lifetime, and are always null-terminated.
+///
+/// The table is split into several shards, each with its own lock, arena, and hash
+/// index, so threads which intern different strings rarely contend with each other.
+/// Looking up strings which have already been interned never takes a lock, and looking
+/// up the string a symbol refers to is just an O(1) array access.
+///
+/// NOTE: When a shard's hash index grows, the old index can't be freed right away, as
+/// other threads may still be reading from it without a lock. Old indices are kept
+/// until the table is destroyed instead, which costs at most as much memory again as
+/// the current indices.
+class symbol_table
+{
+    struct shard_;
+
+    // NOTE: The entries are stored in pages which double in size, so that
+    // they never have to move, and can be read without taking a lock.
+    static constexpr std::size_t first_page_bit_count_ = 10;
+    static constexpr std::size_t page_count_ = (33 - first_page_bit_count_);
+
+    std::atomic<detail_::symbol_table_entry_*>  pages_[page_count_];
+    std::atomic<std::uint32_t>                  symbolCount_;
+    shard_*                                     shards_;
+
+    static inline std::size_t get_page_index_(std::uint64_t index) noexcept
+    {
+        return (detail_::find_last_set_(index) - first_page_bit_count_);
+    }
+
+    static inline std::size_t get_page_size_(std::size_t pageIndex) noexcept
+    {
+        return (std::size_t(1) << (pageIndex + first_page_bit_count_));
+    }
+
+    detail_::symbol_table_entry_& get_entry_(symbol sym) const noexcept
+    {
+        const auto index = (static_cast<std::uint64_t>(sym.value()) +
+            (std::uint64_t(1) << first_page_bit_count_));
+
+        const auto pageIndex = get_page_index_(index);
+        const auto page = pages_[pageIndex].load(std::memory_order_acquire);
+
+        return page[index - get_page_size_(pageIndex)];
+    }
+
+    detail_::symbol_table_entry_& create_entry_(symbol sym);
+
+    bool try_find_(shard_& shard, std::string_view str,
+        std::uint32_t hash, symbol& sym) const noexcept;
+
+public:
+    /// @brief Returns the symbol which refers to the given string, interning
+    /// a copy of the string first if it hasn't been interned yet.
+    /// @param str The string to intern.
+    /// @return The symbol which refers to the given string.
+    RAD_API symbol intern(std::string_view str);
+
+    /// @brief Looks up the symbol which refers to the given string, without interning it.
+    /// @param sym Set to the symbol which refers to the given string, if it was found.
+    /// @param str The string to look up.
+    /// @return true if the given string had already been interned, false otherwise.
+    RAD_API bool try_find(symbol& sym, std::string_view str) const noexcept;
+
+    /// @brief Returns the string which the given symbol refers to.
+    /// @param sym A symbol which was returned by this table.
+    /// @return A null-terminated view of the interned string, which
+    /// remains valid until this table is destroyed.
+    inline std::string_view get_view(symbol sym) const noexcept
+    {
+        const auto& entry = get_entry_(sym);
+        return std::string_view(entry.data, entry.size);
+    }
+
+    /// @brief Returns the null-terminated string which the given symbol refers to.
+    inline const char* c_str(symbol sym) const noexcept
+    {
+        return get_entry_(sym).data;
+    }
+
+    /// @brief Returns the number of symbols within this table, including the empty string.
+    /// NOTE: This may include symbols which are still being interned by other threads.
+    inline std::size_t size() const noexcept
+    {
+        return symbolCount_.load(std::memory_order_relaxed);
+    }
+
+    symbol_table& operator=(const symbol_table& other) = delete;
+
+    RAD_API symbol_table();
+
+    symbol_table(const symbol_table& other) = delete;
+
+    RAD_API ~symbol_table();
+};
+
+/// @brief Returns a symbol table which is shared by the entire program.
+RAD_API symbol_table& get_global_symbol_table();
+}
+
+template<>
+struct std::hash<rad::symbol>
+{
+    inline std::size_t operator()(rad::symbol sym) const noexcept
+    {
+        return static_cast<std::size_t>(sym.value());
+    }
+};
+
+#endif
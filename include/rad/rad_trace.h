@@ -0,0 +1,149 @@
+/// @file rad_trace.h
+/// @author Graham Scott
+/// @brief Header file providing lightweight scoped tracing zones,
+/// which can be exported to the Chrome trace event JSON format.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_TRACE_H_INCLUDED
+#define RAD_TRACE_H_INCLUDED
+
+#include "rad_base.h"
+#include <cstddef>
+#include <cstdint>
+
+#if RAD_USE_TRACING == 1
+    #include <atomic>
+#endif
+
+namespace rad::trace
+{
+#if RAD_USE_TRACING == 1
+namespace detail_
+{
+    RAD_API extern std::atomic<bool> isRecording_;
+
+    RAD_API extern std::atomic<bool> isRecordingAllocations_;
+
+    RAD_API std::uint64_t get_timestamp_() noexcept;
+
+    RAD_API void record_zone_(const char* name,
+        std::uint64_t startTimestamp, std::uint64_t endTimestamp) noexcept;
+
+    RAD_API void record_allocation_(std::ptrdiff_t countDelta, std::size_t size) noexcept;
+
+    class scoped_zone_
+    {
+        const char*     name_ = nullptr;
+        std::uint64_t   startTimestamp_;
+
+    public:
+        scoped_zone_& operator=(const scoped_zone_& other) = delete;
+
+        inline explicit scoped_zone_(const char* name) noexcept
+        {
+            if (isRecording_.load(std::memory_order_relaxed))
+            {
+                name_ = name;
+                startTimestamp_ = get_timestamp_();
+            }
+        }
+
+        scoped_zone_(const scoped_zone_& other) = delete;
+
+        inline ~scoped_zone_()
+        {
+            if (name_)
+            {
+                record_zone_(name_, startTimestamp_, get_timestamp_());
+            }
+        }
+    };
+}
+
+/// @brief Starts recording tracing zones on all threads.
+/// @param recordAllocations Whether calls to libRad's allocation functions
+/// (RAD_ALLOC, RAD_FREE, etc.) should also be recorded, as counters.
+RAD_API void start_recording(bool recordAllocations = false) noexcept;
+
+/// @brief Stops recording tracing zones. Previously-recorded events are kept.
+RAD_API void stop_recording() noexcept;
+
+inline bool is_recording() noexcept
+{
+    return detail_::isRecording_.load(std::memory_order_relaxed);
+}
+
+/// @brief Sets the name which is shown for the calling thread in trace viewers.
+/// @param name The name of the thread. Names longer than 63 characters are truncated.
+RAD_API void set_thread_name(const char* name) noexcept;
+
+/// @brief Discards all previously-recorded events on all threads.
+///
+/// NOTE: Must only be called while not recording.
+RAD_API void clear() noexcept;
+
+/// @brief Writes all recorded events to the given file in the Chrome trace event JSON
+/// format, which can be viewed via chrome://tracing or https://ui.perfetto.dev.
+///
+/// Each thread records events into its own fixed-size ring buffer, so only the
+/// most recent RAD_TRACE_EVENTS_PER_THREAD events of each thread are kept.
+/// The buffers of threads which have exited are kept until their events have been
+/// written out by this function (or discarded by clear()); only then can they be
+/// reused by new threads, after which their events are no longer available.
+///
+/// NOTE: Must only be called while not recording.
+///
+/// @param filePath The path of the file to write.
+/// @return true if the file was written successfully, false otherwise.
+RAD_API bool write_chrome_json(const char* filePath);
+
+#define RAD_TRACE_VAR_NAME2_(lineNumber) ZZZZ_trace_zone_from_line_##lineNumber##_
+#define RAD_TRACE_VAR_NAME1_(lineNumber) RAD_TRACE_VAR_NAME2_(lineNumber)
+
+/// @brief Records a tracing zone with the given name, spanning
+/// from this statement until the end of the enclosing scope.
+/// @param name The name of the zone. NOTE: Only the pointer is stored,
+/// so this must be a string with static storage duration (e.g. a literal).
+#define RAD_TRACE_SCOPE(name) const ::rad::trace::detail_::scoped_zone_\
+    RAD_TRACE_VAR_NAME1_(__LINE__)(name)
+
+#else
+// NOTE: Tracing is compiled out; these do nothing, so that
+// callers don't have to wrap every use of them in an #if.
+
+inline void start_recording(bool /* recordAllocations */ = false) noexcept
+{
+}
+
+inline void stop_recording() noexcept
+{
+}
+
+inline bool is_recording() noexcept
+{
+    return false;
+}
+
+inline void set_thread_name(const char* /* name */) noexcept
+{
+}
+
+inline void clear() noexcept
+{
+}
+
+inline bool write_chrome_json(const char* /* filePath */)
+{
+    return false;
+}
+
+#define RAD_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+/// @brief Records a tracing zone named after the enclosing function,
+/// spanning from this statement until the end of the enclosing scope.
+#define RAD_TRACE_FUNCTION() RAD_TRACE_SCOPE(__func__)
+}
+
+#endif
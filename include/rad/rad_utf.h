@@ -0,0 +1,134 @@
+/// @file rad_utf.h
+/// @author Graham Scott
+/// @brief Header file providing UTF-8 <-> UTF-16 transcoding utilities.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_UTF_H_INCLUDED
+#define RAD_UTF_H_INCLUDED
+
+#include "rad_base.h"
+#include "rad_stack_or_heap_array.h"
+#include <string_view>
+#include <system_error>
+#include <cstddef>
+
+namespace rad
+{
+/// @brief The value returned by the transcoding functions when the given input is invalid.
+inline constexpr std::size_t invalid_utf_length = static_cast<std::size_t>(-1);
+
+/// @brief Validates the given UTF-8 string and computes the exact
+/// number of UTF-16 code units required to represent it.
+/// @param src The UTF-8 string to validate.
+/// @return The number of UTF-16 code units required to represent src,
+/// or invalid_utf_length if src is not valid UTF-8.
+RAD_API std::size_t get_utf16_length_from_utf8(std::string_view src) noexcept;
+
+/// @brief Validates the given UTF-16 string and computes the exact
+/// number of UTF-8 code units required to represent it.
+/// @param src The UTF-16 string to validate.
+/// @return The number of UTF-8 code units required to represent src,
+/// or invalid_utf_length if src is not valid UTF-16.
+RAD_API std::size_t get_utf8_length_from_utf16(std::u16string_view src) noexcept;
+
+/// @brief Converts the given UTF-8 string to UTF-16.
+///
+/// The input is fully validated, but the output may have been partially
+/// written to by the time an error is detected.
+///
+/// @param src The UTF-8 string to convert.
+/// @param dst The buffer to write the converted string into. Must be large enough
+/// to hold get_utf16_length_from_utf8(src) code units; no null-terminator is written.
+/// @return The number of UTF-16 code units written to dst, or
+/// invalid_utf_length if src is not valid UTF-8.
+RAD_API std::size_t utf8_to_utf16(std::string_view src, char16_t* dst) noexcept;
+
+/// @brief Converts the given UTF-16 string to UTF-8.
+///
+/// The input is fully validated, but the output may have been partially
+/// written to by the time an error is detected.
+///
+/// @param src The UTF-16 string to convert.
+/// @param dst The buffer to write the converted string into. Must be large enough
+/// to hold get_utf8_length_from_utf16(src) code units; no null-terminator is written.
+/// @return The number of UTF-8 code units written to dst, or
+/// invalid_utf_length if src is not valid UTF-16.
+RAD_API std::size_t utf16_to_utf8(std::u16string_view src, char* dst) noexcept;
+
+/// @brief Converts the given UTF-8 string to a null-terminated UTF-16 string.
+/// @param src The UTF-8 string to convert.
+/// @param dst The array to store the converted string in. Its size
+/// will include the null-terminator.
+/// @return true if the conversion succeeded, or false if src is not valid
+/// UTF-8, in which case, dst is left empty.
+template<std::size_t MaxStackCount>
+bool try_utf8_to_utf16(std::string_view src,
+    stack_or_heap_array<char16_t, MaxStackCount>& dst)
+{
+    const auto len = get_utf16_length_from_utf8(src);
+    if (len == invalid_utf_length)
+    {
+        dst.clear();
+        return false;
+    }
+
+    // NOTE: The converted string overwrites every element but the null-terminator.
+    dst.assign_uninitialized(len + 1);
+    utf8_to_utf16(src, dst.data());
+    dst[len] = u'\0';
+    return true;
+}
+
+/// @brief Converts the given UTF-16 string to a null-terminated UTF-8 string.
+/// @param src The UTF-16 string to convert.
+/// @param dst The array to store the converted string in. Its size
+/// will include the null-terminator.
+/// @return true if the conversion succeeded, or false if src is not valid
+/// UTF-16, in which case, dst is left empty.
+template<std::size_t MaxStackCount>
+bool try_utf16_to_utf8(std::u16string_view src,
+    stack_or_heap_array<char, MaxStackCount>& dst)
+{
+    const auto len = get_utf8_length_from_utf16(src);
+    if (len == invalid_utf_length)
+    {
+        dst.clear();
+        return false;
+    }
+
+    // NOTE: The converted string overwrites every element but the null-terminator.
+    dst.assign_uninitialized(len + 1);
+    utf16_to_utf8(src, dst.data());
+    dst[len] = '\0';
+    return true;
+}
+
+/// @brief Like try_utf8_to_utf16, except a std::system_error is
+/// thrown if src is not valid UTF-8.
+template<std::size_t MaxStackCount>
+void utf8_to_utf16(std::string_view src,
+    stack_or_heap_array<char16_t, MaxStackCount>& dst)
+{
+    if (!try_utf8_to_utf16(src, dst))
+    {
+        throw std::system_error(std::make_error_code(
+            std::errc::illegal_byte_sequence));
+    }
+}
+
+/// @brief Like try_utf16_to_utf8, except a std::system_error is
+/// thrown if src is not valid UTF-16.
+template<std::size_t MaxStackCount>
+void utf16_to_utf8(std::u16string_view src,
+    stack_or_heap_array<char, MaxStackCount>& dst)
+{
+    if (!try_utf16_to_utf8(src, dst))
+    {
+        throw std::system_error(std::make_error_code(
+            std::errc::illegal_byte_sequence));
+    }
+}
+}
+
+#endif
@@ -11,10 +11,14 @@
 #include "rad_pair.h"
 #include "rad_default_allocator.h"
 #include "rad_allocator_traits.h"
+#include "rad_object_utils.h"
+#include "rad_span.h"
 #include <type_traits>
 #include <limits>
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <cassert>
 
 namespace rad
 {
@@ -141,6 +145,61 @@ class vector
         reallocate_(size(), capacity(), newCapacity);
     }
 
+    /// @brief Whether elements can be shifted around via memmove, rather than move-assignment.
+    static constexpr bool can_relocate_via_memmove_() noexcept
+    {
+        return is_trivially_relocatable_v<T>;
+    }
+
+    inline void destroy_(T* it) noexcept
+    {
+        if constexpr (must_call_allocator_destroy_on_elements_())
+        {
+            allocator_traits_::destroy(allocator_(), it);
+        }
+    }
+
+    void destroy_range_(T* first, T* last) noexcept
+    {
+        if constexpr (must_call_allocator_destroy_on_elements_())
+        {
+            for (; first != last; ++first)
+            {
+                allocator_traits_::destroy(allocator_(), first);
+            }
+        }
+    }
+
+    /// @brief Relocates the range [first, last) down to dst, which must not be after first.
+    static inline T* relocate_(T* first, T* last, T* dst) noexcept
+    {
+        const auto count = static_cast<std::size_t>(last - first);
+
+        if (dst == first)
+        {
+            return last;
+        }
+
+        // NOTE: Short runs are copied element-by-element, which the compiler can inline;
+        // this is much faster than calling memmove when e.g. every other element is erased.
+        // This is safe even though the ranges may overlap, since dst is before first.
+        if (count < 16)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::memcpy(static_cast<void*>(dst + i),
+                    static_cast<const void*>(first + i), sizeof(T));
+            }
+        }
+        else
+        {
+            std::memmove(static_cast<void*>(dst),
+                static_cast<const void*>(first), sizeof(T) * count);
+        }
+
+        return (dst + count);
+    }
+
     void destroy_data_()
     {
         // Destruct elements if necessary.
@@ -253,6 +312,26 @@ public:
         return values_().dataEnd;
     }
 
+    inline const_reference front() const noexcept
+    {
+        return *begin();
+    }
+
+    inline reference front() noexcept
+    {
+        return *begin();
+    }
+
+    inline const_reference back() const noexcept
+    {
+        return *(end() - 1);
+    }
+
+    inline reference back() noexcept
+    {
+        return *(end() - 1);
+    }
+
     void reserve(size_type newCapacity)
     {
         const auto oldCapacity = capacity();
@@ -291,25 +370,213 @@ public:
         return emplace_back(std::move(val));
     }
 
+    void pop_back() noexcept
+    {
+        auto& v = values_();
+        --v.dataEnd;
+
+        destroy_(v.dataEnd);
+    }
+
     iterator erase(const_iterator pos)
     {
-        const auto it = move_strong(
-            const_cast<iterator>(pos + 1),
-            end(),
-            const_cast<iterator>(pos)
-        );
+        const auto dst = const_cast<iterator>(pos);
 
-        if constexpr (must_call_allocator_destroy_on_elements_())
+        if constexpr (can_relocate_via_memmove_())
         {
-            allocator_traits_::destroy(allocator_(), it);
+            destroy_(dst);
+            values_().dataEnd = relocate_(dst + 1, end(), dst);
+        }
+        else
+        {
+            const auto it = move_strong(dst + 1, end(), dst);
+
+            destroy_(it);
+            values_().dataEnd = it;
         }
 
-        values_().dataEnd = it;
-        
-        return const_cast<iterator>(pos);
+        return dst;
     }
 
-    // TODO: Range erase
+    /// @brief Erases every element within the given range, shifting every later
+    /// element down only once.
+    /// @return An iterator to the element which followed the erased range.
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const auto dst = const_cast<iterator>(first);
+        const auto src = const_cast<iterator>(last);
+
+        if (dst == src)
+        {
+            return dst;
+        }
+
+        if constexpr (can_relocate_via_memmove_())
+        {
+            destroy_range_(dst, src);
+            values_().dataEnd = relocate_(src, end(), dst);
+        }
+        else
+        {
+            const auto it = move_strong(src, end(), dst);
+
+            destroy_range_(it, end());
+            values_().dataEnd = it;
+        }
+
+        return dst;
+    }
+
+    /// @brief Erases the given element by moving the last element into its place,
+    /// which is O(1), but does not preserve the order of the elements.
+    /// @return An iterator to the element which was moved into the erased element's place.
+    iterator erase_unordered(const_iterator pos) noexcept(
+        std::is_nothrow_move_assignable_v<T> || is_trivially_relocatable_v<T>)
+    {
+        const auto dst = const_cast<iterator>(pos);
+        auto& v = values_();
+        const auto last = (v.dataEnd - 1);
+
+        if constexpr (can_relocate_via_memmove_())
+        {
+            destroy_(dst);
+
+            if (dst != last)
+            {
+                std::memcpy(static_cast<void*>(dst),
+                    static_cast<const void*>(last), sizeof(T));
+            }
+
+            v.dataEnd = last;
+        }
+        else
+        {
+            if (dst != last)
+            {
+                *dst = std::move(*last);
+            }
+
+            pop_back();
+        }
+
+        return dst;
+    }
+
+    /// @brief Moves every element for which pred returns false to the front
+    /// of the vector (preserving their order), in a single pass.
+    ///
+    /// Like std::remove_if, this doesn't change the size of the vector; the elements
+    /// from the returned iterator to end() are left in a valid but unspecified state,
+    /// and can be erased via erase(it, end()). Prefer erase_if, which does both.
+    ///
+    /// @return An iterator to the new logical end of the vector.
+    template<typename Predicate>
+    iterator remove_if(Predicate pred)
+    {
+        return std::remove_if(begin(), end(), pred);
+    }
+
+    /// @brief Erases every element for which pred returns true in a single pass,
+    /// preserving the order of the remaining elements.
+    ///
+    /// If T is trivially relocatable (but not trivially copyable), runs of remaining elements
+    /// are relocated via memmove, rather than being move-assigned and then destructed.
+    ///
+    /// @return The number of elements which were erased.
+    template<typename Predicate>
+    size_type erase_if(Predicate pred)
+    {
+        const auto oldSize = size();
+
+        // NOTE: Move-assigning trivially-copyable types already just copies their bytes,
+        // which is faster than tracking runs of elements to relocate, so we only relocate
+        // types which are trivially relocatable, but which have non-trivial moves.
+        if constexpr (can_relocate_via_memmove_() && !std::is_trivially_copyable_v<T>)
+        {
+            auto& v = values_();
+            const auto last = v.dataEnd;
+
+            auto dst = v.dataBegin;
+
+            // NOTE: This is the start of the run of elements being kept,
+            // which is only shifted down once the run has ended.
+            auto runBegin = v.dataBegin;
+
+            try
+            {
+                for (auto src = v.dataBegin; src != last; ++src)
+                {
+                    if (pred(*src))
+                    {
+                        dst = relocate_(runBegin, src, dst);
+                        destroy_(src);
+                        runBegin = (src + 1);
+                    }
+                }
+            }
+            catch (...)
+            {
+                // NOTE: If pred throws, we keep every element it wasn't
+                // called on yet, so that the vector is left contiguous.
+                v.dataEnd = relocate_(runBegin, last, dst);
+                throw;
+            }
+
+            v.dataEnd = relocate_(runBegin, last, dst);
+        }
+        else
+        {
+            erase(remove_if(std::move(pred)), end());
+        }
+
+        return (oldSize - size());
+    }
+
+    /// @brief Erases the elements at every given index in a single pass,
+    /// preserving the order of the remaining elements.
+    /// @param indices The indices of the elements to erase; must be sorted,
+    /// without duplicates, and every index must be less than size().
+    /// @return The number of elements which were erased.
+    size_type erase_indices(span<const size_type> indices)
+    {
+        const auto indexCount = indices.size();
+        if (indexCount == 0)
+        {
+            return 0;
+        }
+
+        const auto first = data();
+        const auto count = size();
+        auto dst = (first + indices.data()[0]);
+
+        for (size_type i = 0; i < indexCount; ++i)
+        {
+            const auto index = indices.data()[i];
+            const auto nextIndex = ((i + 1) < indexCount) ? indices.data()[i + 1] : count;
+
+            assert(index < count && "The given indices must be within the vector's range");
+            assert(index < nextIndex && "The given indices must be sorted and unique");
+
+            // Shift the run of elements between this index and the next one down.
+            if constexpr (can_relocate_via_memmove_())
+            {
+                destroy_(first + index);
+                dst = relocate_(first + index + 1, first + nextIndex, dst);
+            }
+            else
+            {
+                dst = move_strong(first + index + 1, first + nextIndex, dst);
+            }
+        }
+
+        if constexpr (!can_relocate_via_memmove_())
+        {
+            destroy_range_(dst, end());
+        }
+
+        values_().dataEnd = dst;
+        return indexCount;
+    }
 
     void clear() noexcept
     {
@@ -360,7 +627,7 @@ public:
         {
             destroy_data_();
 
-            data_ = std::move(data_);
+            data_ = std::move(other.data_);
             other.values_().reset();
         }
 
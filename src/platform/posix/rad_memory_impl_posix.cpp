@@ -12,22 +12,24 @@ namespace rad::detail_
 {
 void* allocate_(std::size_t size) noexcept
 {
-    return std::malloc(size);
+    return on_allocate_(std::malloc(size), size);
 }
 
 void* reallocate_(void* ptr, std::size_t size) noexcept
 {
-    return std::realloc(ptr, size);
+    const bool isNewAllocation = !ptr;
+    return on_reallocate_(isNewAllocation, std::realloc(ptr, size), size);
 }
 
 void free_(void* ptr) noexcept
 {
+    on_free_(ptr);
     std::free(ptr);
 }
 
 void* allocate_aligned_(std::size_t size, std::size_t alignment) noexcept
 {
-    return std::aligned_alloc(alignment, size);
+    return on_allocate_(std::aligned_alloc(alignment, size), size);
 }
 
 void* reallocate_aligned_(void* ptr, std::size_t size, std::size_t alignment) noexcept
@@ -37,6 +39,7 @@ void* reallocate_aligned_(void* ptr, std::size_t size, std::size_t alignment) no
 
 void free_aligned_(void* ptr) noexcept
 {
+    on_free_(ptr);
     std::free(ptr);
 }
 
@@ -44,18 +47,20 @@ void free_aligned_(void* ptr) noexcept
     void* allocate_debug_(std::size_t size,
         debug_memory_alloc_info allocInfo) noexcept
     {
-        return std::malloc(size);
+        return on_allocate_(std::malloc(size), size);
     }
 
     void* reallocate_debug_(
         void* ptr, std::size_t size,
         debug_memory_alloc_info allocInfo) noexcept
     {
-        return std::realloc(ptr, size);
+        const bool isNewAllocation = !ptr;
+        return on_reallocate_(isNewAllocation, std::realloc(ptr, size), size);
     }
 
     void free_debug_(void* ptr) noexcept
     {
+        on_free_(ptr);
         std::free(ptr);
     }
 
@@ -63,7 +68,7 @@ void free_aligned_(void* ptr) noexcept
         std::size_t size, std::size_t alignment,
         debug_memory_alloc_info allocInfo) noexcept
     {
-        return std::aligned_alloc(alignment, size);
+        return on_allocate_(std::aligned_alloc(alignment, size), size);
     }
 
     void* reallocate_aligned_debug_(
@@ -75,6 +80,7 @@ void free_aligned_(void* ptr) noexcept
 
     void free_aligned_debug_(void* ptr) noexcept
     {
+        on_free_(ptr);
         std::free(ptr);
     }
 #endif
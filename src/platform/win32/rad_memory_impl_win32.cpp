@@ -13,16 +13,18 @@ namespace rad::detail_
 {
 void* allocate_(std::size_t size) noexcept
 {
-    return std::malloc(size);
+    return on_allocate_(std::malloc(size), size);
 }
 
 void* reallocate_(void* ptr, std::size_t size) noexcept
 {
-    return std::realloc(ptr, size);
+    const bool isNewAllocation = !ptr;
+    return on_reallocate_(isNewAllocation, std::realloc(ptr, size), size);
 }
 
 void free_(void* ptr) noexcept
 {
+    on_free_(ptr);
     std::free(ptr);
 }
 
@@ -30,18 +32,20 @@ void* allocate_aligned_(std::size_t size, std::size_t alignment) noexcept
 {
     RAD_VALIDATE_ALIGNED_ALLOC_ARGS(size, alignment)
 
-    return _aligned_malloc(size, alignment);
+    return on_allocate_(_aligned_malloc(size, alignment), size);
 }
 
 void* reallocate_aligned_(void* ptr, std::size_t size, std::size_t alignment) noexcept
 {
     RAD_VALIDATE_ALIGNED_ALLOC_ARGS(size, alignment)
 
-    return _aligned_realloc(ptr, size, alignment);
+    const bool isNewAllocation = !ptr;
+    return on_reallocate_(isNewAllocation, _aligned_realloc(ptr, size, alignment), size);
 }
 
 void free_aligned_(void* ptr) noexcept
 {
+    on_free_(ptr);
     _aligned_free(ptr);
 }
 
@@ -49,20 +53,22 @@ void free_aligned_(void* ptr) noexcept
     void* allocate_debug_(std::size_t size,
         debug_memory_alloc_info allocInfo) noexcept
     {
-        return _malloc_dbg(size, _NORMAL_BLOCK,
-            allocInfo.filePath, allocInfo.lineNumber);
+        return on_allocate_(_malloc_dbg(size, _NORMAL_BLOCK,
+            allocInfo.filePath, allocInfo.lineNumber), size);
     }
 
     void* reallocate_debug_(
         void* ptr, std::size_t size,
         debug_memory_alloc_info allocInfo) noexcept
     {
-        return _realloc_dbg(ptr, size, _NORMAL_BLOCK,
-            allocInfo.filePath, allocInfo.lineNumber);
+        const bool isNewAllocation = !ptr;
+        return on_reallocate_(isNewAllocation, _realloc_dbg(ptr, size, _NORMAL_BLOCK,
+            allocInfo.filePath, allocInfo.lineNumber), size);
     }
 
     void free_debug_(void* ptr) noexcept
     {
+        on_free_(ptr);
         _free_dbg(ptr, _NORMAL_BLOCK);
     }
 
@@ -72,8 +78,8 @@ void free_aligned_(void* ptr) noexcept
     {
         RAD_VALIDATE_ALIGNED_ALLOC_ARGS(size, alignment)
 
-        return _aligned_malloc_dbg(size, alignment,
-            allocInfo.filePath, allocInfo.lineNumber);
+        return on_allocate_(_aligned_malloc_dbg(size, alignment,
+            allocInfo.filePath, allocInfo.lineNumber), size);
     }
 
     void* reallocate_aligned_debug_(
@@ -82,12 +88,14 @@ void free_aligned_(void* ptr) noexcept
     {
         RAD_VALIDATE_ALIGNED_ALLOC_ARGS(size, alignment)
 
-        return _aligned_realloc_dbg(ptr, size, alignment,
-            allocInfo.filePath, allocInfo.lineNumber);
+        const bool isNewAllocation = !ptr;
+        return on_reallocate_(isNewAllocation, _aligned_realloc_dbg(ptr, size, alignment,
+            allocInfo.filePath, allocInfo.lineNumber), size);
     }
 
     void free_aligned_debug_(void* ptr) noexcept
     {
+        on_free_(ptr);
         _aligned_free_dbg(ptr);
     }
 #endif
@@ -0,0 +1,33 @@
+/// @file rad_perf_counters_impl_win32.cpp
+/// @author Graham Scott
+/// @brief Win32 implementation of rad_perf_counters.h
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_perf_counters.h"
+
+namespace rad
+{
+// NOTE: Windows only exposes hardware counters to user-mode code via ETW
+// (which requires admin rights), so perf counters are unsupported on Windows.
+
+bool perf_counters::is_supported() noexcept
+{
+    return false;
+}
+
+perf_counter_values perf_counters::read() const noexcept
+{
+    return perf_counter_values();
+}
+
+perf_counters::perf_counters() noexcept
+{
+    for (auto& fd : fds_)
+    {
+        fd = -1;
+    }
+}
+
+perf_counters::~perf_counters() = default;
+}
@@ -0,0 +1,90 @@
+/// @file rad_allocation_counter.cpp
+/// @author Graham Scott
+/// @brief Implementation of rad_allocation_counter.h
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_allocation_counter.h"
+
+#if RAD_USE_ALLOCATION_COUNTERS == 1
+
+#include "rad_memory_impl.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace rad
+{
+namespace detail_
+{
+    thread_local allocation_stats* activeAllocationStats_ = nullptr;
+
+#if RAD_USE_DEBUG_MEMORY == 1
+    atomic_allocation_stats_ globalAllocationStats_ = {};
+#endif
+}
+
+static void default_allocation_expectation_handler_(const char* filePath,
+    unsigned int lineNumber, std::size_t maxAllocations, const allocation_stats& stats)
+{
+    std::fprintf(stderr, "%s:%u: expected at most %zu allocation(s), but %zu allocation(s) "
+        "and %zu reallocation(s) totalling %zu byte(s) were made\n", filePath, lineNumber,
+        maxAllocations, stats.allocations, stats.reallocations, stats.bytes);
+
+    std::abort();
+}
+
+static std::atomic<allocation_expectation_handler> allocationExpectationHandler_(
+    &default_allocation_expectation_handler_);
+
+scoped_allocation_counter::scoped_allocation_counter() noexcept
+    : prevStats_(detail_::activeAllocationStats_)
+{
+    detail_::activeAllocationStats_ = &stats_;
+}
+
+scoped_allocation_counter::~scoped_allocation_counter()
+{
+    assert(detail_::activeAllocationStats_ == &stats_ &&
+        "scoped_allocation_counters must be destroyed in the reverse order of their construction");
+
+    detail_::activeAllocationStats_ = prevStats_;
+
+    if (prevStats_)
+    {
+        *prevStats_ += stats_;
+    }
+}
+
+#if RAD_USE_DEBUG_MEMORY == 1
+allocation_stats get_global_allocation_stats() noexcept
+{
+    allocation_stats stats;
+    stats.allocations = detail_::globalAllocationStats_.allocations.load(std::memory_order_relaxed);
+    stats.reallocations = detail_::globalAllocationStats_.reallocations.load(std::memory_order_relaxed);
+    stats.frees = detail_::globalAllocationStats_.frees.load(std::memory_order_relaxed);
+    stats.bytes = detail_::globalAllocationStats_.bytes.load(std::memory_order_relaxed);
+
+    return stats;
+}
+#endif
+
+allocation_expectation_handler set_allocation_expectation_handler(
+    allocation_expectation_handler handler) noexcept
+{
+    return allocationExpectationHandler_.exchange((handler) ?
+        handler : &default_allocation_expectation_handler_);
+}
+
+namespace detail_
+{
+    void report_allocation_expectation_failure_(const char* filePath,
+        unsigned int lineNumber, std::size_t maxAllocations,
+        const allocation_stats& stats)
+    {
+        allocationExpectationHandler_.load()(filePath, lineNumber, maxAllocations, stats);
+    }
+}
+}
+
+#endif
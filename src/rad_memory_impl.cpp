@@ -94,6 +94,26 @@ void operator delete[](void* ptr, std::align_val_t al) noexcept
     RAD_FREE_ALIGNED(ptr);
 }
 
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    RAD_FREE(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    RAD_FREE(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    RAD_FREE_ALIGNED(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    RAD_FREE_ALIGNED(ptr);
+}
+
 void operator delete(void* ptr, const std::nothrow_t&) noexcept
 {
     RAD_FREE(ptr);
@@ -7,6 +7,21 @@
 #ifndef RAD_MEMORY_IMPL_H_INCLUDED
 #define RAD_MEMORY_IMPL_H_INCLUDED
 
+#include "rad_base.h"
+#include <cstddef>
+
+#if RAD_USE_ALLOCATION_COUNTERS == 1
+    #include "rad_allocation_counter.h"
+
+    #if RAD_USE_DEBUG_MEMORY == 1
+        #include <atomic>
+    #endif
+#endif
+
+#if RAD_USE_TRACING == 1
+    #include "rad_trace.h"
+#endif
+
 #define RAD_VALIDATE_ALIGNED_ALLOC_ARGS(size, alignment)\
 {\
     assert(((alignment) & ((alignment) - 1)) == 0 &&\
@@ -16,4 +31,137 @@
         "The given alignment must be a multiple of sizeof(void*)");\
 }
 
+namespace rad::detail_
+{
+#if RAD_USE_ALLOCATION_COUNTERS == 1
+    /// @brief The stats of the innermost scoped_allocation_counter
+    /// on the current thread, or nullptr if there isn't one.
+    extern thread_local allocation_stats* activeAllocationStats_;
+
+    #if RAD_USE_DEBUG_MEMORY == 1
+    struct atomic_allocation_stats_
+    {
+        std::atomic<std::size_t> allocations;
+        std::atomic<std::size_t> reallocations;
+        std::atomic<std::size_t> frees;
+        std::atomic<std::size_t> bytes;
+    };
+
+    /// @brief The stats of all allocations made on all threads.
+    extern atomic_allocation_stats_ globalAllocationStats_;
+    #endif
+#endif
+
+    // NOTE: These hooks are called by the platform-specific allocation functions.
+    // The reallocation hook is told whether the reallocation was actually a new
+    // allocation (i.e. the old pointer was null) rather than given the old pointer
+    // itself, as the old pointer has already been freed by the time it's called.
+
+    // NOTE: When allocation counters and tracing are both disabled, these compile to nothing.
+
+    inline void* on_allocate_(void* ptr, [[maybe_unused]] std::size_t size) noexcept
+    {
+    #if RAD_USE_ALLOCATION_COUNTERS == 1
+        if (ptr && activeAllocationStats_)
+        {
+            ++activeAllocationStats_->allocations;
+            activeAllocationStats_->bytes += size;
+        }
+    #endif
+
+    #if RAD_USE_ALLOCATION_COUNTERS == 1 && RAD_USE_DEBUG_MEMORY == 1
+        if (ptr)
+        {
+            globalAllocationStats_.allocations.fetch_add(1, std::memory_order_relaxed);
+            globalAllocationStats_.bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    #endif
+
+    #if RAD_USE_TRACING == 1
+        if (ptr && trace::detail_::isRecordingAllocations_.load(std::memory_order_relaxed))
+        {
+            trace::detail_::record_allocation_(1, size);
+        }
+    #endif
+
+        return ptr;
+    }
+
+    /// @brief Records that an existing block has been freed.
+    inline void on_free_block_() noexcept
+    {
+    #if RAD_USE_ALLOCATION_COUNTERS == 1
+        if (activeAllocationStats_)
+        {
+            ++activeAllocationStats_->frees;
+        }
+    #endif
+
+    #if RAD_USE_ALLOCATION_COUNTERS == 1 && RAD_USE_DEBUG_MEMORY == 1
+        globalAllocationStats_.frees.fetch_add(1, std::memory_order_relaxed);
+    #endif
+
+    #if RAD_USE_TRACING == 1
+        if (trace::detail_::isRecordingAllocations_.load(std::memory_order_relaxed))
+        {
+            trace::detail_::record_allocation_(-1, 0);
+        }
+    #endif
+    }
+
+    inline void on_free_(void* ptr) noexcept
+    {
+        if (ptr)
+        {
+            on_free_block_();
+        }
+    }
+
+    inline void* on_reallocate_(bool isNewAllocation,
+        void* newPtr, [[maybe_unused]] std::size_t size) noexcept
+    {
+        // NOTE: Reallocating an existing block to a size of zero frees it, and returns
+        // nullptr (otherwise, nullptr means the existing block was left untouched).
+        if (!newPtr && size == 0)
+        {
+            if (!isNewAllocation)
+            {
+                on_free_block_();
+            }
+
+            return nullptr;
+        }
+
+    #if RAD_USE_ALLOCATION_COUNTERS == 1
+        if (newPtr && activeAllocationStats_)
+        {
+            ++(isNewAllocation ? activeAllocationStats_->allocations :
+                activeAllocationStats_->reallocations);
+
+            activeAllocationStats_->bytes += size;
+        }
+    #endif
+
+    #if RAD_USE_ALLOCATION_COUNTERS == 1 && RAD_USE_DEBUG_MEMORY == 1
+        if (newPtr)
+        {
+            (isNewAllocation ? globalAllocationStats_.allocations :
+                globalAllocationStats_.reallocations).fetch_add(1, std::memory_order_relaxed);
+
+            globalAllocationStats_.bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    #endif
+
+    #if RAD_USE_TRACING == 1
+        if (newPtr && trace::detail_::isRecordingAllocations_.load(std::memory_order_relaxed))
+        {
+            // NOTE: Reallocating an existing block doesn't change the number of live blocks.
+            trace::detail_::record_allocation_(isNewAllocation ? 1 : 0, size);
+        }
+    #endif
+
+        return newPtr;
+    }
+}
+
 #endif
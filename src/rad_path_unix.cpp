@@ -5,106 +5,13 @@
 /// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
 
 #include "rad_path_unix.h"
+#include "rad_simd_impl.h"
+#include <algorithm>
 
 using namespace std::string_view_literals;
 
 namespace rad::path
 {
-bool has_trailing_separator_unix(std::string_view path) noexcept
-{
-    return (!path.empty() && is_separator_unix(path.back()));
-}
-
-bool has_leading_separator_unix(std::string_view path) noexcept
-{
-    return (!path.empty() && is_separator_unix(path.front()));
-}
-
-static std::size_t get_trailing_separator_count_unix_(
-    std::string_view path) noexcept
-{
-    std::size_t i = path.size();
-
-    while (i > 0)
-    {
-        if (!is_separator_unix(path[i - 1]))
-        {
-            break;
-        }
-
-        --i;
-    }
-
-    return (path.size() - i);
-}
-
-std::string_view get_no_trailing_separator_path_unix(std::string_view path) noexcept
-{
-    path.remove_suffix(get_trailing_separator_count_unix_(path));
-    return path;
-}
-
-static std::size_t get_file_name_index_unix_(std::string_view path) noexcept
-{
-    std::size_t i = path.size();
-
-    while (i > 0)
-    {
-        --i;
-
-        if (is_separator_unix(path[i]))
-        {
-            return (i + 1);
-        }
-    }
-    
-    return 0;
-}
-
-std::string_view get_name_unix(std::string_view path) noexcept
-{
-    path.remove_suffix(get_trailing_separator_count_unix_(path));
-    path.remove_prefix(get_file_name_index_unix_(path));
-
-    return path;
-}
-
-static std::size_t get_extensions_index_unix_(std::string_view path) noexcept
-{
-    std::size_t i = path.size();
-    std::size_t extsIndex = i;
-
-    while (i > 0)
-    {
-        --i;
-
-        if (path[i] == '.')
-        {
-            extsIndex = i;
-        }
-        else if (is_separator_unix(path[i]))
-        {
-            break;
-        }
-    }
-    
-    return extsIndex;
-}
-
-std::string_view get_extensions_unix(std::string_view path) noexcept
-{
-    path.remove_suffix(get_trailing_separator_count_unix_(path));
-    path.remove_prefix(get_extensions_index_unix_(path));
-
-    return path;
-}
-
-std::string_view get_parent_unix(std::string_view path) noexcept
-{
-    path.remove_suffix(get_trailing_separator_count_unix_(path));
-    return std::string_view(path.data(), get_file_name_index_unix_(path));
-}
-
 static std::size_t get_leading_separator_count_unix_(std::string_view str)
 {
     const std::size_t len = str.size();
@@ -120,7 +27,8 @@ static std::size_t get_leading_separator_count_unix_(std::string_view str)
     return len;
 }
 
-bool append_unix(std::string& path, std::string_view subpath)
+template<typename String>
+static bool append_unix_(String& path, std::string_view subpath)
 {
     if (!subpath.empty())
     {
@@ -146,6 +54,16 @@ bool append_unix(std::string& path, std::string_view subpath)
     return false;
 }
 
+bool append_unix(std::string& path, std::string_view subpath)
+{
+    return append_unix_(path, subpath);
+}
+
+bool append_unix(rad::string& path, std::string_view subpath)
+{
+    return append_unix_(path, subpath);
+}
+
 std::string combine_unix(std::string_view path1, std::string_view path2)
 {
     if (!path2.empty())
@@ -175,171 +93,251 @@ std::string combine_unix(std::string_view path1, std::string_view path2)
     return std::string(path1);
 }
 
-bool remove_trailing_separators_unix(std::string& path)
+template<typename String>
+static bool remove_trailing_separators_unix_(String& path)
 {
-    const auto trailingSepsCount = get_trailing_separator_count_unix_(path);
+    const auto trailingSepsCount = detail_::get_trailing_separator_count_unix(path);
     path.erase(path.size() - trailingSepsCount);
 
     return (trailingSepsCount != 0);
 }
 
-bool remove_trailing_separators_unix(std::string_view& path)
+bool remove_trailing_separators_unix(std::string& path)
 {
-    const auto trailingSepsCount = get_trailing_separator_count_unix_(path);
-    path.remove_suffix(trailingSepsCount);
+    return remove_trailing_separators_unix_(path);
+}
 
-    return (trailingSepsCount != 0);
+bool remove_trailing_separators_unix(rad::string& path)
+{
+    return remove_trailing_separators_unix_(path);
 }
 
-bool remove_name_unix(std::string& path)
+template<typename String>
+static bool remove_name_unix_(String& path)
 {
     const auto noSepsPath = get_no_trailing_separator_path_unix(path);
-    const auto fileNameIndex = get_file_name_index_unix_(noSepsPath);
+    const auto fileNameIndex = detail_::get_file_name_index_unix(noSepsPath);
 
     path.erase(fileNameIndex);
 
     return (fileNameIndex != 0);
 }
 
-bool remove_name_unix(std::string_view& path)
+bool remove_name_unix(std::string& path)
 {
-    const auto noSepsPath = get_no_trailing_separator_path_unix(path);
-    const auto fileNameIndex = get_file_name_index_unix_(noSepsPath);
-
-    path = std::string_view(path.data(), fileNameIndex);
-
-    return (fileNameIndex != 0);
+    return remove_name_unix_(path);
 }
 
-std::size_t component_iterator_unix::get_initial_component_length_(const char* path)
+bool remove_name_unix(rad::string& path)
 {
-    // Handle root directory special case (e.g. the forward-slash in "/whatever").
-    return (is_separator_unix(*path)) ?
-        1 : get_current_component_length_(path);
+    return remove_name_unix_(path);
 }
 
-const char* component_iterator_unix::skip_repeating_separators(const char* path)
+std::size_t split_components_unix(std::string_view path,
+    span<std::string_view> components) noexcept
 {
-    // NOTE: We do not need to check for the null-terminator
-    // explicitly, since a null-terminator will cause
-    // is_separator_unix to return false, thus ending the loop.
-    while (is_separator_unix(*path))
+    const char* str = path.data();
+    const std::size_t len = path.size();
+    std::size_t i = 0, count = 0;
+
+    if (len == 0)
     {
-        ++path;
+        return 0;
     }
 
-    return path;
-}
+    // Handle root directory special case (e.g. the forward-slash in "/whatever").
+    if (is_separator_unix(str[0]))
+    {
+        if (!components.empty())
+        {
+            components[0] = std::string_view(str, 1);
+        }
 
-std::size_t component_iterator_unix::get_current_component_length_(const char* path)
-{
-    std::size_t len = 0;
+        ++count;
+    }
 
-    while (
-        path[len] != '\0' &&
-        !is_separator_unix(path[len]))
+    while (true)
     {
-        ++len;
+        // Skip over repeating separators.
+        i += rad::detail_::simd::find_neither(str + i, len - i, '/', '/');
+        if (i == len)
+        {
+            break;
+        }
+
+        // Find the end of the current component.
+        const std::size_t compLen = rad::detail_::simd::find_either(
+            str + i, len - i, '/', '/');
+
+        if (count < components.size())
+        {
+            components[count] = std::string_view(str + i, compLen);
+        }
+
+        ++count;
+        i += compLen;
     }
-    
-    return len;
+
+    return count;
 }
 
-component_iterator_unix& component_iterator_unix::operator++()
+std::string_view common_prefix_unix(std::string_view path1,
+    std::string_view path2) noexcept
 {
-    path_ = skip_repeating_separators(path_ + curComponentLen_);
-    curComponentLen_ = get_current_component_length_(path_);
+    const std::size_t minLen = std::min(path1.size(), path2.size());
+    std::size_t prefixLen = rad::detail_::simd::find_mismatch(
+        path1.data(), path2.data(), minLen);
 
-    return *this;
-}
+    // If the paths don't differ right at a component boundary, the last
+    // component they share is only partially equal, so exclude it.
+    const bool isBoundary = (
+        (prefixLen > 0 && is_separator_unix(path1[prefixLen - 1])) ||
+        ((prefixLen == path1.size() || is_separator_unix(path1[prefixLen])) &&
+        (prefixLen == path2.size() || is_separator_unix(path2[prefixLen]))));
 
-component_iterator_unix component_iterator_unix::operator++(int)
-{
-    const auto it = *this;
-    ++(*this);
-    return it;
-}
+    if (!isBoundary)
+    {
+        while (prefixLen > 0 && !is_separator_unix(path1[prefixLen - 1]))
+        {
+            --prefixLen;
+        }
+    }
 
-component_iterator_unix::component_iterator_unix(const char* path)
-    : path_(path)
-    , curComponentLen_(get_initial_component_length_(path_))
-{
+    return path1.substr(0, prefixLen);
 }
 
-component_iterator_unix::component_iterator_unix(const std::string& path)
-    : path_(path.c_str())
-    , curComponentLen_(get_initial_component_length_(path_))
+std::string_view common_prefix_unix(span<const std::string_view> paths) noexcept
 {
+    if (paths.empty())
+    {
+        return std::string_view();
+    }
+
+    std::string_view prefix = paths[0];
+
+    for (std::size_t i = 1; i < paths.size() && !prefix.empty(); ++i)
+    {
+        prefix = common_prefix_unix(prefix, paths[i]);
+    }
+
+    return prefix;
 }
 
-component_iterator_unix::component_iterator_unix(std::string_view path)
-    : path_(path.data())
-    , curComponentLen_(path.empty() ? 0 : get_initial_component_length_(path_))
+template<typename String>
+static bool relative_unix_(std::string_view from, std::string_view to, String& result)
 {
+    result.clear();
+
+    // We can't compute a relative path between an absolute and a relative path.
+    if (has_leading_separator_unix(from) != has_leading_separator_unix(to))
+    {
+        return false;
+    }
+
+    // Skip over the components both paths share.
+    const std::size_t prefixLen = common_prefix_unix(from, to).size();
+
+    from.remove_prefix(prefixLen);
+    from.remove_prefix(get_leading_separator_count_unix_(from));
+
+    to.remove_prefix(prefixLen);
+    to.remove_prefix(get_leading_separator_count_unix_(to));
+
+    // Go up one directory for every remaining component in the base path.
+    for (const auto comp : components_unix(from))
+    {
+        if (comp == "."sv)
+        {
+            continue;
+        }
+
+        // NOTE: We can't know which directory to go back into after ".." without
+        // accessing the file system, so we just treat this as an error.
+        if (comp == ".."sv)
+        {
+            result.clear();
+            return false;
+        }
+
+        if (!result.empty())
+        {
+            result += '/';
+        }
+
+        result += ".."sv;
+    }
+
+    // Go down into the remaining components in the target path.
+    if (!to.empty())
+    {
+        if (!result.empty())
+        {
+            result += '/';
+        }
+
+        result += to;
+    }
+
+    if (result.empty())
+    {
+        result += '.';
+    }
+
+    return true;
 }
 
-component_iterator_unix get_begin_unix(const char* path)
+bool relative_unix(std::string_view from, std::string_view to, std::string& result)
 {
-    return component_iterator_unix(path);
+    return relative_unix_(from, to, result);
 }
 
-component_iterator_unix get_begin_unix(const std::string& path)
+bool relative_unix(std::string_view from, std::string_view to, rad::string& result)
 {
-    return component_iterator_unix(path);
+    return relative_unix_(from, to, result);
 }
 
-component_iterator_unix get_begin_unix(std::string_view path)
+// NOTE: These functions used to be exported from libRad, before they were made
+// constexpr (see rad_path_unix.h), so they're kept as thin wrappers around the
+// new versions, for binaries which were built against older versions of libRad.
+// They must stay at the end of this file, as unqualified calls to any of these
+// functions would otherwise be ambiguous.
+RAD_API bool has_trailing_separator_unix(std::string_view path) noexcept
 {
-    return component_iterator_unix(path);
+    return v2::has_trailing_separator_unix(path);
 }
 
-component_iterator_unix get_end_unix(const char* path)
+RAD_API bool has_leading_separator_unix(std::string_view path) noexcept
 {
-    return component_iterator_unix(path + std::strlen(path));
+    return v2::has_leading_separator_unix(path);
 }
 
-component_iterator_unix get_end_unix(const std::string& path)
+RAD_API std::string_view get_no_trailing_separator_path_unix(std::string_view path) noexcept
 {
-    return component_iterator_unix(path.c_str() + path.size());
+    return v2::get_no_trailing_separator_path_unix(path);
 }
 
-component_iterator_unix get_end_unix(std::string_view path)
+RAD_API std::string_view get_name_unix(std::string_view path) noexcept
 {
-    return ((path.empty()) ?
-        component_iterator_unix() :
-        component_iterator_unix(path.data() + path.size())
-    );
+    return v2::get_name_unix(path);
 }
 
-component_iterators_unix::component_iterators_unix(
-    component_iterator_unix begin,
-    component_iterator_unix end) noexcept
-    : begin_(begin)
-    , end_(end)
+RAD_API std::string_view get_extensions_unix(std::string_view path) noexcept
 {
+    return v2::get_extensions_unix(path);
 }
 
-component_iterators_unix components_unix(const char* path)
+RAD_API std::string_view get_parent_unix(std::string_view path) noexcept
 {
-    return component_iterators_unix(
-        get_begin_unix(path),
-        get_end_unix(path)
-    );
+    return v2::get_parent_unix(path);
 }
 
-component_iterators_unix components_unix(const std::string& path)
+RAD_API bool remove_trailing_separators_unix(std::string_view& path)
 {
-    return component_iterators_unix(
-        get_begin_unix(path),
-        get_end_unix(path)
-    );
+    return v2::remove_trailing_separators_unix(path);
 }
 
-component_iterators_unix components_unix(std::string_view path)
+RAD_API bool remove_name_unix(std::string_view& path)
 {
-    return component_iterators_unix(
-        get_begin_unix(path),
-        get_end_unix(path)
-    );
+    return v2::remove_name_unix(path);
 }
 }
@@ -5,137 +5,15 @@
 /// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
 
 #include "rad_path_win32.h"
+#include "rad_simd_impl.h"
+#include <algorithm>
 
 using namespace std::string_view_literals;
 
-namespace rad::path
-{
-bool has_trailing_separator_win32(std::string_view path) noexcept
-{
-    return (!path.empty() && is_separator_win32(path.back()));
-}
-
-bool has_leading_separator_win32(std::string_view path) noexcept
-{
-    return (!path.empty() && is_separator_win32(path.front()));
-}
-
-static std::size_t get_trailing_separator_count_win32_(
-    std::string_view path) noexcept
-{
-    std::size_t i = path.size();
-
-    while (i > 0)
-    {
-        if (!is_separator_win32(path[i - 1]))
-        {
-            break;
-        }
-
-        --i;
-    }
-
-    return (path.size() - i);
-}
-
-static std::size_t get_file_name_index_win32_(std::string_view path) noexcept
-{
-    std::size_t i = path.size();
-
-    while (i > 0)
-    {
-        --i;
-
-        if (is_separator_win32(path[i]) ||
-            path[i] == ':')
-        {
-            return (i + 1);
-        }
-    }
-    
-    return 0;
-}
-
-std::string_view get_no_trailing_separator_path_win32(std::string_view path) noexcept
-{
-    path.remove_suffix(get_trailing_separator_count_win32_(path));
-    return path;
-}
-
-std::string_view get_name_win32(std::string_view path) noexcept
-{
-    path.remove_suffix(get_trailing_separator_count_win32_(path));
-
-    if (!path.empty() &&
-        path.back() != ':' &&   // e.g. "C:"
-        path.back() != '?' &&   // e.g. "\\?"
-        path != "\\\\."sv)      // e.g. "\\."
-    {
-        // OPTIMIZATION: We skip checking anything else in the path
-        // since valid paths can't utilize colons or question mark
-        // characters anywhere but in their prefix anyway.
-        
-        path.remove_prefix(get_file_name_index_win32_(path));
-        return path;
-    }
-
-    return std::string_view();
-}
-
-static std::size_t get_extensions_index_win32_(std::string_view path) noexcept
-{
-    std::size_t i = path.size();
-    std::size_t extsIndex = i;
-
-    while (i > 0)
-    {
-        --i;
-
-        if (path[i] == '.')
-        {
-            extsIndex = i;
-        }
-        else if (is_separator_win32(path[i]) ||
-            path[i] == ':')
-        {
-            break;
-        }
-    }
-    
-    return extsIndex;
-}
-
-std::string_view get_extensions_win32(std::string_view path) noexcept
-{
-    path.remove_suffix(get_trailing_separator_count_win32_(path));
-
-    if (path != "\\\\."sv)  // e.g. "\\."
-    {
-        path.remove_prefix(get_extensions_index_win32_(path));
-    }
-
-    return path;
-}
+namespace simd = rad::detail_::simd;
 
-std::string_view get_parent_win32(std::string_view path) noexcept
+namespace rad::path
 {
-    path.remove_suffix(get_trailing_separator_count_win32_(path));
-
-    if (!path.empty() &&
-        path.back() != ':' &&   // e.g. "C:"
-        path.back() != '?' &&   // e.g. "\\?"
-        path != "\\\\."sv)      // e.g. "\\."
-    {
-        // OPTIMIZATION: We skip checking anything else in the path
-        // since valid paths can't utilize colons or question mark
-        // characters anywhere but in their prefix anyway.
-        
-        path.remove_suffix(get_file_name_index_win32_(path));
-    }
-
-    return path;
-}
-
 static std::size_t get_leading_separator_count_win32_(std::string_view str)
 {
     const std::size_t len = str.size();
@@ -151,7 +29,8 @@ static std::size_t get_leading_separator_count_win32_(std::string_view str)
     return len;
 }
 
-bool append_win32(std::string& path, std::string_view subpath)
+template<typename String>
+static bool append_win32_(String& path, std::string_view subpath)
 {
     if (!subpath.empty())
     {
@@ -177,6 +56,16 @@ bool append_win32(std::string& path, std::string_view subpath)
     return false;
 }
 
+bool append_win32(std::string& path, std::string_view subpath)
+{
+    return append_win32_(path, subpath);
+}
+
+bool append_win32(rad::string& path, std::string_view subpath)
+{
+    return append_win32_(path, subpath);
+}
+
 std::string combine_win32(std::string_view path1, std::string_view path2)
 {
     if (!path2.empty())
@@ -206,36 +95,33 @@ std::string combine_win32(std::string_view path1, std::string_view path2)
     return std::string(path1);
 }
 
-bool remove_trailing_separators_win32(std::string& path)
+template<typename String>
+static bool remove_trailing_separators_win32_(String& path)
 {
-    const auto trailingSepsCount = get_trailing_separator_count_win32_(path);
+    const auto trailingSepsCount = detail_::get_trailing_separator_count_win32(path);
     path.erase(path.size() - trailingSepsCount);
 
     return (trailingSepsCount != 0);
 }
 
-bool remove_trailing_separators_win32(std::string_view& path)
+bool remove_trailing_separators_win32(std::string& path)
 {
-    const auto trailingSepsCount = get_trailing_separator_count_win32_(path);
-    path.remove_suffix(trailingSepsCount);
+    return remove_trailing_separators_win32_(path);
+}
 
-    return (trailingSepsCount != 0);
+bool remove_trailing_separators_win32(rad::string& path)
+{
+    return remove_trailing_separators_win32_(path);
 }
 
-bool remove_name_win32(std::string& path)
+template<typename String>
+static bool remove_name_win32_(String& path)
 {
     const auto noSepsPath = get_no_trailing_separator_path_win32(path);
 
-    if (!noSepsPath.empty() &&
-        noSepsPath.back() != ':' &&   // e.g. "C:"
-        noSepsPath.back() != '?' &&   // e.g. "\\?"
-        noSepsPath != "\\\\."sv)      // e.g. "\\."
+    if (detail_::has_name_win32(noSepsPath))
     {
-        // OPTIMIZATION: We skip checking anything else in the path
-        // since valid paths can't utilize colons or question mark
-        // characters anywhere but in their prefix anyway.
-        
-        const auto fileNameIndex = get_file_name_index_win32_(noSepsPath);
+        const auto fileNameIndex = detail_::get_file_name_index_win32(noSepsPath);
         path.erase(fileNameIndex);
 
         return (fileNameIndex != 0);
@@ -244,35 +130,190 @@ bool remove_name_win32(std::string& path)
     return false;
 }
 
-bool remove_name_win32(std::string_view& path)
+bool remove_name_win32(std::string& path)
+{
+    return remove_name_win32_(path);
+}
+
+bool remove_name_win32(rad::string& path)
 {
-    const auto noSepsPath = get_no_trailing_separator_path_win32(path);
+    return remove_name_win32_(path);
+}
+
+static std::size_t get_component_length_win32_(
+    const char* str, std::size_t len) noexcept
+{
+    // NOTE: str may be null if len is 0, which std::memchr doesn't allow.
+    if (len == 0)
+    {
+        return 0;
+    }
+
+    // NOTE: ':' characters ARE counted in the component length,
+    // but also mark the end of the component.
+    const std::size_t compLen = simd::find_either(str, len, '/', '\\');
+    const void* colon = std::memchr(str, ':', compLen);
+
+    return (colon) ? (static_cast<std::size_t>(
+        static_cast<const char*>(colon) - str) + 1) : compLen;
+}
+
+void convert_separators_win32(char* path, std::size_t len, char newSep) noexcept
+{
+    simd::replace_either_copy(path, path, len, '/', '\\', newSep);
+}
 
-    if (!noSepsPath.empty() &&
-        noSepsPath.back() != ':' &&   // e.g. "C:"
-        noSepsPath.back() != '?' &&   // e.g. "\\?"
-        noSepsPath != "\\\\."sv)      // e.g. "\\."
+static bool is_verbatim_unc_prefix_win32_(std::string_view path) noexcept
+{
+    // NOTE: The "UNC" in verbatim UNC paths is case-insensitive.
+    return (path.size() >= 4 &&
+        simd::fold_win32_char(path[0]) == 'u' &&
+        simd::fold_win32_char(path[1]) == 'n' &&
+        simd::fold_win32_char(path[2]) == 'c' &&
+        is_separator_win32(path[3]));
+}
+
+static void resize_for_overwrite_(std::string& str, std::size_t newSize)
+{
+    str.resize(newSize);
+}
+
+static void resize_for_overwrite_(rad::string& str, std::size_t newSize)
+{
+    // NOTE: rad::string can skip zero-filling the characters we're about to overwrite.
+    str.resize_uninitialized(newSize);
+}
+
+template<typename String>
+static void to_unix_(std::string_view path, String& result)
+{
+    std::string_view prefix;
+
+    // Strip verbatim prefixes (e.g. the "\\?\" in "\\?\C:\whatever").
+    if (path.substr(0, 4) == "\\\\?\\"sv)
     {
-        // OPTIMIZATION: We skip checking anything else in the path
-        // since valid paths can't utilize colons or question mark
-        // characters anywhere but in their prefix anyway.
-        
-        const auto fileNameIndex = get_file_name_index_win32_(noSepsPath);
-        path = std::string_view(path.data(), fileNameIndex);
+        path.remove_prefix(4);
 
-        return (fileNameIndex != 0);
+        // Turn verbatim UNC paths into regular UNC paths
+        // (e.g. "\\?\UNC\server\share" -> "//server/share").
+        if (is_verbatim_unc_prefix_win32_(path))
+        {
+            path.remove_prefix(4);
+            prefix = "//"sv;
+        }
     }
 
-    return false;
+    // NOTE: We resize and then overwrite the string's contents
+    // directly so that all of the separators can be converted
+    // in a single pass.
+    resize_for_overwrite_(result, prefix.size() + path.size());
+
+    if (!prefix.empty())
+    {
+        std::memcpy(result.data(), prefix.data(), prefix.size());
+    }
+
+    simd::replace_either_copy(path.data(),
+        result.data() + prefix.size(), path.size(), '\\', '\\', '/');
+}
+
+void to_unix(std::string_view path, std::string& result)
+{
+    to_unix_(path, result);
+}
+
+void to_unix(std::string_view path, rad::string& result)
+{
+    to_unix_(path, result);
+}
+
+template<typename String>
+static void to_win32_(std::string_view path, String& result)
+{
+    resize_for_overwrite_(result, path.size());
+
+    simd::replace_either_copy(path.data(),
+        result.data(), path.size(), '/', '/', '\\');
+}
+
+void to_win32(std::string_view path, std::string& result)
+{
+    to_win32_(path, result);
+}
+
+void to_win32(std::string_view path, rad::string& result)
+{
+    to_win32_(path, result);
+}
+
+bool equals_win32_insensitive(std::string_view path1, std::string_view path2) noexcept
+{
+    return (path1.size() == path2.size() &&
+        simd::find_mismatch_win32_folded(path1.data(),
+            path2.data(), path1.size()) == path1.size());
+}
+
+static std::uint64_t hash_mix_win32_(std::uint64_t hash, std::uint64_t word) noexcept
+{
+    hash ^= word;
+    hash *= 0x9E3779B97F4A7C15ull;
+    return (hash ^ (hash >> 32));
+}
+
+std::size_t hash_win32_insensitive(std::string_view path) noexcept
+{
+    using namespace simd;
+
+    // NOTE: The path is hashed as a sequence of folded 8-byte words (with the
+    // last one zero-padded), so the vectorized and scalar loops below are
+    // guaranteed to produce the exact same hash for the exact same input.
+    const char* str = path.data();
+    const std::size_t len = path.size();
+    std::uint64_t hash = (0xCBF29CE484222325ull ^ len);
+    std::size_t i = 0;
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    alignas(16) char folded[block_size];
+
+    for (; (i + block_size) <= len; i += block_size)
+    {
+        store(folded, fold_win32(load(str + i)));
+
+        hash = hash_mix_win32_(hash, load_u64(folded));
+        hash = hash_mix_win32_(hash, load_u64(folded + 8));
+    }
+#endif
+
+    for (; i < len; i += 8)
+    {
+        char word[8] = {};
+        const std::size_t wordLen = std::min<std::size_t>(8, (len - i));
+
+        for (std::size_t j = 0; j < wordLen; ++j)
+        {
+            word[j] = fold_win32_char(str[i + j]);
+        }
+
+        hash = hash_mix_win32_(hash, load_u64(word));
+    }
+
+    // Finalize the hash (this is the 64-bit finalizer from MurmurHash3).
+    hash ^= (hash >> 33);
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= (hash >> 33);
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= (hash >> 33);
+
+    return static_cast<std::size_t>(hash);
 }
 
-std::size_t component_iterator_win32::get_initial_component_length_(const char* path)
+static std::size_t get_initial_component_length_win32_(std::string_view path) noexcept
 {
     // Handle path prefixes that can only occur at the very beginning of a valid path.
-    if (path[0] == '\\' && path[1] == '\\')
+    if (path.size() >= 2 && path[0] == '\\' && path[1] == '\\')
     {
         // Handle the following special prefixes: "\\?\" and "\\.\".
-        if ((path[2] == '?' || path[2] == '.') &&
+        if (path.size() >= 4 && (path[2] == '?' || path[2] == '.') &&
             path[3] == '\\')
         {
             return 4;
@@ -284,149 +325,275 @@ std::size_t component_iterator_win32::get_initial_component_length_(const char*
             return 2;
         }
     }
-    
-    return get_current_component_length_(path);
+
+    return get_component_length_win32_(path.data(), path.size());
 }
 
-const char* component_iterator_win32::skip_repeating_separators(const char* path)
+std::size_t split_components_win32(std::string_view path,
+    span<std::string_view> components) noexcept
 {
-    // NOTE: We do not need to check for the null-terminator
-    // explicitly, since a null-terminator will cause
-    // is_separator_win32 to return false, thus ending the loop.
-    while (is_separator_win32(*path))
+    const char* str = path.data();
+    const std::size_t len = path.size();
+
+    if (len == 0)
     {
-        ++path;
+        return 0;
+    }
+
+    std::size_t i = get_initial_component_length_win32_(path), count = 1;
+
+    if (!components.empty())
+    {
+        components[0] = std::string_view(str, i);
+    }
+
+    while (true)
+    {
+        // Handle root directory special case (e.g. the backslash in "C:\whatever").
+        if (i > 0 && i < len && str[i - 1] == ':' && is_separator_win32(str[i]))
+        {
+            if (count < components.size())
+            {
+                components[count] = std::string_view(str + i, 1);
+            }
+
+            ++count;
+            ++i;
+        }
+
+        // Skip over repeating separators.
+        i += simd::find_neither(str + i, len - i, '/', '\\');
+        if (i == len)
+        {
+            break;
+        }
+
+        // Find the end of the current component.
+        const std::size_t compLen = get_component_length_win32_(str + i, len - i);
+
+        if (count < components.size())
+        {
+            components[count] = std::string_view(str + i, compLen);
+        }
+
+        ++count;
+        i += compLen;
     }
 
-    return path;
+    return count;
 }
 
-std::size_t component_iterator_win32::get_current_component_length_(const char* path)
+std::string_view common_prefix_win32(std::string_view path1,
+    std::string_view path2) noexcept
 {
-    std::size_t len = 0;
+    const std::size_t minLen = std::min(path1.size(), path2.size());
+    std::size_t prefixLen = simd::find_mismatch_win32_folded(
+        path1.data(), path2.data(), minLen);
 
-    while (
-        path[len] != '\0' &&
-        !is_separator_win32(path[len]) &&
+    // If the paths don't differ right at a component boundary, the last
+    // component they share is only partially equal, so exclude it.
+    const bool isBoundary = (
+        (prefixLen > 0 && (is_separator_win32(path1[prefixLen - 1]) ||
+        path1[prefixLen - 1] == ':')) ||
+        ((prefixLen == path1.size() || is_separator_win32(path1[prefixLen])) &&
+        (prefixLen == path2.size() || is_separator_win32(path2[prefixLen]))));
 
-        // NOTE: We purposefully postfix-increment len *here*, so
-        // that ':' characters ARE counted in the component length,
-        // but also cause the while loop to end.
-        path[len++] != ':')
+    if (!isBoundary)
     {
+        while (prefixLen > 0 && !is_separator_win32(path1[prefixLen - 1]) &&
+            path1[prefixLen - 1] != ':')
+        {
+            --prefixLen;
+        }
     }
-    
-    return len;
+
+    return path1.substr(0, prefixLen);
 }
 
-component_iterator_win32& component_iterator_win32::operator++()
+std::string_view common_prefix_win32(span<const std::string_view> paths) noexcept
 {
-    // Handle root directory special case (e.g. the backslash in "C:\whatever").
-    if (curComponentLen_ > 0 &&
-        path_[curComponentLen_ - 1] == ':' &&
-        is_separator_win32(path_[curComponentLen_]))
+    if (paths.empty())
     {
-        path_ += curComponentLen_;
-        curComponentLen_ = 1;
+        return std::string_view();
     }
 
-    // Get the next component of the path.
-    else
+    std::string_view prefix = paths[0];
+
+    for (std::size_t i = 1; i < paths.size() && !prefix.empty(); ++i)
     {
-        path_ = skip_repeating_separators(path_ + curComponentLen_);
-        curComponentLen_ = get_current_component_length_(path_);
+        prefix = common_prefix_win32(prefix, paths[i]);
     }
 
-    return *this;
+    return prefix;
 }
 
-component_iterator_win32 component_iterator_win32::operator++(int)
+static std::size_t skip_components_win32_(std::string_view path,
+    std::size_t i, std::size_t count) noexcept
 {
-    const auto it = *this;
-    ++(*this);
-    return it;
-}
+    while (count-- > 0 && i < path.size())
+    {
+        i += simd::find_neither(path.data() + i, path.size() - i, '/', '\\');
+        i += get_component_length_win32_(path.data() + i, path.size() - i);
+    }
 
-component_iterator_win32::component_iterator_win32(const char* path)
-    : path_(path)
-    , curComponentLen_(get_initial_component_length_(path_))
-{
+    return i;
 }
 
-component_iterator_win32::component_iterator_win32(const std::string& path)
-    : path_(path.c_str())
-    , curComponentLen_(get_initial_component_length_(path_))
+static std::size_t get_root_length_win32_(std::string_view path) noexcept
 {
+    std::size_t i = get_initial_component_length_win32_(path);
+
+    // Handle paths starting with a single separator (e.g. "\whatever").
+    if (i == 0)
+    {
+        return (!path.empty() && is_separator_win32(path[0]));
+    }
+
+    // Handle "\\?\" and "\\.\" prefixes.
+    if (i == 4 && path[0] == '\\' && path[1] == '\\')
+    {
+        const std::size_t nameIndex = i;
+        i = skip_components_win32_(path, i, 1);
+
+        // Handle verbatim UNC paths (e.g. "\\?\UNC\server\share").
+        if (equals_win32_insensitive(path.substr(nameIndex, i - nameIndex), "unc"sv))
+        {
+            return skip_components_win32_(path, i, 2);
+        }
+    }
+
+    // Handle UNC paths (e.g. "\\server\share").
+    else if (i == 2 && path[0] == '\\' && path[1] == '\\')
+    {
+        return skip_components_win32_(path, i, 2);
+    }
+
+    // Handle drive letters, along with their root directory if any (e.g. "C:\").
+    if (path[i - 1] == ':')
+    {
+        return (i < path.size() && is_separator_win32(path[i])) ? (i + 1) : i;
+    }
+
+    // Handle device names (e.g. "\\.\COM1").
+    return (path[0] == '\\' && path[1] == '\\') ? i : 0;
 }
 
-component_iterator_win32::component_iterator_win32(std::string_view path)
-    : path_(path.data())
-    , curComponentLen_(path.empty() ? 0 : get_initial_component_length_(path_))
+template<typename String>
+static bool relative_win32_(std::string_view from, std::string_view to, String& result)
 {
+    result.clear();
+
+    // We can't compute a relative path unless both paths share the same root.
+    const std::size_t rootLen = get_root_length_win32_(from);
+    const std::size_t prefixLen = common_prefix_win32(from, to).size();
+
+    if (rootLen != get_root_length_win32_(to) || prefixLen < rootLen)
+    {
+        return false;
+    }
+
+    // Skip over the components both paths share.
+    from.remove_prefix(prefixLen);
+    from.remove_prefix(get_leading_separator_count_win32_(from));
+
+    to.remove_prefix(prefixLen);
+    to.remove_prefix(get_leading_separator_count_win32_(to));
+
+    // Go up one directory for every remaining component in the base path.
+    for (const auto comp : components_win32(from))
+    {
+        if (comp == "."sv)
+        {
+            continue;
+        }
+
+        // NOTE: We can't know which directory to go back into after ".." without
+        // accessing the file system, so we just treat this as an error.
+        if (comp == ".."sv)
+        {
+            result.clear();
+            return false;
+        }
+
+        if (!result.empty())
+        {
+            result += '\\';
+        }
+
+        result += ".."sv;
+    }
+
+    // Go down into the remaining components in the target path.
+    if (!to.empty())
+    {
+        if (!result.empty())
+        {
+            result += '\\';
+        }
+
+        result += to;
+    }
+
+    if (result.empty())
+    {
+        result += '.';
+    }
+
+    return true;
 }
 
-component_iterator_win32 get_begin_win32(const char* path)
+bool relative_win32(std::string_view from, std::string_view to, std::string& result)
 {
-    return component_iterator_win32(path);
+    return relative_win32_(from, to, result);
 }
 
-component_iterator_win32 get_begin_win32(const std::string& path)
+bool relative_win32(std::string_view from, std::string_view to, rad::string& result)
 {
-    return component_iterator_win32(path);
+    return relative_win32_(from, to, result);
 }
 
-component_iterator_win32 get_begin_win32(std::string_view path)
+// NOTE: These functions used to be exported from libRad, before they were made
+// constexpr (see rad_path_win32.h), so they're kept as thin wrappers around the
+// new versions, for binaries which were built against older versions of libRad.
+// They must stay at the end of this file, as unqualified calls to any of these
+// functions would otherwise be ambiguous.
+RAD_API bool has_trailing_separator_win32(std::string_view path) noexcept
 {
-    return component_iterator_win32(path);
+    return v2::has_trailing_separator_win32(path);
 }
 
-component_iterator_win32 get_end_win32(const char* path)
+RAD_API bool has_leading_separator_win32(std::string_view path) noexcept
 {
-    return component_iterator_win32(path + std::strlen(path));
+    return v2::has_leading_separator_win32(path);
 }
 
-component_iterator_win32 get_end_win32(const std::string& path)
+RAD_API std::string_view get_no_trailing_separator_path_win32(std::string_view path) noexcept
 {
-    return component_iterator_win32(path.c_str() + path.size());
+    return v2::get_no_trailing_separator_path_win32(path);
 }
 
-component_iterator_win32 get_end_win32(std::string_view path)
+RAD_API std::string_view get_name_win32(std::string_view path) noexcept
 {
-    return ((path.empty()) ?
-        component_iterator_win32() :
-        component_iterator_win32(path.data() + path.size())
-    );
+    return v2::get_name_win32(path);
 }
 
-component_iterators_win32::component_iterators_win32(
-    component_iterator_win32 begin,
-    component_iterator_win32 end) noexcept
-    : begin_(begin)
-    , end_(end)
+RAD_API std::string_view get_extensions_win32(std::string_view path) noexcept
 {
+    return v2::get_extensions_win32(path);
 }
 
-component_iterators_win32 components_win32(const char* path)
+RAD_API std::string_view get_parent_win32(std::string_view path) noexcept
 {
-    return component_iterators_win32(
-        get_begin_win32(path),
-        get_end_win32(path)
-    );
+    return v2::get_parent_win32(path);
 }
 
-component_iterators_win32 components_win32(const std::string& path)
+RAD_API bool remove_trailing_separators_win32(std::string_view& path)
 {
-    return component_iterators_win32(
-        get_begin_win32(path),
-        get_end_win32(path)
-    );
+    return v2::remove_trailing_separators_win32(path);
 }
 
-component_iterators_win32 components_win32(std::string_view path)
+RAD_API bool remove_name_win32(std::string_view& path)
 {
-    return component_iterators_win32(
-        get_begin_win32(path),
-        get_end_win32(path)
-    );
+    return v2::remove_name_win32(path);
 }
 }
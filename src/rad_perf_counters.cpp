@@ -0,0 +1,109 @@
+/// @file rad_perf_counters.cpp
+/// @author Graham Scott
+/// @brief Platform-independent implementation of rad_perf_counters.h
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_perf_counters.h"
+#include <cstring>
+
+namespace rad
+{
+const char* get_perf_counter_name(perf_counter counter) noexcept
+{
+    switch (counter)
+    {
+    case perf_counter::cycles:
+        return "cycles";
+
+    case perf_counter::instructions:
+        return "instructions";
+
+    case perf_counter::cache_misses:
+        return "cache-misses";
+
+    case perf_counter::branch_misses:
+        return "branch-misses";
+
+    case perf_counter::dtlb_misses:
+        return "dtlb-misses";
+
+    default:
+        return "unknown";
+    }
+}
+
+std::size_t perf_counters::get_region_index_(const char* name)
+{
+    // NOTE: Programs typically only have a handful of regions, so a linear search is fine.
+    for (std::size_t i = 0; i < regions_.size(); ++i)
+    {
+        if (regions_[i].name == name || std::strcmp(regions_[i].name, name) == 0)
+        {
+            return i;
+        }
+    }
+
+    regions_.push_back({ name, perf_counter_values(), 0 });
+    return (regions_.size() - 1);
+}
+
+bool perf_counters::is_any_available() const noexcept
+{
+    for (const auto fd : fds_)
+    {
+        if (fd != -1)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const perf_region_stats* perf_counters::find_region(std::string_view name) const noexcept
+{
+    for (const auto& stats : regions_)
+    {
+        if (name == stats.name)
+        {
+            return &stats;
+        }
+    }
+
+    return nullptr;
+}
+
+void perf_counters::print_report(std::FILE* file) const
+{
+    std::fprintf(file, "%-32s %10s", "region", "count");
+
+    for (std::size_t i = 0; i < perf_counter_count; ++i)
+    {
+        std::fprintf(file, " %16s", get_perf_counter_name(static_cast<perf_counter>(i)));
+    }
+
+    std::fputc('\n', file);
+
+    for (const auto& stats : regions_)
+    {
+        std::fprintf(file, "%-32s %10llu", stats.name,
+            static_cast<unsigned long long>(stats.count));
+
+        for (std::size_t i = 0; i < perf_counter_count; ++i)
+        {
+            if (fds_[i] == -1)
+            {
+                std::fprintf(file, " %16s", "n/a");
+            }
+            else
+            {
+                std::fprintf(file, " %16llu",
+                    static_cast<unsigned long long>(stats.totals.values[i]));
+            }
+        }
+
+        std::fputc('\n', file);
+    }
+}
+}
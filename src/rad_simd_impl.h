@@ -0,0 +1,283 @@
+/// @file rad_simd_impl.h
+/// @author Graham Scott
+/// @brief Helper header file providing SIMD utilities for libRad implementation files.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+///
+/// Every helper in this file has a scalar fallback, so callers never
+/// have to check which instruction set is available themselves.
+
+#ifndef RAD_SIMD_IMPL_H_INCLUDED
+#define RAD_SIMD_IMPL_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifndef RAD_SIMD_HAS_SSE2
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) ||\
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define RAD_SIMD_HAS_SSE2 1
+    #else
+        #define RAD_SIMD_HAS_SSE2 0
+    #endif
+#endif
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    #include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace rad::detail_::simd
+{
+/// @brief The number of bytes processed by one iteration of the vectorized loops.
+constexpr std::size_t block_size = 16;
+
+inline unsigned int count_trailing_zeros(std::uint32_t x) noexcept
+{
+    // NOTE: x must be non-zero.
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(x));
+#endif
+}
+
+inline unsigned int count_leading_zeros(std::uint32_t x) noexcept
+{
+    // NOTE: x must be non-zero.
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, x);
+    return static_cast<unsigned int>(31 - index);
+#else
+    return static_cast<unsigned int>(__builtin_clz(x));
+#endif
+}
+
+inline unsigned int popcount(std::uint32_t x) noexcept
+{
+#ifdef _MSC_VER
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    return static_cast<unsigned int>((((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+#else
+    return static_cast<unsigned int>(__builtin_popcount(x));
+#endif
+}
+
+inline std::uint64_t load_u64(const void* ptr) noexcept
+{
+    std::uint64_t v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+}
+
+constexpr char fold_win32_char(char c) noexcept
+{
+    // Fold ASCII upper-case letters to lower-case and backslashes to forward-slashes.
+    if (c >= 'A' && c <= 'Z')
+    {
+        return static_cast<char>(c | 0x20);
+    }
+
+    return (c == '\\') ? '/' : c;
+}
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    inline __m128i load(const void* ptr) noexcept
+    {
+        return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+    }
+
+    inline void store(void* ptr, __m128i v) noexcept
+    {
+        _mm_storeu_si128(static_cast<__m128i*>(ptr), v);
+    }
+
+    inline std::uint32_t movemask(__m128i v) noexcept
+    {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(v));
+    }
+
+    /// @brief Returns a mask with 0xFF in every byte of v which is either a or b.
+    inline __m128i cmpeq_either(__m128i v, char a, char b) noexcept
+    {
+        return _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8(a)),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8(b)));
+    }
+
+    /// @brief Vectorized equivalent of fold_win32_char.
+    inline __m128i fold_win32(__m128i v) noexcept
+    {
+        // NOTE: Bytes >= 0x80 compare as negative, so they're never
+        // treated as upper-case letters here.
+        const __m128i isUpper = _mm_and_si128(
+            _mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+
+        const __m128i isBackslash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+
+        v = _mm_or_si128(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+        return _mm_xor_si128(v, _mm_and_si128(isBackslash, _mm_set1_epi8('\\' ^ '/')));
+    }
+#endif
+
+/// @brief Returns the index of the first byte in [0, len) which is
+/// either a or b, or len if there is no such byte.
+inline std::size_t find_either(const char* str,
+    std::size_t len, char a, char b) noexcept
+{
+    std::size_t i = 0;
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    for (; (i + block_size) <= len; i += block_size)
+    {
+        const auto mask = movemask(cmpeq_either(load(str + i), a, b));
+        if (mask)
+        {
+            return (i + count_trailing_zeros(mask));
+        }
+    }
+#endif
+
+    for (; i < len; ++i)
+    {
+        if (str[i] == a || str[i] == b)
+        {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+/// @brief Returns the index of the first byte in [0, len) which is
+/// neither a nor b, or len if there is no such byte.
+inline std::size_t find_neither(const char* str,
+    std::size_t len, char a, char b) noexcept
+{
+    std::size_t i = 0;
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    for (; (i + block_size) <= len; i += block_size)
+    {
+        const auto mask = (~movemask(cmpeq_either(load(str + i), a, b)) & 0xFFFFu);
+        if (mask)
+        {
+            return (i + count_trailing_zeros(mask));
+        }
+    }
+#endif
+
+    for (; i < len; ++i)
+    {
+        if (str[i] != a && str[i] != b)
+        {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+/// @brief Returns the index of the first byte at which a and b
+/// differ, or len if the first len bytes of both are equal.
+inline std::size_t find_mismatch(const char* a,
+    const char* b, std::size_t len) noexcept
+{
+    std::size_t i = 0;
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    for (; (i + block_size) <= len; i += block_size)
+    {
+        const auto mask = (~movemask(_mm_cmpeq_epi8(
+            load(a + i), load(b + i))) & 0xFFFFu);
+
+        if (mask)
+        {
+            return (i + count_trailing_zeros(mask));
+        }
+    }
+#endif
+
+    for (; i < len; ++i)
+    {
+        if (a[i] != b[i])
+        {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+/// @brief Like find_mismatch, but compares the bytes as if
+/// they had been passed through fold_win32_char first.
+inline std::size_t find_mismatch_win32_folded(const char* a,
+    const char* b, std::size_t len) noexcept
+{
+    std::size_t i = 0;
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    for (; (i + block_size) <= len; i += block_size)
+    {
+        const auto mask = (~movemask(_mm_cmpeq_epi8(
+            fold_win32(load(a + i)), fold_win32(load(b + i)))) & 0xFFFFu);
+
+        if (mask)
+        {
+            return (i + count_trailing_zeros(mask));
+        }
+    }
+#endif
+
+    for (; i < len; ++i)
+    {
+        if (fold_win32_char(a[i]) != fold_win32_char(b[i]))
+        {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+/// @brief Copies len bytes from src to dst, replacing every
+/// byte which is either a or b with newChar along the way.
+///
+/// src and dst may be equal, but must not otherwise overlap.
+inline void replace_either_copy(const char* src, char* dst,
+    std::size_t len, char a, char b, char newChar) noexcept
+{
+    std::size_t i = 0;
+
+#if RAD_SIMD_HAS_SSE2 == 1
+    const __m128i newChars = _mm_set1_epi8(newChar);
+
+    for (; (i + block_size) <= len; i += block_size)
+    {
+        const __m128i v = load(src + i);
+        const __m128i mask = cmpeq_either(v, a, b);
+
+        store(dst + i, _mm_or_si128(
+            _mm_andnot_si128(mask, v),
+            _mm_and_si128(mask, newChars)));
+    }
+#endif
+
+    for (; i < len; ++i)
+    {
+        const char c = src[i];
+        dst[i] = (c == a || c == b) ? newChar : c;
+    }
+}
+}
+
+#endif
@@ -0,0 +1,89 @@
+/// @file rad_sort.cpp
+/// @author Graham Scott
+/// @brief Implementation of rad_sort.h
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_sort.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <system_error>
+
+namespace rad
+{
+namespace detail_
+{
+std::size_t get_hardware_thread_count_() noexcept
+{
+    const auto threadCount = std::thread::hardware_concurrency();
+    return (threadCount) ? threadCount : 1;
+}
+
+void run_parallel_tasks_(std::size_t taskCount, std::size_t threadCount,
+    parallel_task_func_ func, void* userData)
+{
+    if (taskCount == 0)
+    {
+        return;
+    }
+
+    std::atomic<std::size_t> nextTask(0);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    auto runTasks = [&]()
+    {
+        std::size_t taskIndex;
+        while ((taskIndex = nextTask.fetch_add(1, std::memory_order_relaxed)) < taskCount)
+        {
+            try
+            {
+                func(userData, taskIndex);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        }
+    };
+
+    // Start the worker threads.
+    // NOTE: The calling thread runs tasks too, so it counts as one of the threads.
+    vector<std::thread> threads;
+    const auto workerCount = ((std::min)(threadCount, taskCount) - 1);
+
+    try
+    {
+        threads.reserve(workerCount);
+
+        for (std::size_t i = 0; i < workerCount; ++i)
+        {
+            threads.emplace_back(runTasks);
+        }
+    }
+    catch (const std::system_error&)
+    {
+        // NOTE: If we can't start every thread we asked for,
+        // we just run the tasks with the threads we've got.
+    }
+
+    runTasks();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+}
+}
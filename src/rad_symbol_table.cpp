@@ -0,0 +1,362 @@
+/// @file rad_symbol_table.cpp
+/// @author Graham Scott
+/// @brief Implementation of rad_symbol_table.h
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_symbol_table.h"
+#include "rad_memory.h"
+#include <mutex>
+#include <limits>
+#include <stdexcept>
+#include <new>
+#include <cstring>
+
+namespace rad
+{
+namespace
+{
+    // NOTE: Must be a power of 2.
+    constexpr std::size_t shard_bit_count_ = 4;
+    constexpr std::size_t shard_count_ = (std::size_t(1) << shard_bit_count_);
+
+    constexpr std::size_t arena_chunk_size_ = 16384;
+    constexpr std::uint32_t initial_index_capacity_ = 256;
+
+    struct arena_chunk_
+    {
+        arena_chunk_*   next;
+    };
+
+    /// @brief An open-addressing hash index which maps strings to symbols.
+    ///
+    /// Each slot holds the string's hash in its upper 32 bits, and the symbol in its
+    /// lower 32 bits, or is 0 if empty (the empty string is never stored in an index).
+    /// Slots are stored right after this header, within the same allocation.
+    struct index_
+    {
+        index_*         previous;
+        std::uint32_t   mask;
+        std::uint32_t   count;
+
+        inline std::atomic<std::uint64_t>* slots() noexcept
+        {
+            return reinterpret_cast<std::atomic<std::uint64_t>*>(this + 1);
+        }
+    };
+
+    index_* create_index_(std::uint32_t capacity, index_* previous)
+    {
+        const auto mem = RAD_ALLOC(sizeof(index_) +
+            (sizeof(std::atomic<std::uint64_t>) * capacity));
+
+        if (!mem)
+        {
+            throw std::bad_alloc();
+        }
+
+        const auto index = ::new (mem) index_{ previous, capacity - 1, 0 };
+        const auto slots = index->slots();
+
+        for (std::uint32_t i = 0; i < capacity; ++i)
+        {
+            ::new (&slots[i]) std::atomic<std::uint64_t>(0);
+        }
+
+        return index;
+    }
+
+    void insert_into_index_(index_& index, std::uint32_t hash, symbol sym) noexcept
+    {
+        const auto slots = index.slots();
+        auto i = (hash & index.mask);
+
+        while (slots[i].load(std::memory_order_relaxed))
+        {
+            i = ((i + 1) & index.mask);
+        }
+
+        // NOTE: The entry this symbol refers to has already been written, so we use a
+        // release store here to make it visible to any thread which finds this slot.
+        slots[i].store((static_cast<std::uint64_t>(hash) << 32) | sym.value(),
+            std::memory_order_release);
+
+        ++index.count;
+    }
+
+    std::uint32_t hash_symbol_string_(std::string_view str) noexcept
+    {
+        const std::uint64_t hash = std::hash<std::string_view>()(str);
+        return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+    }
+
+    std::size_t get_shard_index_(std::uint32_t hash) noexcept
+    {
+        // NOTE: We pick shards via the upper bits of the hash, as the
+        // lower bits are used to pick slots within each shard's index.
+        return (hash >> (32 - shard_bit_count_));
+    }
+}
+
+struct symbol_table::shard_
+{
+    std::mutex              mutex;
+    std::atomic<index_*>    index;
+    arena_chunk_*           chunks = nullptr;
+    char*                   chunkPos = nullptr;
+    std::size_t             chunkRemaining = 0;
+
+    /// @brief Copies the given string into this shard's arena, null-terminated.
+    const char* copy_to_arena(std::string_view str)
+    {
+        const auto len = (str.size() + 1);
+        char* dst;
+
+        if (len > chunkRemaining)
+        {
+            // NOTE: Large strings are given a chunk of their own, so
+            // that they don't waste the rest of the current chunk.
+            const bool isLarge = (len > (arena_chunk_size_ / 4));
+            const auto chunkSize = (isLarge) ? len : arena_chunk_size_;
+            const auto chunk = static_cast<arena_chunk_*>(
+                RAD_ALLOC(sizeof(arena_chunk_) + chunkSize));
+
+            if (!chunk)
+            {
+                throw std::bad_alloc();
+            }
+
+            chunk->next = chunks;
+            chunks = chunk;
+            dst = reinterpret_cast<char*>(chunk + 1);
+
+            if (!isLarge)
+            {
+                chunkPos = (dst + len);
+                chunkRemaining = (chunkSize - len);
+            }
+        }
+        else
+        {
+            dst = chunkPos;
+            chunkPos += len;
+            chunkRemaining -= len;
+        }
+
+        std::memcpy(dst, str.data(), str.size());
+        dst[str.size()] = '\0';
+
+        return dst;
+    }
+
+    shard_()
+        : index(create_index_(initial_index_capacity_, nullptr))
+    {
+    }
+
+    ~shard_()
+    {
+        auto idx = index.load(std::memory_order_relaxed);
+        while (idx)
+        {
+            const auto previous = idx->previous;
+            RAD_FREE(idx);
+            idx = previous;
+        }
+
+        while (chunks)
+        {
+            const auto next = chunks->next;
+            RAD_FREE(chunks);
+            chunks = next;
+        }
+    }
+};
+
+detail_::symbol_table_entry_& symbol_table::create_entry_(symbol sym)
+{
+    const auto index = (static_cast<std::uint64_t>(sym.value()) +
+        (std::uint64_t(1) << first_page_bit_count_));
+
+    const auto pageIndex = get_page_index_(index);
+    auto page = pages_[pageIndex].load(std::memory_order_acquire);
+
+    if (!page)
+    {
+        // NOTE: Several shards may try to create the same page at once,
+        // in which case, whichever shard loses the race frees its page.
+        const auto pageSize = get_page_size_(pageIndex);
+        const auto newPage = static_cast<detail_::symbol_table_entry_*>(
+            RAD_ALLOC(sizeof(detail_::symbol_table_entry_) * pageSize));
+
+        if (!newPage)
+        {
+            throw std::bad_alloc();
+        }
+
+        if (pages_[pageIndex].compare_exchange_strong(page, newPage,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            page = newPage;
+        }
+        else
+        {
+            RAD_FREE(newPage);
+        }
+    }
+
+    return page[index - get_page_size_(pageIndex)];
+}
+
+bool symbol_table::try_find_(shard_& shard, std::string_view str,
+    std::uint32_t hash, symbol& sym) const noexcept
+{
+    const auto index = shard.index.load(std::memory_order_acquire);
+    const auto slots = index->slots();
+    auto i = (hash & index->mask);
+
+    while (true)
+    {
+        const auto slot = slots[i].load(std::memory_order_acquire);
+        if (!slot)
+        {
+            return false;
+        }
+
+        if (static_cast<std::uint32_t>(slot >> 32) == hash)
+        {
+            const symbol slotSym(static_cast<std::uint32_t>(slot));
+            if (get_view(slotSym) == str)
+            {
+                sym = slotSym;
+                return true;
+            }
+        }
+
+        i = ((i + 1) & index->mask);
+    }
+}
+
+symbol symbol_table::intern(std::string_view str)
+{
+    if (str.empty())
+    {
+        return symbol();
+    }
+
+    const auto hash = hash_symbol_string_(str);
+    auto& shard = shards_[get_shard_index_(hash)];
+    symbol sym;
+
+    // Return the existing symbol if this string has already been interned.
+    if (try_find_(shard, str, hash, sym))
+    {
+        return sym;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // NOTE: Another thread may have interned the same string
+    // before we took the lock, so we have to check again.
+    if (try_find_(shard, str, hash, sym))
+    {
+        return sym;
+    }
+
+    // Grow the shard's index if necessary, keeping it at most half-full.
+    auto index = shard.index.load(std::memory_order_relaxed);
+    if (index->count >= ((index->mask + 1) / 2))
+    {
+        const auto newIndex = create_index_((index->mask + 1) * 2, index);
+        const auto oldSlots = index->slots();
+
+        for (std::uint32_t i = 0; i <= index->mask; ++i)
+        {
+            const auto slot = oldSlots[i].load(std::memory_order_relaxed);
+            if (slot)
+            {
+                insert_into_index_(*newIndex, static_cast<std::uint32_t>(slot >> 32),
+                    symbol(static_cast<std::uint32_t>(slot)));
+            }
+        }
+
+        shard.index.store(newIndex, std::memory_order_release);
+        index = newIndex;
+    }
+
+    // Reserve a new symbol.
+    auto symValue = symbolCount_.load(std::memory_order_relaxed);
+    do
+    {
+        if (symValue == (std::numeric_limits<std::uint32_t>::max)())
+        {
+            throw std::length_error(
+                "The symbol table cannot hold any more symbols"
+            );
+        }
+    }
+    while (!symbolCount_.compare_exchange_weak(symValue, symValue + 1,
+        std::memory_order_relaxed));
+
+    sym = symbol(symValue);
+
+    // Copy the string into the arena, and publish the new symbol.
+    auto& entry = create_entry_(sym);
+    entry.data = shard.copy_to_arena(str);
+    entry.size = str.size();
+
+    insert_into_index_(*index, hash, sym);
+    return sym;
+}
+
+bool symbol_table::try_find(symbol& sym, std::string_view str) const noexcept
+{
+    if (str.empty())
+    {
+        sym = symbol();
+        return true;
+    }
+
+    const auto hash = hash_symbol_string_(str);
+    return try_find_(shards_[get_shard_index_(hash)], str, hash, sym);
+}
+
+symbol_table::symbol_table()
+    : symbolCount_(1)
+    , shards_(RAD_NEW(shard_)[shard_count_])
+{
+    for (auto& page : pages_)
+    {
+        page.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // Setup the empty string, which is always symbol 0.
+    try
+    {
+        auto& entry = create_entry_(symbol());
+        entry.data = "";
+        entry.size = 0;
+    }
+    catch (...)
+    {
+        delete[] shards_;
+        throw;
+    }
+}
+
+symbol_table::~symbol_table()
+{
+    delete[] shards_;
+
+    for (auto& page : pages_)
+    {
+        RAD_FREE(page.load(std::memory_order_relaxed));
+    }
+}
+
+symbol_table& get_global_symbol_table()
+{
+    static symbol_table table;
+    return table;
+}
+}
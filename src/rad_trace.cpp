@@ -0,0 +1,390 @@
+/// @file rad_trace.cpp
+/// @author Graham Scott
+/// @brief Implementation of rad_trace.h
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_trace.h"
+
+#if RAD_USE_TRACING == 1
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// NOTE: The number of events kept in each thread's ring buffer; older events are overwritten.
+#ifndef RAD_TRACE_EVENTS_PER_THREAD
+    #define RAD_TRACE_EVENTS_PER_THREAD 65536
+#endif
+
+namespace rad::trace
+{
+namespace detail_
+{
+    std::atomic<bool> isRecording_(false);
+
+    std::atomic<bool> isRecordingAllocations_(false);
+}
+
+namespace
+{
+    struct event_
+    {
+        /// @brief The name of the zone, or nullptr if this is an allocation counter event.
+        const char*     name;
+
+        /// @brief The timestamp, in nanoseconds. For zones, this is the start time.
+        std::uint64_t   timestamp;
+
+        /// @brief Zones: the duration, in nanoseconds.
+        /// Allocations: the net number of allocations made since recording began.
+        std::uint64_t   value1;
+
+        /// @brief Zones: unused.
+        /// Allocations: the total number of bytes allocated since recording began.
+        std::uint64_t   value2;
+    };
+
+    enum class buffer_state_ : std::uint8_t
+    {
+        /// @brief The buffer is owned by a running thread.
+        in_use,
+
+        /// @brief The buffer's thread has exited, but its events haven't
+        /// been written out (or cleared) yet, so it mustn't be reused.
+        exited,
+
+        /// @brief The buffer's thread has exited, and its events have been
+        /// written out (or cleared), so it can be reused by a new thread.
+        reusable
+    };
+
+    struct thread_buffer_
+    {
+        thread_buffer_*             next;
+        std::uint32_t               threadID;
+        char                        threadName[64];
+        std::atomic<std::uint64_t>  writeCount;
+        std::atomic<buffer_state_>  state;
+        event_                      events[RAD_TRACE_EVENTS_PER_THREAD];
+    };
+
+    /// @brief A lock-free singly-linked list of every thread's buffer.
+    std::atomic<thread_buffer_*>    buffers_(nullptr);
+    std::atomic<std::uint32_t>      nextThreadID_(1);
+    std::atomic<std::uint64_t>      baseTimestamp_(0);
+    std::atomic<std::int64_t>       netAllocationCount_(0);
+    std::atomic<std::uint64_t>      allocatedByteCount_(0);
+
+    thread_local thread_buffer_*    threadBuffer_ = nullptr;
+    thread_local bool               hasThreadExited_ = false;
+
+    /// @brief Releases the current thread's buffer when the thread exits, so that
+    /// it can be reused by a new thread once its events have been written out.
+    struct thread_buffer_releaser_
+    {
+        thread_buffer_* buffer = nullptr;
+
+        ~thread_buffer_releaser_()
+        {
+            // NOTE: Events recorded after this point (e.g. by other thread_local
+            // destructors) are dropped, rather than acquiring another buffer.
+            hasThreadExited_ = true;
+            threadBuffer_ = nullptr;
+
+            if (buffer)
+            {
+                // NOTE: Buffers without any events can be reused straight away.
+                const auto newState = (buffer->writeCount.load(std::memory_order_relaxed) == 0) ?
+                    buffer_state_::reusable : buffer_state_::exited;
+
+                buffer->state.store(newState, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local thread_buffer_releaser_ threadBufferReleaser_;
+
+    /// @brief Atomically changes the state of the given buffer from one state to another.
+    /// @return true if the buffer was in the given state, and so was changed.
+    bool change_buffer_state_(thread_buffer_& buffer,
+        buffer_state_ from, buffer_state_ to) noexcept
+    {
+        return (buffer.state.load(std::memory_order_relaxed) == from &&
+            buffer.state.compare_exchange_strong(from, to,
+                std::memory_order_acq_rel, std::memory_order_relaxed));
+    }
+
+    /// @brief Returns the buffer of a thread which has exited, and whose events have
+    /// been written out (or cleared), or nullptr if there isn't one.
+    thread_buffer_* reuse_thread_buffer_() noexcept
+    {
+        for (auto buffer = buffers_.load(std::memory_order_acquire);
+            buffer; buffer = buffer->next)
+        {
+            if (change_buffer_state_(*buffer, buffer_state_::reusable, buffer_state_::in_use))
+            {
+                buffer->writeCount.store(0, std::memory_order_relaxed);
+                buffer->threadName[0] = '\0';
+                return buffer;
+            }
+        }
+
+        return nullptr;
+    }
+
+    thread_buffer_* create_thread_buffer_() noexcept
+    {
+        // NOTE: We purposefully allocate via calloc rather than RAD_ALLOC, so that
+        // creating a buffer can't recursively record an allocation event. Buffers
+        // are never freed, as write_chrome_json may be walking the list of buffers
+        // concurrently; instead, the buffers of exited threads are reused once their
+        // events have been written out (or cleared), so the number of buffers is
+        // bounded by the number of threads which have recorded events since then.
+        const auto buffer = static_cast<thread_buffer_*>(
+            std::calloc(1, sizeof(thread_buffer_)));
+
+        if (!buffer)
+        {
+            return nullptr;
+        }
+
+        new (&buffer->writeCount) std::atomic<std::uint64_t>(0);
+        new (&buffer->state) std::atomic<buffer_state_>(buffer_state_::in_use);
+
+        // Add the buffer to the list of buffers.
+        auto head = buffers_.load(std::memory_order_relaxed);
+
+        do
+        {
+            buffer->next = head;
+        }
+        while (!buffers_.compare_exchange_weak(head, buffer,
+            std::memory_order_release, std::memory_order_relaxed));
+
+        return buffer;
+    }
+
+    thread_buffer_* get_thread_buffer_() noexcept
+    {
+        if (threadBuffer_)
+        {
+            return threadBuffer_;
+        }
+
+        if (hasThreadExited_)
+        {
+            return nullptr;
+        }
+
+        auto buffer = reuse_thread_buffer_();
+
+        if (!buffer)
+        {
+            buffer = create_thread_buffer_();
+
+            if (!buffer)
+            {
+                return nullptr;
+            }
+        }
+
+        buffer->threadID = nextThreadID_.fetch_add(1, std::memory_order_relaxed);
+        threadBufferReleaser_.buffer = buffer;
+        threadBuffer_ = buffer;
+        return buffer;
+    }
+
+    void push_event_(const event_& e) noexcept
+    {
+        const auto buffer = get_thread_buffer_();
+        if (!buffer)
+        {
+            return;
+        }
+
+        // NOTE: Only the owning thread ever writes to its buffer, so no atomic
+        // read-modify-write operations are required; just publish the new count.
+        const auto index = buffer->writeCount.load(std::memory_order_relaxed);
+        buffer->events[index % RAD_TRACE_EVENTS_PER_THREAD] = e;
+        buffer->writeCount.store(index + 1, std::memory_order_release);
+    }
+
+    void write_json_string_(std::FILE* file, const char* str)
+    {
+        std::fputc('"', file);
+
+        for (; *str; ++str)
+        {
+            if (*str == '"' || *str == '\\')
+            {
+                std::fputc('\\', file);
+                std::fputc(*str, file);
+            }
+            else if (static_cast<unsigned char>(*str) < 0x20)
+            {
+                std::fprintf(file, "\\u%04x", static_cast<unsigned int>(*str));
+            }
+            else
+            {
+                std::fputc(*str, file);
+            }
+        }
+
+        std::fputc('"', file);
+    }
+
+    void write_json_timestamp_(std::FILE* file, std::uint64_t nanoseconds)
+    {
+        // NOTE: The Chrome trace event format uses (fractional) microseconds.
+        std::fprintf(file, "%llu.%03u",
+            static_cast<unsigned long long>(nanoseconds / 1000),
+            static_cast<unsigned int>(nanoseconds % 1000));
+    }
+}
+
+namespace detail_
+{
+    std::uint64_t get_timestamp_() noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void record_zone_(const char* name,
+        std::uint64_t startTimestamp, std::uint64_t endTimestamp) noexcept
+    {
+        push_event_({ name, startTimestamp, endTimestamp - startTimestamp, 0 });
+    }
+
+    void record_allocation_(std::ptrdiff_t countDelta, std::size_t size) noexcept
+    {
+        const auto netCount = netAllocationCount_.fetch_add(
+            countDelta, std::memory_order_relaxed) + countDelta;
+
+        const auto byteCount = allocatedByteCount_.fetch_add(
+            size, std::memory_order_relaxed) + size;
+
+        push_event_({ nullptr, get_timestamp_(),
+            static_cast<std::uint64_t>(netCount), byteCount });
+    }
+}
+
+void start_recording(bool recordAllocations) noexcept
+{
+    std::uint64_t expectedBase = 0;
+    baseTimestamp_.compare_exchange_strong(expectedBase, detail_::get_timestamp_());
+
+    detail_::isRecordingAllocations_.store(recordAllocations, std::memory_order_relaxed);
+    detail_::isRecording_.store(true, std::memory_order_relaxed);
+}
+
+void stop_recording() noexcept
+{
+    detail_::isRecording_.store(false, std::memory_order_relaxed);
+    detail_::isRecordingAllocations_.store(false, std::memory_order_relaxed);
+}
+
+void set_thread_name(const char* name) noexcept
+{
+    const auto buffer = get_thread_buffer_();
+    if (!buffer)
+    {
+        return;
+    }
+
+    std::strncpy(buffer->threadName, name, sizeof(buffer->threadName) - 1);
+}
+
+void clear() noexcept
+{
+    for (auto buffer = buffers_.load(std::memory_order_acquire);
+        buffer; buffer = buffer->next)
+    {
+        buffer->writeCount.store(0, std::memory_order_relaxed);
+        change_buffer_state_(*buffer, buffer_state_::exited, buffer_state_::reusable);
+    }
+
+    baseTimestamp_.store(0, std::memory_order_relaxed);
+    netAllocationCount_.store(0, std::memory_order_relaxed);
+    allocatedByteCount_.store(0, std::memory_order_relaxed);
+}
+
+bool write_chrome_json(const char* filePath)
+{
+    const auto file = std::fopen(filePath, "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    const auto baseTimestamp = baseTimestamp_.load(std::memory_order_relaxed);
+    bool isFirstEvent = true;
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    for (auto buffer = buffers_.load(std::memory_order_acquire);
+        buffer; buffer = buffer->next)
+    {
+        // Write thread name metadata.
+        if (buffer->threadName[0])
+        {
+            std::fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                "\"tid\":%u,\"args\":{\"name\":", isFirstEvent ? "" : ",",
+                static_cast<unsigned int>(buffer->threadID));
+
+            write_json_string_(file, buffer->threadName);
+            std::fprintf(file, "}}");
+
+            isFirstEvent = false;
+        }
+
+        // Write events, starting from the oldest event which hasn't been overwritten.
+        const auto writeCount = buffer->writeCount.load(std::memory_order_acquire);
+        const auto firstIndex = (writeCount > RAD_TRACE_EVENTS_PER_THREAD) ?
+            (writeCount - RAD_TRACE_EVENTS_PER_THREAD) : 0;
+
+        for (auto i = firstIndex; i < writeCount; ++i)
+        {
+            const auto& e = buffer->events[i % RAD_TRACE_EVENTS_PER_THREAD];
+            const auto timestamp = (e.timestamp > baseTimestamp) ?
+                (e.timestamp - baseTimestamp) : 0;
+
+            std::fprintf(file, "%s\n{", isFirstEvent ? "" : ",");
+
+            if (e.name)
+            {
+                std::fprintf(file, "\"name\":");
+                write_json_string_(file, e.name);
+                std::fprintf(file, ",\"cat\":\"rad\",\"ph\":\"X\",\"ts\":");
+                write_json_timestamp_(file, timestamp);
+                std::fprintf(file, ",\"dur\":");
+                write_json_timestamp_(file, e.value1);
+            }
+            else
+            {
+                std::fprintf(file, "\"name\":\"allocations\",\"ph\":\"C\",\"ts\":");
+                write_json_timestamp_(file, timestamp);
+                std::fprintf(file, ",\"args\":{\"live\":%lld,\"allocated_bytes\":%llu}",
+                    static_cast<long long>(e.value1),
+                    static_cast<unsigned long long>(e.value2));
+            }
+
+            std::fprintf(file, ",\"pid\":1,\"tid\":%u}",
+                static_cast<unsigned int>(buffer->threadID));
+
+            isFirstEvent = false;
+        }
+
+        // Now that its events have been written out, the buffer
+        // of a thread which has exited can be reused.
+        change_buffer_state_(*buffer, buffer_state_::exited, buffer_state_::reusable);
+    }
+
+    std::fprintf(file, "\n]}\n");
+    return (std::fclose(file) == 0);
+}
+}
+
+#endif
@@ -0,0 +1,395 @@
+/// @file rad_utf.cpp
+/// @author Graham Scott
+/// @brief Implementation of rad_utf.h
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_utf.h"
+#include "rad_simd_impl.h"
+
+namespace rad
+{
+namespace
+{
+    constexpr std::uint64_t ascii_high_bits_ = 0x8080808080808080ull;
+
+    /// @brief Returns the number of leading bytes of src which are ASCII.
+    std::size_t get_ascii_prefix_length_(const unsigned char* src, std::size_t len) noexcept
+    {
+        using namespace detail_::simd;
+        std::size_t i = 0;
+
+    #if RAD_SIMD_HAS_SSE2 == 1
+        // Check 32 bytes per iteration.
+        for (; (i + (block_size * 2)) <= len; i += (block_size * 2))
+        {
+            if (movemask(_mm_or_si128(load(src + i), load(src + i + block_size))))
+            {
+                break;
+            }
+        }
+    #endif
+
+        for (; (i + 8) <= len; i += 8)
+        {
+            if (load_u64(src + i) & ascii_high_bits_)
+            {
+                break;
+            }
+        }
+
+        while (i < len && src[i] < 0x80)
+        {
+            ++i;
+        }
+
+        return i;
+    }
+
+    /// @brief Decodes the non-ASCII UTF-8 sequence at the beginning of src.
+    /// @return The number of bytes in the sequence, or 0 if it is not valid.
+    std::size_t decode_utf8_sequence_(const unsigned char* src,
+        std::size_t len, char32_t& codePoint) noexcept
+    {
+        const unsigned char lead = src[0];
+
+        // Two-byte sequences (NOTE: 0xC0 and 0xC1 would always be overlong).
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            if (len < 2 || (src[1] & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+
+            codePoint = (((lead & 0x1Fu) << 6) | (src[1] & 0x3Fu));
+            return 2;
+        }
+
+        // Three-byte sequences.
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            if (len < 3)
+            {
+                return 0;
+            }
+
+            // Reject overlong sequences (0xE0) and surrogates (0xED).
+            const unsigned char min = (lead == 0xE0) ? 0xA0 : 0x80;
+            const unsigned char max = (lead == 0xED) ? 0x9F : 0xBF;
+
+            if (src[1] < min || src[1] > max || (src[2] & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+
+            codePoint = (((lead & 0x0Fu) << 12) |
+                ((src[1] & 0x3Fu) << 6) | (src[2] & 0x3Fu));
+
+            return 3;
+        }
+
+        // Four-byte sequences.
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            if (len < 4)
+            {
+                return 0;
+            }
+
+            // Reject overlong sequences (0xF0) and code points above U+10FFFF (0xF4).
+            const unsigned char min = (lead == 0xF0) ? 0x90 : 0x80;
+            const unsigned char max = (lead == 0xF4) ? 0x8F : 0xBF;
+
+            if (src[1] < min || src[1] > max ||
+                (src[2] & 0xC0) != 0x80 || (src[3] & 0xC0) != 0x80)
+            {
+                return 0;
+            }
+
+            codePoint = (((lead & 0x07u) << 18) | ((src[1] & 0x3Fu) << 12) |
+                ((src[2] & 0x3Fu) << 6) | (src[3] & 0x3Fu));
+
+            return 4;
+        }
+
+        // Continuation bytes and invalid lead bytes.
+        return 0;
+    }
+
+    /// @brief Decodes the non-ASCII UTF-16 sequence at the beginning of src.
+    /// @return The number of code units in the sequence, or 0 if it is not valid.
+    std::size_t decode_utf16_sequence_(const char16_t* src,
+        std::size_t len, char32_t& codePoint) noexcept
+    {
+        const char32_t unit = src[0];
+
+        // Non-surrogates.
+        if (unit < 0xD800 || unit > 0xDFFF)
+        {
+            codePoint = unit;
+            return 1;
+        }
+
+        // Surrogate pairs (NOTE: lone surrogates are rejected).
+        if (unit <= 0xDBFF && len >= 2 &&
+            src[1] >= 0xDC00 && src[1] <= 0xDFFF)
+        {
+            codePoint = (0x10000 + ((unit - 0xD800) << 10) +
+                (static_cast<char32_t>(src[1]) - 0xDC00));
+
+            return 2;
+        }
+
+        return 0;
+    }
+
+    constexpr std::size_t get_utf8_sequence_length_(char32_t codePoint) noexcept
+    {
+        return (codePoint < 0x80) ? 1 :
+            (codePoint < 0x800) ? 2 :
+            (codePoint < 0x10000) ? 3 : 4;
+    }
+}
+
+std::size_t get_utf16_length_from_utf8(std::string_view src) noexcept
+{
+    const auto str = reinterpret_cast<const unsigned char*>(src.data());
+    const std::size_t len = src.size();
+    std::size_t i = 0, dstLen = 0;
+
+    while (i < len)
+    {
+        // Skip over ASCII characters in bulk; each of them
+        // maps to exactly one UTF-16 code unit.
+        const std::size_t asciiLen = get_ascii_prefix_length_(str + i, len - i);
+
+        i += asciiLen;
+        dstLen += asciiLen;
+
+        // Handle non-ASCII characters one at a time until we find another ASCII character.
+        while (i < len && str[i] >= 0x80)
+        {
+            char32_t codePoint;
+            const std::size_t seqLen = decode_utf8_sequence_(str + i, len - i, codePoint);
+
+            if (!seqLen)
+            {
+                return invalid_utf_length;
+            }
+
+            i += seqLen;
+            dstLen += (seqLen == 4) ? 2 : 1;
+        }
+    }
+
+    return dstLen;
+}
+
+std::size_t get_utf8_length_from_utf16(std::u16string_view src) noexcept
+{
+    const char16_t* str = src.data();
+    const std::size_t len = src.size();
+    std::size_t i = 0, dstLen = 0;
+
+    while (i < len)
+    {
+    #if RAD_SIMD_HAS_SSE2 == 1
+        // Skip over blocks of 16 ASCII characters in bulk.
+        using namespace detail_::simd;
+
+        const __m128i nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xFF80));
+
+        while ((i + block_size) <= len)
+        {
+            const __m128i units = _mm_or_si128(load(str + i), load(str + i + 8));
+            if (movemask(_mm_cmpeq_epi16(_mm_and_si128(units, nonAsciiBits),
+                _mm_setzero_si128())) != 0xFFFFu)
+            {
+                break;
+            }
+
+            i += block_size;
+            dstLen += block_size;
+        }
+
+        if (i == len)
+        {
+            break;
+        }
+    #endif
+
+        // Handle one code point at a time until we reach the next block boundary.
+        do
+        {
+            char32_t codePoint;
+            const std::size_t seqLen = decode_utf16_sequence_(str + i, len - i, codePoint);
+
+            if (!seqLen)
+            {
+                return invalid_utf_length;
+            }
+
+            i += seqLen;
+            dstLen += get_utf8_sequence_length_(codePoint);
+        }
+        while (i < len && (i % detail_::simd::block_size) != 0);
+    }
+
+    return dstLen;
+}
+
+std::size_t utf8_to_utf16(std::string_view src, char16_t* dst) noexcept
+{
+    const auto str = reinterpret_cast<const unsigned char*>(src.data());
+    const std::size_t len = src.size();
+    const char16_t* const dstBegin = dst;
+    std::size_t i = 0;
+
+    while (i < len)
+    {
+    #if RAD_SIMD_HAS_SSE2 == 1
+        // Widen blocks of 16 ASCII characters in bulk.
+        using namespace detail_::simd;
+
+        while ((i + block_size) <= len)
+        {
+            const __m128i bytes = load(str + i);
+            if (movemask(bytes))
+            {
+                break;
+            }
+
+            store(dst, _mm_unpacklo_epi8(bytes, _mm_setzero_si128()));
+            store(dst + 8, _mm_unpackhi_epi8(bytes, _mm_setzero_si128()));
+
+            i += block_size;
+            dst += block_size;
+        }
+
+        if (i == len)
+        {
+            break;
+        }
+    #endif
+
+        // Handle one code point at a time until we reach the next block boundary.
+        do
+        {
+            if (str[i] < 0x80)
+            {
+                *dst++ = str[i++];
+                continue;
+            }
+
+            char32_t codePoint;
+            const std::size_t seqLen = decode_utf8_sequence_(str + i, len - i, codePoint);
+
+            if (!seqLen)
+            {
+                return invalid_utf_length;
+            }
+
+            i += seqLen;
+
+            if (codePoint < 0x10000)
+            {
+                *dst++ = static_cast<char16_t>(codePoint);
+            }
+            else
+            {
+                codePoint -= 0x10000;
+                *dst++ = static_cast<char16_t>(0xD800 + (codePoint >> 10));
+                *dst++ = static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF));
+            }
+        }
+        while (i < len && (i % detail_::simd::block_size) != 0);
+    }
+
+    return static_cast<std::size_t>(dst - dstBegin);
+}
+
+std::size_t utf16_to_utf8(std::u16string_view src, char* dst) noexcept
+{
+    const char16_t* str = src.data();
+    const std::size_t len = src.size();
+    const char* const dstBegin = dst;
+    std::size_t i = 0;
+
+    while (i < len)
+    {
+    #if RAD_SIMD_HAS_SSE2 == 1
+        // Narrow blocks of 16 ASCII characters in bulk.
+        using namespace detail_::simd;
+
+        const __m128i nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xFF80));
+
+        while ((i + block_size) <= len)
+        {
+            const __m128i units1 = load(str + i);
+            const __m128i units2 = load(str + i + 8);
+
+            if (movemask(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(units1, units2),
+                nonAsciiBits), _mm_setzero_si128())) != 0xFFFFu)
+            {
+                break;
+            }
+
+            store(dst, _mm_packus_epi16(units1, units2));
+
+            i += block_size;
+            dst += block_size;
+        }
+
+        if (i == len)
+        {
+            break;
+        }
+    #endif
+
+        // Handle one code point at a time until we reach the next block boundary.
+        do
+        {
+            const char32_t unit = str[i];
+
+            if (unit < 0x80)
+            {
+                *dst++ = static_cast<char>(unit);
+                ++i;
+                continue;
+            }
+
+            char32_t codePoint;
+            const std::size_t seqLen = decode_utf16_sequence_(str + i, len - i, codePoint);
+
+            if (!seqLen)
+            {
+                return invalid_utf_length;
+            }
+
+            i += seqLen;
+
+            if (codePoint < 0x800)
+            {
+                *dst++ = static_cast<char>(0xC0 | (codePoint >> 6));
+                *dst++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                *dst++ = static_cast<char>(0xE0 | (codePoint >> 12));
+                *dst++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *dst++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                *dst++ = static_cast<char>(0xF0 | (codePoint >> 18));
+                *dst++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                *dst++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *dst++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+        while (i < len && (i % detail_::simd::block_size) != 0);
+    }
+
+    return static_cast<std::size_t>(dst - dstBegin);
+}
+}
@@ -0,0 +1,50 @@
+/// @file rad_test.h
+/// @author Graham Scott
+/// @brief Helpers shared by libRad's regression tests.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#ifndef RAD_TEST_H_INCLUDED
+#define RAD_TEST_H_INCLUDED
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+/// @brief Checks the given condition, printing it and exiting the test if it's false.
+#define RAD_TEST_CHECK(cond)\
+    do\
+    {\
+        if (!(cond))\
+        {\
+            std::fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #cond);\
+            std::exit(EXIT_FAILURE);\
+        }\
+    }\
+    while (false)
+
+namespace rad::test
+{
+/// @brief A small deterministic pseudo-random number generator (xorshift32),
+/// so that every run of a test exercises the exact same sequence of operations.
+struct random
+{
+    std::uint32_t state = 0x12345678u;
+
+    std::uint32_t next() noexcept
+    {
+        state ^= (state << 13);
+        state ^= (state >> 17);
+        state ^= (state << 5);
+        return state;
+    }
+
+    /// @brief Returns a number within [0, bound).
+    int next(int bound) noexcept
+    {
+        return static_cast<int>(next() % static_cast<std::uint32_t>(bound));
+    }
+};
+}
+
+#endif
@@ -0,0 +1,512 @@
+/// @file rad_test_btree.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::btree_map and rad::btree_set.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_btree.h"
+#include <map>
+#include <set>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace
+{
+    /// @brief A key type whose copy constructor and copy assignment can be made to throw,
+    /// and which keeps track of how many instances of it are alive.
+    struct throwing_key
+    {
+        /// @brief The number of copies which may be made before copying throws,
+        /// or a negative number if copying should never throw.
+        static int copiesBeforeThrow;
+        static int liveCount;
+
+        int value = 0;
+
+        static void on_copy()
+        {
+            if (copiesBeforeThrow == 0)
+            {
+                throw std::runtime_error("throwing_key copy");
+            }
+
+            if (copiesBeforeThrow > 0)
+            {
+                --copiesBeforeThrow;
+            }
+        }
+
+        throwing_key() noexcept
+        {
+            ++liveCount;
+        }
+
+        throwing_key(int value) noexcept
+            : value(value)
+        {
+            ++liveCount;
+        }
+
+        throwing_key(const throwing_key& other)
+            : value(other.value)
+        {
+            on_copy();
+            ++liveCount;
+        }
+
+        throwing_key(throwing_key&& other) noexcept
+            : value(other.value)
+        {
+            ++liveCount;
+        }
+
+        throwing_key& operator=(const throwing_key& other)
+        {
+            on_copy();
+            value = other.value;
+            return *this;
+        }
+
+        throwing_key& operator=(throwing_key&& other) noexcept = default;
+
+        ~throwing_key()
+        {
+            --liveCount;
+        }
+
+        bool operator<(const throwing_key& other) const noexcept
+        {
+            return (value < other.value);
+        }
+    };
+
+    int throwing_key::copiesBeforeThrow = -1;
+    int throwing_key::liveCount = 0;
+
+    constexpr int even_key_count = 500;
+
+    /// @brief Checks that the given tree contains exactly the keys 0, 2, 4... (2 * even_key_count - 2).
+    template<typename Tree>
+    void check_even_keys(const Tree& tree)
+    {
+        RAD_TEST_CHECK(tree.size() == even_key_count);
+
+        int expectedKey = 0;
+
+        for (auto it = tree.begin(); it != tree.end(); ++it)
+        {
+            RAD_TEST_CHECK(it.key().value == expectedKey);
+            expectedKey += 2;
+        }
+
+        RAD_TEST_CHECK(expectedKey == (even_key_count * 2));
+
+        for (int key = 0; key < (even_key_count * 2); ++key)
+        {
+            RAD_TEST_CHECK((tree.find(key) != tree.end()) == ((key % 2) == 0));
+        }
+    }
+
+    /// @brief Checks that inserting a key whose copy throws leaves the tree untouched,
+    /// both when the key fits within its leaf, and when the leaf has to be split.
+    template<typename Tree, typename InsertFunc>
+    void test_throwing_key_copy(InsertFunc insertFunc)
+    {
+        Tree tree;
+
+        for (int key = 0; key < (even_key_count * 2); key += 2)
+        {
+            insertFunc(tree, key);
+        }
+
+        check_even_keys(tree);
+
+        for (int key = 1; key <= (even_key_count * 2); key += 2)
+        {
+            throwing_key::copiesBeforeThrow = 0;
+            bool threw = false;
+
+            try
+            {
+                insertFunc(tree, key);
+            }
+            catch (const std::runtime_error&)
+            {
+                threw = true;
+            }
+
+            throwing_key::copiesBeforeThrow = -1;
+
+            RAD_TEST_CHECK(threw);
+            check_even_keys(tree);
+        }
+    }
+
+    /// @brief Checks that erasing keys whose copy throws either succeeds, or throws
+    /// and leaves the tree untouched.
+    void test_throwing_key_erase()
+    {
+        rad::btree_set<throwing_key> tree;
+        std::set<int> ref;
+
+        for (int key = 0; key < (even_key_count * 2); key += 2)
+        {
+            tree.insert(throwing_key(key));
+            ref.insert(key);
+        }
+
+        bool anyThrew = false;
+
+        for (int key = 0; key < (even_key_count * 2); key += 2)
+        {
+            throwing_key::copiesBeforeThrow = 0;
+            bool threw = false;
+
+            try
+            {
+                RAD_TEST_CHECK(tree.erase(throwing_key(key)));
+                ref.erase(key);
+            }
+            catch (const std::runtime_error&)
+            {
+                threw = true;
+            }
+
+            throwing_key::copiesBeforeThrow = -1;
+            anyThrew |= threw;
+
+            RAD_TEST_CHECK(tree.size() == ref.size());
+
+            auto it = tree.begin();
+            for (const auto refKey : ref)
+            {
+                RAD_TEST_CHECK(it.key().value == refKey);
+                ++it;
+            }
+
+            RAD_TEST_CHECK(it == tree.end());
+        }
+
+        // NOTE: Erasing in order always has to borrow from the right sibling at some point.
+        RAD_TEST_CHECK(anyThrew);
+
+        for (const auto refKey : ref)
+        {
+            RAD_TEST_CHECK(tree.erase(throwing_key(refKey)));
+        }
+
+        RAD_TEST_CHECK(tree.size() == 0);
+        RAD_TEST_CHECK(tree.begin() == tree.end());
+    }
+
+    /// @brief Checks that assign_sorted doesn't leak anything if copying a key throws.
+    void test_throwing_key_assign_sorted()
+    {
+        const int liveCountBefore = throwing_key::liveCount;
+
+        {
+            rad::vector<throwing_key> keys;
+            for (int key = 0; key < even_key_count; ++key)
+            {
+                keys.push_back(throwing_key(key));
+            }
+
+            for (const int copiesBeforeThrow : { 0, 1, 50, 250, even_key_count - 1 })
+            {
+                rad::btree_set<throwing_key> tree;
+                tree.insert(throwing_key(-1));
+
+                throwing_key::copiesBeforeThrow = copiesBeforeThrow;
+                bool threw = false;
+
+                try
+                {
+                    tree.assign_sorted(keys);
+                }
+                catch (const std::runtime_error&)
+                {
+                    threw = true;
+                }
+
+                throwing_key::copiesBeforeThrow = -1;
+
+                RAD_TEST_CHECK(threw);
+                RAD_TEST_CHECK(tree.size() == 0);
+                RAD_TEST_CHECK(tree.begin() == tree.end());
+
+                // The tree must still be usable afterwards.
+                tree.assign_sorted(keys);
+                RAD_TEST_CHECK(tree.size() == keys.size());
+            }
+        }
+
+        RAD_TEST_CHECK(throwing_key::liveCount == liveCountBefore);
+    }
+
+    template<typename Key>
+    Key make_key(int i);
+
+    template<>
+    int make_key<int>(int i)
+    {
+        return i;
+    }
+
+    template<>
+    std::string make_key<std::string>(int i)
+    {
+        // NOTE: The padding keeps these strings out of the small-string buffer,
+        // so that copying them has to allocate.
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%06d", i);
+        return std::string("btree-test-key-") + buf + "-padding-padding";
+    }
+
+    template<typename Key>
+    const Key& ref_key(const Key& key)
+    {
+        return key;
+    }
+
+    template<typename Key, typename T>
+    const Key& ref_key(const std::pair<const Key, T>& item)
+    {
+        return item.first;
+    }
+
+    template<typename Key, typename T, typename Compare, std::size_t NodeBytes>
+    void insert_item(rad::btree_map<Key, T, Compare, NodeBytes>& tree,
+        std::map<Key, T>& ref, const Key& key, int value)
+    {
+        const bool inserted = tree.insert(key, value).second;
+        RAD_TEST_CHECK(inserted == ref.emplace(key, value).second);
+    }
+
+    template<typename Key, typename Compare, std::size_t NodeBytes>
+    void insert_item(rad::btree_set<Key, Compare, NodeBytes>& tree,
+        std::set<Key>& ref, const Key& key, int)
+    {
+        const bool inserted = tree.insert(key).second;
+        RAD_TEST_CHECK(inserted == ref.insert(key).second);
+    }
+
+    template<typename Tree, typename Ref, typename TreeIt, typename RefIt>
+    void check_same_item(const Tree& tree, const Ref& ref, TreeIt treeIt, RefIt refIt)
+    {
+        if (refIt == ref.end())
+        {
+            RAD_TEST_CHECK(treeIt == tree.end());
+            return;
+        }
+
+        RAD_TEST_CHECK(treeIt != tree.end());
+        RAD_TEST_CHECK(treeIt.key() == ref_key(*refIt));
+
+        if constexpr (!std::is_same_v<typename Ref::key_type, typename Ref::value_type>)
+        {
+            RAD_TEST_CHECK(treeIt.value() == refIt->second);
+        }
+    }
+
+    /// @brief Checks that the given tree matches the given std::map or std::set, both
+    /// when iterating forwards and backwards, and when looking up any of the given keys.
+    template<typename Tree, typename Ref, typename MakeKey>
+    void check_same(const Tree& tree, const Ref& ref, int keyCount, MakeKey makeKey)
+    {
+        RAD_TEST_CHECK(tree.size() == ref.size());
+
+        auto treeIt = tree.begin();
+        for (auto refIt = ref.begin(); refIt != ref.end(); ++refIt, ++treeIt)
+        {
+            check_same_item(tree, ref, treeIt, refIt);
+        }
+
+        RAD_TEST_CHECK(treeIt == tree.end());
+
+        treeIt = tree.end();
+        for (auto refIt = ref.rbegin(); refIt != ref.rend(); ++refIt)
+        {
+            --treeIt;
+            check_same_item(tree, ref, treeIt, std::prev(refIt.base()));
+        }
+
+        RAD_TEST_CHECK(treeIt == tree.begin());
+
+        for (int i = -1; i <= keyCount; ++i)
+        {
+            const auto key = makeKey(i);
+            check_same_item(tree, ref, tree.find(key), ref.find(key));
+            check_same_item(tree, ref, tree.lower_bound(key), ref.lower_bound(key));
+            check_same_item(tree, ref, tree.upper_bound(key), ref.upper_bound(key));
+            RAD_TEST_CHECK(tree.contains(key) == (ref.count(key) != 0));
+        }
+    }
+
+    /// @brief Randomly inserts and erases keys, checking the tree against the given
+    /// std::map or std::set as it goes, and then erases everything that's left.
+    template<typename Tree, typename Ref>
+    void test_random_ops()
+    {
+        using key_type = typename Ref::key_type;
+
+        constexpr int keyCount = 600;
+        const auto makeKey = [](int i) { return make_key<key_type>(i * 2); };
+
+        Tree tree;
+        Ref ref;
+        rad::test::random random;
+
+        for (int pass = 0; pass < 4; ++pass)
+        {
+            // NOTE: Even passes mostly insert, and odd passes mostly erase, so the
+            // tree repeatedly grows and shrinks by several levels.
+            const int insertChance = ((pass % 2) == 0) ? 3 : 1;
+
+            for (int op = 0; op < 3000; ++op)
+            {
+                const auto key = makeKey(random.next(keyCount));
+
+                if (random.next(4) < insertChance)
+                {
+                    insert_item(tree, ref, key, op);
+                }
+                else
+                {
+                    RAD_TEST_CHECK(tree.erase(key) == (ref.erase(key) != 0));
+                }
+
+                if ((op % 250) == 0)
+                {
+                    check_same(tree, ref, keyCount, makeKey);
+                }
+            }
+
+            check_same(tree, ref, keyCount, makeKey);
+        }
+
+        // Erase everything that's left in a random order.
+        while (!ref.empty())
+        {
+            auto refIt = ref.begin();
+            std::advance(refIt, random.next(static_cast<int>(ref.size())));
+
+            const auto key = ref_key(*refIt);
+            ref.erase(refIt);
+            RAD_TEST_CHECK(tree.erase(key));
+
+            if ((ref.size() % 50) == 0)
+            {
+                check_same(tree, ref, keyCount, makeKey);
+            }
+        }
+
+        RAD_TEST_CHECK(!tree.erase(makeKey(0)));
+        check_same(tree, ref, keyCount, makeKey);
+    }
+
+    /// @brief Checks that assign_sorted builds a valid tree for a variety of sizes,
+    /// and that the resulting tree can then be modified as usual.
+    template<typename Tree, typename Ref>
+    void test_assign_sorted()
+    {
+        using key_type = typename Ref::key_type;
+        constexpr bool hasValues = !std::is_same_v<key_type, typename Ref::value_type>;
+
+        constexpr int maxKeyCount = 2000;
+        const auto makeKey = [](int i) { return make_key<key_type>(i * 2); };
+
+        Tree tree;
+        rad::test::random random;
+
+        for (const int count : { 0, 1, 2, 3, 7, 16, 31, 64, 100, 257, 1000, maxKeyCount })
+        {
+            Ref ref;
+            rad::vector<key_type> keys;
+            rad::vector<int> values;
+
+            for (int i = 0; i < count; ++i)
+            {
+                keys.push_back(makeKey(i));
+                values.push_back(i * 3);
+
+                if constexpr (hasValues)
+                {
+                    ref.emplace(keys.back(), values.back());
+                }
+                else
+                {
+                    ref.insert(keys.back());
+                }
+            }
+
+            // NOTE: The tree isn't empty here, so this also checks that assign_sorted
+            // replaces any existing contents.
+            if constexpr (hasValues)
+            {
+                tree.assign_sorted(keys, values);
+            }
+            else
+            {
+                tree.assign_sorted(keys);
+            }
+
+            check_same(tree, ref, maxKeyCount, makeKey);
+
+            for (int op = 0; op < count; ++op)
+            {
+                const auto key = makeKey(random.next(maxKeyCount));
+
+                if (random.next(3) == 0)
+                {
+                    insert_item(tree, ref, key, op);
+                }
+                else
+                {
+                    RAD_TEST_CHECK(tree.erase(key) == (ref.erase(key) != 0));
+                }
+            }
+
+            check_same(tree, ref, maxKeyCount, makeKey);
+        }
+    }
+
+    template<typename Key, std::size_t NodeBytes>
+    void test_against_std()
+    {
+        using map_type = rad::btree_map<Key, int, std::less<Key>, NodeBytes>;
+        using set_type = rad::btree_set<Key, std::less<Key>, NodeBytes>;
+
+        test_random_ops<map_type, std::map<Key, int>>();
+        test_random_ops<set_type, std::set<Key>>();
+        test_assign_sorted<map_type, std::map<Key, int>>();
+        test_assign_sorted<set_type, std::set<Key>>();
+    }
+}
+
+int main()
+{
+    test_throwing_key_copy<rad::btree_set<throwing_key>>(
+        [](rad::btree_set<throwing_key>& tree, int key)
+        {
+            tree.insert(throwing_key(key));
+        });
+
+    test_throwing_key_copy<rad::btree_map<throwing_key, int>>(
+        [](rad::btree_map<throwing_key, int>& tree, int key)
+        {
+            tree.emplace(throwing_key(key), key);
+        });
+
+    test_throwing_key_erase();
+    test_throwing_key_assign_sorted();
+
+    test_against_std<int, 128>();
+    test_against_std<int, 256>();
+    test_against_std<std::string, 256>();
+
+    std::puts("rad_test_btree: all tests passed");
+    return EXIT_SUCCESS;
+}
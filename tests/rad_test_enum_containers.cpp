@@ -0,0 +1,312 @@
+/// @file rad_test_enum_containers.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::enum_array and rad::enum_set.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_enum_containers.h"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    enum class color { red, green, blue, alpha, count };
+
+    /// @brief An enum without a count enumerator.
+    enum class direction { north, east, south, west };
+
+    /// @brief An enum with the given number of values, which are all unnamed.
+    template<std::size_t Count>
+    struct sized
+    {
+        enum class type : std::uint8_t { count = Count };
+    };
+}
+
+namespace rad
+{
+template<>
+struct enum_count<direction> : std::integral_constant<std::size_t, 4> {};
+}
+
+namespace
+{
+    // NOTE: Every set operation, and iteration, is usable within constant expressions.
+    constexpr rad::enum_set<color> warmColors = { color::red, color::alpha };
+    static_assert(warmColors.size() == 2);
+    static_assert(warmColors.contains(color::alpha) && !warmColors.contains(color::blue));
+    static_assert(*warmColors.begin() == color::red);
+    static_assert((warmColors | rad::enum_set<color>{ color::blue }).size() == 3);
+    static_assert((~warmColors) == rad::enum_set<color>({ color::green, color::blue }));
+    static_assert(rad::enum_set<color>::all().size() == 4);
+    static_assert(sizeof(rad::enum_set<color>) == 1);
+    static_assert(sizeof(rad::enum_set<sized<33>::type>) == 8);
+    static_assert(rad::enum_array<direction, int>::size() == 4);
+
+    template<typename E>
+    E to_enum(std::size_t index)
+    {
+        return static_cast<E>(index);
+    }
+
+    template<typename E>
+    std::size_t to_index(E value)
+    {
+        return static_cast<std::size_t>(value);
+    }
+
+    template<typename E>
+    void check_same(const rad::enum_set<E>& set, const std::set<std::size_t>& ref)
+    {
+        constexpr auto count = rad::enum_count_v<E>;
+        constexpr auto wordBits = sizeof(*set.words()) * 8;
+
+        RAD_TEST_CHECK(set.size() == ref.size());
+        RAD_TEST_CHECK(set.empty() == ref.empty());
+        RAD_TEST_CHECK(static_cast<std::size_t>(std::distance(set.begin(), set.end())) == ref.size());
+
+        // Iterating yields the members in ascending order.
+        RAD_TEST_CHECK(std::equal(set.begin(), set.end(), ref.begin(), ref.end(),
+            [](E value, std::size_t index) { return (to_index(value) == index); }));
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto isMember = (ref.count(i) > 0);
+            RAD_TEST_CHECK(set.contains(to_enum<E>(i)) == isMember);
+            RAD_TEST_CHECK(static_cast<bool>((set.words()[i / wordBits] >> (i % wordBits)) & 1) == isMember);
+        }
+    }
+
+    template<typename E>
+    rad::enum_set<E> make_set(const std::set<std::size_t>& ref)
+    {
+        rad::enum_set<E> set;
+        for (const auto index : ref)
+        {
+            set.insert(to_enum<E>(index));
+        }
+
+        return set;
+    }
+
+    template<typename Operation>
+    std::set<std::size_t> apply(const std::set<std::size_t>& a, const std::set<std::size_t>& b,
+        Operation operation)
+    {
+        std::set<std::size_t> result;
+        operation(a.begin(), a.end(), b.begin(), b.end(), std::inserter(result, result.end()));
+        return result;
+    }
+
+    /// @brief Compares an enum_set against a std::set of indices across random
+    /// insertions, erasures and flips, and checks every set operation against
+    /// the equivalent std::set algorithm.
+    template<typename E>
+    void test_set()
+    {
+        constexpr auto count = rad::enum_count_v<E>;
+
+        rad::enum_set<E> set;
+        std::set<std::size_t> ref;
+        rad::test::random rng;
+
+        std::set<std::size_t> all;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            all.insert(i);
+        }
+
+        check_same(set, ref);
+        check_same(rad::enum_set<E>::all(), all);
+        RAD_TEST_CHECK(rad::enum_set<E>::max_size() == count);
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const auto index = static_cast<std::size_t>(rng.next(static_cast<int>(count)));
+            const auto value = to_enum<E>(index);
+
+            switch (rng.next(4))
+            {
+            case 0:
+            case 1:
+                set.insert(value);
+                ref.insert(index);
+                break;
+
+            case 2:
+                set.erase(value);
+                ref.erase(index);
+                break;
+
+            default:
+                set.flip(value);
+                if (ref.erase(index) == 0)
+                {
+                    ref.insert(index);
+                }
+
+                break;
+            }
+
+            check_same(set, ref);
+
+            if ((i % 10) != 0)
+            {
+                continue;
+            }
+
+            // Compare the set operations, against a random (sometimes empty) set.
+            std::set<std::size_t> otherRef;
+            const auto density = rng.next(4);
+
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                if (rng.next(4) < density)
+                {
+                    otherRef.insert(j);
+                }
+            }
+
+            const auto other = make_set<E>(otherRef);
+            check_same(other, otherRef);
+
+            const auto unionRef = apply(ref, otherRef, [](auto... args) { std::set_union(args...); });
+            const auto intersectionRef = apply(ref, otherRef, [](auto... args) { std::set_intersection(args...); });
+            const auto differenceRef = apply(ref, otherRef, [](auto... args) { std::set_difference(args...); });
+            const auto symmetricRef = apply(ref, otherRef, [](auto... args) { std::set_symmetric_difference(args...); });
+            const auto complementRef = apply(all, ref, [](auto... args) { std::set_difference(args...); });
+
+            check_same(set | other, unionRef);
+            check_same(set & other, intersectionRef);
+            check_same(set - other, differenceRef);
+            check_same(set ^ other, symmetricRef);
+            check_same(~set, complementRef);
+
+            auto compound = set;
+            compound |= other;
+            check_same(compound, unionRef);
+
+            compound = set;
+            compound &= other;
+            check_same(compound, intersectionRef);
+
+            compound = set;
+            compound -= other;
+            check_same(compound, differenceRef);
+
+            compound = set;
+            compound ^= other;
+            check_same(compound, symmetricRef);
+
+            RAD_TEST_CHECK(set.contains_all(other) == std::includes(ref.begin(), ref.end(), otherRef.begin(), otherRef.end()));
+            RAD_TEST_CHECK(set.contains_any(other) == !intersectionRef.empty());
+            RAD_TEST_CHECK((set == other) == (ref == otherRef));
+            RAD_TEST_CHECK((set != other) == (ref != otherRef));
+            RAD_TEST_CHECK(set == make_set<E>(ref));
+        }
+
+        set.clear();
+        ref.clear();
+        check_same(set, ref);
+    }
+
+    /// @brief Compares an enum_array against a std::array across random writes.
+    template<typename E>
+    void test_array()
+    {
+        constexpr auto count = rad::enum_count_v<E>;
+
+        rad::enum_array<E, std::string> arr;
+        std::array<std::string, count> ref;
+        rad::test::random rng;
+
+        const auto check_same = [&]()
+        {
+            RAD_TEST_CHECK(arr.size() == ref.size());
+            RAD_TEST_CHECK(static_cast<std::size_t>(arr.end() - arr.begin()) == ref.size());
+            RAD_TEST_CHECK(std::equal(arr.begin(), arr.end(), ref.begin(), ref.end()));
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto key = to_enum<E>(i);
+                RAD_TEST_CHECK(arr[key] == ref[i]);
+                RAD_TEST_CHECK(&arr.at(key) == &arr[key]);
+                RAD_TEST_CHECK(&arr[key] == (arr.data() + i));
+            }
+        };
+
+        check_same();
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            const auto index = static_cast<std::size_t>(rng.next(static_cast<int>(count)));
+            const auto value = std::to_string(i);
+
+            // NOTE: Rarely, overwrite every element at once.
+            const auto op = rng.next(20);
+
+            if (op == 0)
+            {
+                arr.fill(value);
+                ref.fill(value);
+            }
+            else if (op < 10)
+            {
+                arr[to_enum<E>(index)] = value;
+                ref[index] = value;
+            }
+            else
+            {
+                arr.at(to_enum<E>(index)) = value;
+                ref[index] = value;
+            }
+
+            check_same();
+        }
+
+        check_same();
+
+        // Keys beyond the enum's count are rejected by at().
+        bool isThrown = false;
+        try
+        {
+            arr.at(to_enum<E>(count));
+        }
+        catch (const std::out_of_range&)
+        {
+            isThrown = true;
+        }
+
+        RAD_TEST_CHECK(isThrown);
+
+        const rad::enum_array<E, std::string> filled(std::string("filled"));
+        RAD_TEST_CHECK(std::all_of(filled.begin(), filled.end(),
+            [](const std::string& str) { return (str == "filled"); }));
+    }
+}
+
+int main()
+{
+    test_set<color>();
+    test_set<direction>();
+    test_set<sized<8>::type>();
+    test_set<sized<33>::type>();
+    test_set<sized<64>::type>();
+    test_set<sized<130>::type>();
+
+    test_array<color>();
+    test_array<direction>();
+    test_array<sized<130>::type>();
+
+    std::puts("rad_test_enum_containers: all tests passed");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+/// @file rad_test_indexed_memory_pool.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::indexed_memory_pool and rad::pool_index.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_memory_pool.h"
+#include <iterator>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    template<typename T>
+    using pool_values = std::map<std::uint32_t, T>;
+
+    template<typename T>
+    void check_same(const rad::indexed_memory_pool<T>& pool, const pool_values<T>& values)
+    {
+        RAD_TEST_CHECK(pool.size() == values.size());
+        RAD_TEST_CHECK(pool.capacity() >= values.size());
+
+        for (const auto& entry : values)
+        {
+            const rad::pool_index<T> index(entry.first);
+            RAD_TEST_CHECK(pool[index] == entry.second);
+            RAD_TEST_CHECK(pool.get_index(pool.get(index)) == index);
+        }
+
+        const auto stats = pool.get_stats();
+        RAD_TEST_CHECK(stats.liveElementCount == values.size());
+        RAD_TEST_CHECK(stats.freeElementCount == (pool.capacity() - values.size()));
+    }
+
+    template<typename T>
+    void destroy_all(rad::indexed_memory_pool<T>& pool, pool_values<T>& values)
+    {
+        for (const auto& entry : values)
+        {
+            const rad::pool_index<T> index(entry.first);
+            rad::destruct(pool[index]);
+            pool.deallocate(index);
+        }
+
+        values.clear();
+    }
+
+    /// @brief Compares a pool against a std::map of index to value, across
+    /// random allocations and deallocations (and so, across growth).
+    template<typename T>
+    void test_random_ops(T (*make_value)(int))
+    {
+        rad::indexed_memory_pool<T> pool;
+        pool_values<T> values;
+        rad::test::random rng;
+        std::uint32_t lastFreedIndex = rad::pool_index<T>::invalid_value;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            if (values.empty() || rng.next(100) < 60)
+            {
+                const auto value = make_value(static_cast<int>(rng.next()));
+                const auto index = pool.allocate();
+
+                RAD_TEST_CHECK(index.is_valid());
+                RAD_TEST_CHECK(values.find(index.value()) == values.end());
+
+                // NOTE: The most recently freed element is re-used first.
+                RAD_TEST_CHECK(lastFreedIndex == rad::pool_index<T>::invalid_value ||
+                    index.value() == lastFreedIndex);
+
+                new (pool.get(index)) T(value);
+                values.emplace(index.value(), value);
+                lastFreedIndex = rad::pool_index<T>::invalid_value;
+            }
+            else
+            {
+                auto it = values.begin();
+                std::advance(it, rng.next(static_cast<int>(values.size())));
+
+                const rad::pool_index<T> index(it->first);
+                rad::destruct(pool[index]);
+                pool.deallocate(index);
+
+                lastFreedIndex = it->first;
+                values.erase(it);
+            }
+
+            if ((i % 100) == 0)
+            {
+                check_same(pool, values);
+            }
+        }
+
+        check_same(pool, values);
+
+        // Moving the pool keeps every object at the same index.
+        rad::indexed_memory_pool<T> movedPool(std::move(pool));
+        RAD_TEST_CHECK(pool.size() == 0 && pool.capacity() == 0);
+        check_same(movedPool, values);
+
+        pool = std::move(movedPool);
+        check_same(pool, values);
+
+        destroy_all(pool, values);
+    }
+
+    int make_int(int value)
+    {
+        return value;
+    }
+
+    std::string make_string(int value)
+    {
+        // NOTE: Long enough to exceed the small string optimization, so that
+        // growing the pool must actually move each string's heap allocation.
+        return std::to_string(value) + std::string(32, '#');
+    }
+
+    void test_reserve()
+    {
+        rad::indexed_memory_pool<std::string> pool(4);
+        pool_values<std::string> values;
+
+        RAD_TEST_CHECK(pool.capacity() == 4);
+        RAD_TEST_CHECK(pool.size() == 0);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto index = pool.allocate();
+            RAD_TEST_CHECK(index.value() == static_cast<std::uint32_t>(i));
+
+            new (pool.get(index)) std::string(make_string(i));
+            values.emplace(index.value(), make_string(i));
+        }
+
+        // Free an element, then grow the pool; the free list must survive the move.
+        rad::destruct(pool[rad::pool_index<std::string>(1)]);
+        pool.deallocate(rad::pool_index<std::string>(1));
+        values.erase(1);
+
+        pool.reserve(100);
+        RAD_TEST_CHECK(pool.capacity() == 100);
+        check_same(pool, values);
+
+        const auto index = pool.allocate();
+        RAD_TEST_CHECK(index.value() == 1);
+
+        new (pool.get(index)) std::string(make_string(1));
+        values.emplace(index.value(), make_string(1));
+
+        // Shrinking is a no-op.
+        pool.reserve(10);
+        RAD_TEST_CHECK(pool.capacity() == 100);
+        check_same(pool, values);
+
+        destroy_all(pool, values);
+    }
+
+    void test_pool_index()
+    {
+        constexpr rad::pool_index<int> invalidIndex;
+        constexpr rad::pool_index<int> index(7);
+
+        static_assert(sizeof(index) == sizeof(std::uint32_t));
+        static_assert(!invalidIndex.is_valid() && !invalidIndex);
+        static_assert(index.is_valid() && index.value() == 7);
+        static_assert(index == rad::pool_index<int>(7) && index != invalidIndex);
+    }
+}
+
+int main()
+{
+    test_random_ops<int>(make_int);
+    test_random_ops<std::string>(make_string);
+    test_reserve();
+    test_pool_index();
+
+    std::puts("rad_test_indexed_memory_pool: all tests passed");
+    return EXIT_SUCCESS;
+}
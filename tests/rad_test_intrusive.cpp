@@ -0,0 +1,421 @@
+/// @file rad_test_intrusive.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::intrusive_list, rad::intrusive_slist
+/// and rad::intrusive_hash_table.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_intrusive_list.h"
+#include "rad_intrusive_hash_table.h"
+#include <algorithm>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    constexpr int nodeCount = 64;
+
+    /// @brief An object which can be linked into one of each kind of container at once.
+    struct node
+    {
+        int                         id = 0;
+        int                         key = 0;
+        rad::intrusive_list_hook    listHook;
+        rad::intrusive_slist_hook   slistHook;
+        rad::intrusive_hash_hook    hashHook;
+    };
+
+    struct node_key
+    {
+        int operator()(const node& n) const noexcept
+        {
+            return n.key;
+        }
+    };
+
+    using node_list = rad::intrusive_list<node, &node::listHook>;
+    using node_slist = rad::intrusive_slist<node, &node::slistHook>;
+    using node_table = rad::intrusive_hash_table<node, &node::hashHook, node_key>;
+
+    std::vector<node> make_nodes()
+    {
+        std::vector<node> nodes(nodeCount);
+        for (int i = 0; i < nodeCount; ++i)
+        {
+            nodes[i].id = i;
+        }
+
+        return nodes;
+    }
+
+    /// @brief Returns a random node which isn't linked via the given hook, if there is one.
+    template<typename Hook>
+    node* find_unlinked(std::vector<node>& nodes, Hook node::*hook, rad::test::random& rng)
+    {
+        const auto start = rng.next(nodeCount);
+        for (int i = 0; i < nodeCount; ++i)
+        {
+            auto& n = nodes[(start + i) % nodeCount];
+            if (!(n.*hook).is_linked())
+            {
+                return &n;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void check_same(const node_list& list, const std::list<int>& ref)
+    {
+        RAD_TEST_CHECK(list.size() == ref.size());
+        RAD_TEST_CHECK(list.empty() == ref.empty());
+        RAD_TEST_CHECK(std::equal(list.begin(), list.end(), ref.begin(), ref.end(),
+            [](const node& n, int id) { return (n.id == id); }));
+
+        // Walk backwards too, so that the prev links are checked.
+        auto it = list.end();
+        for (auto refIt = ref.rbegin(); refIt != ref.rend(); ++refIt)
+        {
+            RAD_TEST_CHECK((--it)->id == *refIt);
+        }
+
+        RAD_TEST_CHECK(it == list.begin());
+
+        if (!ref.empty())
+        {
+            RAD_TEST_CHECK(list.front().id == ref.front());
+            RAD_TEST_CHECK(list.back().id == ref.back());
+        }
+    }
+
+    void test_list()
+    {
+        auto nodes = make_nodes();
+        node_list list;
+        std::list<int> ref;
+        rad::test::random rng;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const auto op = rng.next(7);
+            const auto unlinked = find_unlinked(nodes, &node::listHook, rng);
+
+            if (op <= 2 && unlinked)
+            {
+                // Insert at the front, at the back, or at a random position.
+                if (op == 0)
+                {
+                    list.push_front(*unlinked);
+                    ref.push_front(unlinked->id);
+                }
+                else if (op == 1)
+                {
+                    list.push_back(*unlinked);
+                    ref.push_back(unlinked->id);
+                }
+                else
+                {
+                    const auto pos = rng.next(static_cast<int>(ref.size()) + 1);
+                    const auto it = list.insert(std::next(list.begin(), pos), *unlinked);
+
+                    RAD_TEST_CHECK(&*it == unlinked);
+                    ref.insert(std::next(ref.begin(), pos), unlinked->id);
+                }
+            }
+            else if (!ref.empty())
+            {
+                // Remove from the front, from the back, or at a random position.
+                if (op == 3)
+                {
+                    list.pop_front();
+                    ref.pop_front();
+                }
+                else if (op == 4)
+                {
+                    list.pop_back();
+                    ref.pop_back();
+                }
+                else if (op == 5)
+                {
+                    const auto pos = rng.next(static_cast<int>(ref.size()));
+                    const auto it = list.erase(std::next(list.begin(), pos));
+                    const auto refIt = ref.erase(std::next(ref.begin(), pos));
+
+                    RAD_TEST_CHECK((it == list.end()) == (refIt == ref.end()));
+                    RAD_TEST_CHECK(it == list.end() || it->id == *refIt);
+                }
+                else
+                {
+                    const auto id = *std::next(ref.begin(), rng.next(static_cast<int>(ref.size())));
+                    RAD_TEST_CHECK(&*list.iterator_to(nodes[id]) == &nodes[id]);
+
+                    list.remove(nodes[id]);
+                    ref.remove(id);
+                }
+            }
+
+            check_same(list, ref);
+        }
+
+        for (const auto& n : nodes)
+        {
+            RAD_TEST_CHECK(n.listHook.is_linked() ==
+                (std::find(ref.begin(), ref.end(), n.id) != ref.end()));
+        }
+
+        // Moving a list takes all of its objects.
+        node_list movedList(std::move(list));
+        RAD_TEST_CHECK(list.empty());
+        check_same(movedList, ref);
+
+        list = std::move(movedList);
+        RAD_TEST_CHECK(movedList.empty());
+        check_same(list, ref);
+
+        list.clear();
+        ref.clear();
+        check_same(list, ref);
+
+        for (const auto& n : nodes)
+        {
+            RAD_TEST_CHECK(!n.listHook.is_linked());
+        }
+    }
+
+    void check_same(const node_slist& list, const std::forward_list<int>& ref)
+    {
+        RAD_TEST_CHECK(list.size() == static_cast<std::size_t>(std::distance(ref.begin(), ref.end())));
+        RAD_TEST_CHECK(list.empty() == ref.empty());
+        RAD_TEST_CHECK(std::equal(list.begin(), list.end(), ref.begin(), ref.end(),
+            [](const node& n, int id) { return (n.id == id); }));
+
+        if (!ref.empty())
+        {
+            RAD_TEST_CHECK(list.front().id == ref.front());
+        }
+    }
+
+    void test_slist()
+    {
+        auto nodes = make_nodes();
+        node_slist list;
+        std::forward_list<int> ref;
+        rad::test::random rng;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const auto op = rng.next(4);
+            const auto unlinked = find_unlinked(nodes, &node::slistHook, rng);
+            const auto size = static_cast<int>(list.size());
+
+            if (op <= 1 && unlinked)
+            {
+                // Insert at the front, or after a random position (including the last object).
+                if (op == 0)
+                {
+                    list.push_front(*unlinked);
+                    ref.push_front(unlinked->id);
+                }
+                else
+                {
+                    const auto pos = rng.next(size + 1);
+                    const auto it = list.insert_after(std::next(list.before_begin(), pos), *unlinked);
+
+                    RAD_TEST_CHECK(&*it == unlinked);
+                    ref.insert_after(std::next(ref.before_begin(), pos), unlinked->id);
+                }
+            }
+            else if (size > 0)
+            {
+                // Remove from the front, or after a random position (including the last object).
+                if (op == 2)
+                {
+                    list.pop_front();
+                    ref.pop_front();
+                }
+                else
+                {
+                    const auto pos = rng.next(size);
+                    const auto it = list.erase_after(std::next(list.before_begin(), pos));
+                    const auto refIt = ref.erase_after(std::next(ref.before_begin(), pos));
+
+                    RAD_TEST_CHECK((it == list.end()) == (refIt == ref.end()));
+                    RAD_TEST_CHECK(it == list.end() || it->id == *refIt);
+                }
+            }
+
+            check_same(list, ref);
+
+            // NOTE: Appending after the last object must keep the list terminated.
+            if (!ref.empty())
+            {
+                const auto last = std::next(list.begin(), static_cast<int>(list.size()) - 1);
+                RAD_TEST_CHECK(std::next(last) == list.end());
+                RAD_TEST_CHECK(list.iterator_to(*last) == last);
+            }
+        }
+
+        node_slist movedList(std::move(list));
+        RAD_TEST_CHECK(list.empty());
+        check_same(movedList, ref);
+
+        list = std::move(movedList);
+        RAD_TEST_CHECK(movedList.empty());
+        check_same(list, ref);
+
+        list.clear();
+        ref.clear();
+        check_same(list, ref);
+
+        for (const auto& n : nodes)
+        {
+            RAD_TEST_CHECK(!n.slistHook.is_linked());
+        }
+    }
+
+    void check_same(const node_table& table, const std::unordered_map<int, const node*>& ref)
+    {
+        RAD_TEST_CHECK(table.size() == ref.size());
+        RAD_TEST_CHECK(table.empty() == ref.empty());
+
+        std::size_t count = 0;
+        for (const auto& n : table)
+        {
+            const auto it = ref.find(n.key);
+            RAD_TEST_CHECK(it != ref.end() && it->second == &n);
+            ++count;
+        }
+
+        RAD_TEST_CHECK(count == ref.size());
+
+        for (int key = -1; key <= 2 * nodeCount; ++key)
+        {
+            const auto it = ref.find(key);
+            const auto found = table.find(key);
+
+            RAD_TEST_CHECK(found == ((it != ref.end()) ? it->second : nullptr));
+            RAD_TEST_CHECK(table.contains(key) == (it != ref.end()));
+        }
+    }
+
+    void test_hash_table()
+    {
+        auto nodes = make_nodes();
+        std::vector<rad::intrusive_hash_bucket> buckets(4);
+        node_table table(rad::span<rad::intrusive_hash_bucket>(buckets.data(), buckets.size()));
+        std::unordered_map<int, const node*> ref;
+        rad::test::random rng;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const auto op = rng.next(4);
+            const auto unlinked = find_unlinked(nodes, &node::hashHook, rng);
+
+            if (op <= 1 && unlinked)
+            {
+                // NOTE: Keys collide often, so that duplicate keys are rejected.
+                unlinked->key = rng.next(2 * nodeCount);
+
+                const auto isInserted = table.insert(*unlinked);
+                RAD_TEST_CHECK(isInserted == ref.emplace(unlinked->key, unlinked).second);
+                RAD_TEST_CHECK(unlinked->hashHook.is_linked() == isInserted);
+            }
+            else if (op == 2)
+            {
+                const auto key = rng.next(2 * nodeCount);
+                const auto it = ref.find(key);
+                const auto erased = table.erase(key);
+
+                RAD_TEST_CHECK(erased == ((it != ref.end()) ? it->second : nullptr));
+                if (it != ref.end())
+                {
+                    ref.erase(it);
+                }
+            }
+            else if (!ref.empty())
+            {
+                auto it = ref.begin();
+                std::advance(it, rng.next(static_cast<int>(ref.size())));
+
+                table.remove(nodes[it->second->id]);
+                ref.erase(it);
+            }
+
+            // Grow the buckets as the table fills up.
+            if (table.load_factor() > 1.0f)
+            {
+                std::vector<rad::intrusive_hash_bucket> newBuckets(buckets.size() * 2);
+                table.rehash(rad::span<rad::intrusive_hash_bucket>(newBuckets.data(), newBuckets.size()));
+
+                for (const auto& bucket : buckets)
+                {
+                    RAD_TEST_CHECK(!bucket.first);
+                }
+
+                buckets = std::move(newBuckets);
+                RAD_TEST_CHECK(table.bucket_count() == buckets.size());
+            }
+
+            check_same(table, ref);
+        }
+
+        RAD_TEST_CHECK(table.bucket_count() > 4);
+
+        node_table movedTable(std::move(table));
+        RAD_TEST_CHECK(table.empty());
+        check_same(movedTable, ref);
+
+        table = std::move(movedTable);
+        RAD_TEST_CHECK(movedTable.empty());
+        check_same(table, ref);
+
+        table.clear();
+        ref.clear();
+        check_same(table, ref);
+
+        for (const auto& n : nodes)
+        {
+            RAD_TEST_CHECK(!n.hashHook.is_linked());
+        }
+    }
+
+    void test_copies_are_unlinked()
+    {
+        node n;
+        node_list list;
+        node_slist slist;
+
+        list.push_back(n);
+        slist.push_front(n);
+
+        const node copy(n);
+        RAD_TEST_CHECK(!copy.listHook.is_linked());
+        RAD_TEST_CHECK(!copy.slistHook.is_linked());
+
+        node assigned;
+        assigned = n;
+        RAD_TEST_CHECK(!assigned.listHook.is_linked());
+        RAD_TEST_CHECK(!assigned.slistHook.is_linked());
+
+        list.clear();
+        slist.clear();
+    }
+}
+
+int main()
+{
+    test_list();
+    test_slist();
+    test_hash_table();
+    test_copies_are_unlinked();
+
+    std::puts("rad_test_intrusive: all tests passed");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/// @file rad_test_memory_pool_compact.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::dynamic_memory_pool::compact.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_memory_pool.h"
+#include <iterator>
+#include <map>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    constexpr std::size_t elementsPerBlock = 16;
+
+    inline std::size_t get_kept_block_count(std::size_t liveCount)
+    {
+        return (liveCount > 0) ? ((liveCount + (elementsPerBlock - 1)) / elementsPerBlock) : 1;
+    }
+
+    /// @brief Checks that compacting a pool keeps every live object's value (tracked
+    /// via std::map, keyed by a handle), and reports every relocation.
+    template<typename T, rad::memory_pool_order Order>
+    void test_compact(T (*make_value)(int))
+    {
+        rad::dynamic_memory_pool<T, Order> pool(elementsPerBlock);
+        std::map<int, T*> ptrs;
+        std::map<int, T> values;
+        rad::test::random rng;
+        int nextHandle = 0;
+
+        for (int round = 0; round < 20; ++round)
+        {
+            // Scatter some allocations and deallocations across the pool.
+            for (int i = 0; i < 300; ++i)
+            {
+                if (ptrs.empty() || rng.next(100) < 60)
+                {
+                    const auto value = make_value(static_cast<int>(rng.next()));
+                    const auto ptr = new (pool.allocate()) T(value);
+
+                    ptrs.emplace(nextHandle, ptr);
+                    values.emplace(nextHandle, value);
+                    ++nextHandle;
+                }
+                else
+                {
+                    auto it = ptrs.begin();
+                    std::advance(it, rng.next(static_cast<int>(ptrs.size())));
+
+                    rad::destruct(*it->second);
+                    pool.deallocate(it->second);
+                    values.erase(it->first);
+                    ptrs.erase(it);
+                }
+            }
+
+            // Compact the pool, updating the handles of the relocated objects.
+            std::unordered_map<T*, int> handles;
+            for (const auto& entry : ptrs)
+            {
+                handles.emplace(entry.second, entry.first);
+            }
+
+            const auto oldBlockCount = pool.block_count();
+            std::size_t relocationCount = 0;
+
+            const auto freedBlockCount = pool.compact([&](T* oldPtr, T* newPtr)
+            {
+                const auto it = handles.find(oldPtr);
+                RAD_TEST_CHECK(it != handles.end());
+                RAD_TEST_CHECK(ptrs[it->second] == oldPtr);
+
+                ptrs[it->second] = newPtr;
+                handles.erase(it);
+                ++relocationCount;
+            });
+
+            RAD_TEST_CHECK(freedBlockCount == (oldBlockCount - pool.block_count()));
+            RAD_TEST_CHECK(pool.block_count() == get_kept_block_count(ptrs.size()));
+            RAD_TEST_CHECK(relocationCount <= ptrs.size());
+
+            const auto stats = pool.get_stats();
+            RAD_TEST_CHECK(stats.liveElementCount == ptrs.size());
+            RAD_TEST_CHECK(stats.emptyBlockCount == (ptrs.empty() ? 1 : 0));
+
+            for (const auto& entry : ptrs)
+            {
+                RAD_TEST_CHECK(*entry.second == values.at(entry.first));
+            }
+
+            // Empty the pool every so often, so that compacting an empty pool is covered too.
+            if ((round % 7) == 6)
+            {
+                for (const auto& entry : ptrs)
+                {
+                    rad::destruct(*entry.second);
+                    pool.deallocate(entry.second);
+                }
+
+                ptrs.clear();
+                values.clear();
+            }
+        }
+
+        for (const auto& entry : ptrs)
+        {
+            rad::destruct(*entry.second);
+            pool.deallocate(entry.second);
+        }
+    }
+
+    int make_int(int value)
+    {
+        return value;
+    }
+
+    std::string make_string(int value)
+    {
+        // NOTE: Long enough to exceed the small string optimization, so that
+        // relocating a string must actually move its heap allocation.
+        return std::to_string(value) + std::string(32, '#');
+    }
+
+    void test_compact_sorted_free_list()
+    {
+        rad::dynamic_memory_pool<int> pool(elementsPerBlock);
+        int* ptrs[4 * elementsPerBlock];
+
+        for (auto& ptr : ptrs)
+        {
+            ptr = pool.allocate();
+        }
+
+        // Free most of the first block; every block is still needed.
+        for (std::size_t i = 0; i < 12; ++i)
+        {
+            pool.deallocate(ptrs[i]);
+        }
+
+        RAD_TEST_CHECK(pool.compact([](int*, int*) {}) == 0);
+        RAD_TEST_CHECK(pool.block_count() == 4);
+
+        // Free half of the second block too, so that the first block's live
+        // objects fit into the second block's free elements.
+        for (std::size_t i = 0; i < (elementsPerBlock / 2); ++i)
+        {
+            pool.deallocate(ptrs[elementsPerBlock + i]);
+        }
+
+        std::size_t relocationCount = 0;
+        RAD_TEST_CHECK(pool.compact([&](int*, int*) { ++relocationCount; }) == 1);
+        RAD_TEST_CHECK(pool.block_count() == 3);
+        RAD_TEST_CHECK(relocationCount == 4);
+
+        // After compaction, the free list is rebuilt in address order.
+        const auto stats = pool.get_stats();
+        RAD_TEST_CHECK(stats.freeElementCount == 4);
+        RAD_TEST_CHECK(stats.freeListBlockSwitchCount == 0);
+    }
+}
+
+int main()
+{
+    test_compact<int, rad::memory_pool_order::lifo>(make_int);
+    test_compact<int, rad::memory_pool_order::address>(make_int);
+    test_compact<int, rad::memory_pool_order::block_affine>(make_int);
+    test_compact<std::string, rad::memory_pool_order::lifo>(make_string);
+    test_compact<std::string, rad::memory_pool_order::address>(make_string);
+    test_compact<std::string, rad::memory_pool_order::block_affine>(make_string);
+    test_compact_sorted_free_list();
+
+    std::puts("rad_test_memory_pool_compact: all tests passed");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,220 @@
+/// @file rad_test_memory_pool_order.cpp
+/// @author Graham Scott
+/// @brief Regression tests for the allocation orders of rad::dynamic_memory_pool.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_memory_pool.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    using element_type = std::uint64_t;
+
+    constexpr std::size_t elementsPerBlock = 8;
+
+    /// @brief Models the order in which a pool hands out its free elements, using
+    /// std::set and std::vector, so that every allocation can be predicted exactly.
+    ///
+    /// NOTE: A pool only allocates a new block when no elements are free, and every order
+    /// hands out a new block's lowest element first; so an unpredicted allocation is
+    /// the first element of a new block.
+    template<rad::memory_pool_order Order>
+    class order_model
+    {
+        // NOTE: Each block's free elements, keyed by the block's address.
+        std::map<element_type*, std::set<element_type*>>   blocks_;
+
+        // NOTE: For LIFO order, the free elements; the last one is allocated first.
+        std::vector<element_type*>                          stack_;
+
+        // NOTE: For block-affine order, the block elements are currently being allocated from.
+        element_type*                                       currentBlock_ = nullptr;
+
+        std::set<element_type*>& find_block_(element_type* element)
+        {
+            const auto it = --blocks_.upper_bound(element);
+            RAD_TEST_CHECK(element >= it->first && element < (it->first + elementsPerBlock));
+            return it->second;
+        }
+
+        bool has_free_elements_() const
+        {
+            for (const auto& block : blocks_)
+            {
+                if (!block.second.empty())
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        element_type* predict_()
+        {
+            if constexpr (Order == rad::memory_pool_order::lifo)
+            {
+                return stack_.back();
+            }
+            else if constexpr (Order == rad::memory_pool_order::address)
+            {
+                for (const auto& block : blocks_)
+                {
+                    if (!block.second.empty())
+                    {
+                        return *block.second.begin();
+                    }
+                }
+            }
+            else
+            {
+                if (!currentBlock_ || blocks_[currentBlock_].empty())
+                {
+                    // Switch to the fullest block with free elements (the lowest, on ties).
+                    std::size_t minFreeCount = elementsPerBlock + 1;
+                    for (const auto& block : blocks_)
+                    {
+                        if (!block.second.empty() && block.second.size() < minFreeCount)
+                        {
+                            currentBlock_ = block.first;
+                            minFreeCount = block.second.size();
+                        }
+                    }
+                }
+
+                return *blocks_[currentBlock_].begin();
+            }
+
+            return nullptr;
+        }
+
+    public:
+        void on_allocate(element_type* element)
+        {
+            if (!has_free_elements_())
+            {
+                // The pool must have added a new block.
+                const auto nextBlockIt = blocks_.upper_bound(element);
+                RAD_TEST_CHECK(nextBlockIt == blocks_.begin() ||
+                    element >= (std::prev(nextBlockIt)->first + elementsPerBlock));
+
+                auto& block = blocks_[element];
+                for (std::size_t i = 1; i < elementsPerBlock; ++i)
+                {
+                    block.insert(element + i);
+                }
+
+                if constexpr (Order == rad::memory_pool_order::lifo)
+                {
+                    for (std::size_t i = elementsPerBlock - 1; i > 0; --i)
+                    {
+                        stack_.push_back(element + i);
+                    }
+                }
+                else if constexpr (Order == rad::memory_pool_order::block_affine)
+                {
+                    currentBlock_ = element;
+                }
+
+                return;
+            }
+
+            RAD_TEST_CHECK(element == predict_());
+
+            find_block_(element).erase(element);
+            if constexpr (Order == rad::memory_pool_order::lifo)
+            {
+                stack_.pop_back();
+            }
+        }
+
+        void on_deallocate(element_type* element)
+        {
+            RAD_TEST_CHECK(find_block_(element).insert(element).second);
+            if constexpr (Order == rad::memory_pool_order::lifo)
+            {
+                stack_.push_back(element);
+            }
+        }
+    };
+
+    template<rad::memory_pool_order Order>
+    void test_order()
+    {
+        rad::dynamic_memory_pool<element_type, Order> pool(elementsPerBlock);
+        order_model<Order> model;
+        std::vector<element_type*> live;
+        rad::test::random rng;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            // NOTE: Mostly allocate at first, then mostly deallocate.
+            const auto allocatePercent = (i < 2500) ? 60 : 40;
+
+            if (live.empty() || rng.next(100) < allocatePercent)
+            {
+                const auto element = pool.allocate();
+                model.on_allocate(element);
+                live.push_back(element);
+            }
+            else
+            {
+                const auto index = static_cast<std::size_t>(rng.next(static_cast<int>(live.size())));
+                const auto element = live[index];
+
+                live[index] = live.back();
+                live.pop_back();
+
+                pool.deallocate(element);
+                model.on_deallocate(element);
+            }
+        }
+    }
+
+    void test_address_order_is_sequential()
+    {
+        // Scramble the free list, then check that consecutive
+        // allocations are still sequential in memory.
+        rad::dynamic_memory_pool<element_type, rad::memory_pool_order::address> pool(elementsPerBlock);
+        std::vector<element_type*> elements;
+
+        for (std::size_t i = 0; i < 4 * elementsPerBlock; ++i)
+        {
+            elements.push_back(pool.allocate());
+        }
+
+        for (std::size_t i = 0; i < elements.size(); ++i)
+        {
+            pool.deallocate(elements[(i * 7) % elements.size()]);
+        }
+
+        const auto stats = pool.get_stats();
+        RAD_TEST_CHECK(stats.freeListBlockSwitchCount == (pool.block_count() - 1));
+
+        const auto lowestElement = *std::min_element(elements.begin(), elements.end());
+        for (std::size_t i = 0; i < elementsPerBlock; ++i)
+        {
+            RAD_TEST_CHECK(pool.allocate() == (lowestElement + i));
+        }
+    }
+}
+
+int main()
+{
+    test_order<rad::memory_pool_order::lifo>();
+    test_order<rad::memory_pool_order::address>();
+    test_order<rad::memory_pool_order::block_affine>();
+    test_address_order_is_sequential();
+
+    std::puts("rad_test_memory_pool_order: all tests passed");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/// @file rad_test_memory_pool_stats.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::memory_pool_stats and rad::dump_pool_report.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_memory_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t elementsPerBlock = 8;
+
+    /// @brief Tracks which of a pool's elements are live, independently of the pool.
+    ///
+    /// NOTE: A pool only allocates a new block once all of its other blocks are full,
+    /// so the i-th distinct pointer handed out by the pool is within block i / elementsPerBlock.
+    struct pool_model
+    {
+        std::vector<std::uint64_t*>     ptrs;
+        std::vector<bool>               isLive;
+
+        void on_allocate(std::uint64_t* ptr)
+        {
+            const auto it = std::find(ptrs.begin(), ptrs.end(), ptr);
+            if (it == ptrs.end())
+            {
+                ptrs.push_back(ptr);
+                isLive.push_back(true);
+                return;
+            }
+
+            RAD_TEST_CHECK(!isLive[it - ptrs.begin()]);
+            isLive[it - ptrs.begin()] = true;
+        }
+
+        std::size_t live_count() const
+        {
+            return static_cast<std::size_t>(std::count(isLive.begin(), isLive.end(), true));
+        }
+
+        std::size_t live_count_in_block(std::size_t blockIndex) const
+        {
+            std::size_t count = 0;
+            for (std::size_t i = blockIndex * elementsPerBlock;
+                i < std::min(isLive.size(), (blockIndex + 1) * elementsPerBlock); ++i)
+            {
+                count += isLive[i];
+            }
+
+            return count;
+        }
+    };
+
+    template<typename Pool>
+    void check_stats(const Pool& pool, const pool_model& model)
+    {
+        const auto stats = pool.get_stats();
+
+        RAD_TEST_CHECK(stats.blockCount == pool.block_count());
+        RAD_TEST_CHECK(stats.elementsPerBlock == elementsPerBlock);
+        RAD_TEST_CHECK(stats.capacity() == pool.capacity());
+        RAD_TEST_CHECK(stats.liveElementCount == model.live_count());
+        RAD_TEST_CHECK(stats.freeElementCount == (pool.capacity() - model.live_count()));
+        RAD_TEST_CHECK(stats.liveElementsPerBlock.size() == stats.blockCount);
+
+        std::size_t emptyBlockCount = 0;
+        for (std::size_t i = 0; i < stats.blockCount; ++i)
+        {
+            RAD_TEST_CHECK(stats.liveElementsPerBlock[i] == model.live_count_in_block(i));
+            emptyBlockCount += (stats.liveElementsPerBlock[i] == 0);
+        }
+
+        RAD_TEST_CHECK(stats.emptyBlockCount == emptyBlockCount);
+        RAD_TEST_CHECK(stats.freeElementCount == 0 ||
+            stats.freeListBlockSwitchCount < stats.freeElementCount);
+
+        const auto idealEmptyBlockCount = (stats.freeElementCount / elementsPerBlock);
+        const auto fragmentation = (idealEmptyBlockCount > 0) ?
+            (1.0 - (static_cast<double>(emptyBlockCount) / idealEmptyBlockCount)) : 0.0;
+
+        RAD_TEST_CHECK(stats.fragmentation == fragmentation);
+        RAD_TEST_CHECK(stats.fragmentation >= 0.0 && stats.fragmentation <= 1.0);
+    }
+
+    void test_fresh_dynamic_pool()
+    {
+        rad::dynamic_memory_pool<std::uint64_t> pool(elementsPerBlock);
+        const auto stats = pool.get_stats();
+
+        RAD_TEST_CHECK(stats.blockCount == 1);
+        RAD_TEST_CHECK(stats.capacity() == elementsPerBlock);
+        RAD_TEST_CHECK(stats.liveElementCount == 0);
+        RAD_TEST_CHECK(stats.freeElementCount == elementsPerBlock);
+        RAD_TEST_CHECK(stats.emptyBlockCount == 1);
+        RAD_TEST_CHECK(stats.utilization() == 0.0);
+        RAD_TEST_CHECK(stats.liveElementsPerBlock.size() == 1);
+        RAD_TEST_CHECK(stats.liveElementsPerBlock[0] == 0);
+    }
+
+    template<rad::memory_pool_order Order>
+    void test_fresh_fixed_pool()
+    {
+        rad::fixed_memory_pool<std::uint64_t, Order> pool(16);
+        const auto stats = pool.get_stats();
+
+        RAD_TEST_CHECK(stats.blockCount == 1);
+        RAD_TEST_CHECK(stats.freeElementCount == 16);
+        RAD_TEST_CHECK(stats.emptyBlockCount == 1);
+        RAD_TEST_CHECK(stats.freeListBlockSwitchCount == 0);
+        RAD_TEST_CHECK(stats.freeListAverageDistance == sizeof(std::uint64_t));
+        RAD_TEST_CHECK(stats.fragmentation == 0.0);
+    }
+
+    template<rad::memory_pool_order Order>
+    void test_random_ops()
+    {
+        rad::dynamic_memory_pool<std::uint64_t, Order> pool(elementsPerBlock);
+        pool_model model;
+        rad::test::random rng;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            const auto liveCount = model.live_count();
+
+            if (liveCount == 0 || rng.next(100) < 55)
+            {
+                model.on_allocate(pool.allocate());
+            }
+            else
+            {
+                // Free a random live element.
+                auto n = rng.next(static_cast<int>(liveCount));
+                for (std::size_t j = 0; j < model.ptrs.size(); ++j)
+                {
+                    if (model.isLive[j] && n-- == 0)
+                    {
+                        pool.deallocate(model.ptrs[j]);
+                        model.isLive[j] = false;
+                        break;
+                    }
+                }
+            }
+
+            if ((i % 50) == 0)
+            {
+                check_stats(pool, model);
+            }
+        }
+
+        check_stats(pool, model);
+    }
+
+    void test_fragmentation()
+    {
+        rad::dynamic_memory_pool<std::uint64_t> pool(elementsPerBlock);
+        pool_model model;
+
+        for (std::size_t i = 0; i < 4 * elementsPerBlock; ++i)
+        {
+            model.on_allocate(pool.allocate());
+        }
+
+        // Freeing a whole block leaves the free elements fully packed.
+        for (std::size_t i = 0; i < elementsPerBlock; ++i)
+        {
+            pool.deallocate(model.ptrs[i]);
+            model.isLive[i] = false;
+        }
+
+        check_stats(pool, model);
+        RAD_TEST_CHECK(pool.get_stats().emptyBlockCount == 1);
+        RAD_TEST_CHECK(pool.get_stats().fragmentation == 0.0);
+
+        // Scattering the same number of free elements across two blocks doesn't.
+        for (std::size_t i = 0; i < elementsPerBlock; ++i)
+        {
+            model.on_allocate(pool.allocate());
+        }
+
+        for (std::size_t i = 0; i < elementsPerBlock; ++i)
+        {
+            const auto index = ((i % 2) * elementsPerBlock) + (i / 2);
+            pool.deallocate(model.ptrs[index]);
+            model.isLive[index] = false;
+        }
+
+        check_stats(pool, model);
+        RAD_TEST_CHECK(pool.get_stats().emptyBlockCount == 0);
+        RAD_TEST_CHECK(pool.get_stats().fragmentation == 1.0);
+        RAD_TEST_CHECK(pool.get_stats().utilization() == 0.75);
+    }
+
+    void test_dump_pool_report()
+    {
+        rad::dynamic_memory_pool<std::uint64_t> pool(elementsPerBlock);
+        std::uint64_t* ptrs[3 * elementsPerBlock];
+
+        for (auto& ptr : ptrs)
+        {
+            ptr = pool.allocate();
+        }
+
+        for (std::size_t i = 0; i < elementsPerBlock; ++i)
+        {
+            pool.deallocate(ptrs[i]);
+        }
+
+        const auto file = std::tmpfile();
+        RAD_TEST_CHECK(file);
+
+        rad::dump_pool_report(pool, file);
+        std::rewind(file);
+
+        std::string report;
+        char buffer[256];
+        for (std::size_t size; (size = std::fread(buffer, 1, sizeof(buffer), file)) > 0;)
+        {
+            report.append(buffer, size);
+        }
+
+        std::fclose(file);
+
+        RAD_TEST_CHECK(report.find("3 block(s) x 8 element(s) (24 total)") != std::string::npos);
+        RAD_TEST_CHECK(report.find("live elements:   16 (66.7%)") != std::string::npos);
+        RAD_TEST_CHECK(report.find("free elements:   8") != std::string::npos);
+        RAD_TEST_CHECK(report.find("empty blocks:    1") != std::string::npos);
+        RAD_TEST_CHECK(report.find("(0/8)") != std::string::npos);
+        RAD_TEST_CHECK(report.find("(8/8)") != std::string::npos);
+    }
+}
+
+int main()
+{
+    test_fresh_dynamic_pool();
+    test_fresh_fixed_pool<rad::memory_pool_order::lifo>();
+    test_fresh_fixed_pool<rad::memory_pool_order::address>();
+    test_fresh_fixed_pool<rad::memory_pool_order::block_affine>();
+    test_random_ops<rad::memory_pool_order::lifo>();
+    test_random_ops<rad::memory_pool_order::address>();
+    test_random_ops<rad::memory_pool_order::block_affine>();
+    test_fragmentation();
+    test_dump_pool_report();
+
+    std::puts("rad_test_memory_pool_stats: all tests passed");
+    return EXIT_SUCCESS;
+}
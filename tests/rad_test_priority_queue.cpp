@@ -0,0 +1,421 @@
+/// @file rad_test_priority_queue.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::priority_queue and rad::indexed_priority_queue.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_priority_queue.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    template<typename T, typename Compare, std::size_t Arity>
+    bool is_heap(const rad::priority_queue<T, Compare, Arity>& queue)
+    {
+        const auto elements = queue.elements();
+        for (std::size_t i = 1; i < elements.size(); ++i)
+        {
+            if (Compare()(elements[(i - 1) / Arity], elements[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename T, typename Compare, std::size_t Arity>
+    void check_same(const rad::priority_queue<T, Compare, Arity>& queue,
+        const std::priority_queue<T, std::vector<T>, Compare>& ref)
+    {
+        RAD_TEST_CHECK(queue.size() == ref.size());
+        RAD_TEST_CHECK(queue.empty() == ref.empty());
+        RAD_TEST_CHECK(is_heap(queue));
+        RAD_TEST_CHECK(ref.empty() || queue.top() == ref.top());
+    }
+
+    /// @brief Compares a priority_queue against a std::priority_queue across
+    /// random pushes, pops and range pushes.
+    template<typename Compare, std::size_t Arity>
+    void test_priority_queue()
+    {
+        rad::priority_queue<int, Compare, Arity> queue;
+        std::priority_queue<int, std::vector<int>, Compare> ref;
+        rad::test::random rng;
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            const auto op = rng.next(10);
+
+            if (op < 5)
+            {
+                // NOTE: Values repeat often, so that ties are covered.
+                const auto value = rng.next(100);
+                queue.push(value);
+                ref.push(value);
+            }
+            else if (op < 9)
+            {
+                if (!ref.empty())
+                {
+                    queue.pop();
+                    ref.pop();
+                }
+            }
+            else
+            {
+                // Push a range which is sometimes larger than the queue (rebuilding the
+                // heap), and sometimes smaller (sifting each new element up).
+                const auto rangeSize = rng.next((std::min<int>(static_cast<int>(ref.size()), 16) * 2) + 2);
+                std::vector<int> values(static_cast<std::size_t>(rangeSize));
+                for (auto& value : values)
+                {
+                    value = rng.next(100);
+                    ref.push(value);
+                }
+
+                queue.push_range(values.begin(), values.end());
+            }
+
+            RAD_TEST_CHECK(queue.size() == ref.size());
+            RAD_TEST_CHECK(ref.empty() || queue.top() == ref.top());
+
+            if ((i % 50) == 0)
+            {
+                check_same(queue, ref);
+            }
+        }
+
+        // Constructing from a range builds a valid heap.
+        std::vector<int> values(1000);
+        for (auto& value : values)
+        {
+            value = rng.next(1000);
+        }
+
+        rad::priority_queue<int, Compare, Arity> rangeQueue(values.begin(), values.end());
+        std::priority_queue<int, std::vector<int>, Compare> rangeRef(values.begin(), values.end());
+
+        while (!rangeRef.empty())
+        {
+            check_same(rangeQueue, rangeRef);
+            rangeQueue.pop();
+            rangeRef.pop();
+        }
+
+        check_same(rangeQueue, rangeRef);
+    }
+
+    /// @brief An iterator over a vector of ints which throws upon
+    /// reaching the given position.
+    template<typename Category>
+    struct throwing_iterator
+    {
+        using iterator_category = Category;
+        using value_type        = int;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const int*;
+        using reference         = const int&;
+
+        const int*      ptr = nullptr;
+        const int*      throwPtr = nullptr;
+
+        reference operator*() const
+        {
+            if (ptr == throwPtr)
+            {
+                throw std::runtime_error("throwing_iterator");
+            }
+
+            return *ptr;
+        }
+
+        throwing_iterator& operator++()
+        {
+            ++ptr;
+            return *this;
+        }
+
+        throwing_iterator operator++(int)
+        {
+            auto prev = *this;
+            ++ptr;
+            return prev;
+        }
+
+        friend bool operator==(const throwing_iterator& a, const throwing_iterator& b)
+        {
+            return (a.ptr == b.ptr);
+        }
+
+        friend bool operator!=(const throwing_iterator& a, const throwing_iterator& b)
+        {
+            return (a.ptr != b.ptr);
+        }
+    };
+
+    template<typename Category>
+    void test_push_range_throws()
+    {
+        rad::priority_queue<int> queue;
+        std::vector<int> values;
+
+        for (int i = 0; i < 20; ++i)
+        {
+            values.push_back((i * 7) % 20);
+            queue.push(values.back());
+        }
+
+        const auto oldElements = std::vector<int>(queue.elements().begin(), queue.elements().end());
+        const std::vector<int> range = { 100, -1, 50, 200, 3 };
+
+        for (std::size_t throwIndex = 0; throwIndex < range.size(); ++throwIndex)
+        {
+            const throwing_iterator<Category> first{ range.data(), range.data() + throwIndex };
+            const throwing_iterator<Category> last{ range.data() + range.size(), nullptr };
+
+            bool isThrown = false;
+            try
+            {
+                queue.push_range(first, last);
+            }
+            catch (const std::runtime_error&)
+            {
+                isThrown = true;
+            }
+
+            // NOTE: None of the range's elements may have been pushed.
+            RAD_TEST_CHECK(isThrown);
+            RAD_TEST_CHECK(std::equal(queue.elements().begin(), queue.elements().end(),
+                oldElements.begin(), oldElements.end()));
+        }
+    }
+
+    /// @brief Compares an indexed min-queue against a std::set of (value, handle) pairs
+    /// across random pushes, pops, erasures and priority changes.
+    template<std::size_t Arity>
+    void test_indexed_priority_queue()
+    {
+        rad::indexed_priority_queue<int, std::greater<int>, Arity> queue;
+        std::set<std::pair<int, std::uint32_t>> ref;
+        std::map<std::uint32_t, int> values;
+        std::set<std::uint32_t> freeHandles;
+        std::uint32_t handleCount = 0;
+        rad::test::random rng;
+
+        const auto random_handle = [&]()
+        {
+            auto it = values.begin();
+            std::advance(it, rng.next(static_cast<int>(values.size())));
+            return rad::priority_queue_handle(it->first);
+        };
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            const auto op = rng.next(10);
+
+            if (op < 4 || values.empty())
+            {
+                const auto value = rng.next(1000);
+                const auto handle = queue.push(value);
+
+                // NOTE: Freed handles are re-used before new ones are created.
+                if (freeHandles.empty())
+                {
+                    RAD_TEST_CHECK(handle.value() == handleCount++);
+                }
+                else
+                {
+                    RAD_TEST_CHECK(freeHandles.erase(handle.value()) == 1);
+                }
+
+                RAD_TEST_CHECK(values.emplace(handle.value(), value).second);
+                ref.emplace(value, handle.value());
+            }
+            else if (op < 6)
+            {
+                // NOTE: On ties, any of the tied elements may be at the top.
+                const auto handle = queue.top_handle();
+                RAD_TEST_CHECK(queue.top() == ref.begin()->first);
+                RAD_TEST_CHECK(values.at(handle.value()) == queue.top());
+
+                queue.pop();
+                ref.erase({ values[handle.value()], handle.value() });
+                values.erase(handle.value());
+                freeHandles.insert(handle.value());
+            }
+            else if (op < 7)
+            {
+                const auto handle = random_handle();
+                queue.erase(handle);
+
+                ref.erase({ values[handle.value()], handle.value() });
+                values.erase(handle.value());
+                freeHandles.insert(handle.value());
+            }
+            else
+            {
+                // Either move the element anywhere, or towards the top of the queue.
+                const auto handle = random_handle();
+                auto& value = values[handle.value()];
+                const auto newValue = (op < 9) ? rng.next(1000) : (value - rng.next(value + 1));
+
+                if (op < 9)
+                {
+                    queue.update(handle, newValue);
+                }
+                else
+                {
+                    queue.decrease_key(handle, newValue);
+                }
+
+                ref.erase({ value, handle.value() });
+                ref.emplace(newValue, handle.value());
+                value = newValue;
+            }
+
+            RAD_TEST_CHECK(queue.size() == values.size());
+            RAD_TEST_CHECK(queue.empty() || queue.top() == ref.begin()->first);
+
+            if ((i % 100) == 0)
+            {
+                for (const auto& entry : values)
+                {
+                    const rad::priority_queue_handle handle(entry.first);
+                    RAD_TEST_CHECK(queue.contains(handle));
+                    RAD_TEST_CHECK(queue.get(handle) == entry.second);
+                }
+
+                for (const auto handle : freeHandles)
+                {
+                    RAD_TEST_CHECK(!queue.contains(rad::priority_queue_handle(handle)));
+                }
+            }
+        }
+
+        // Popping everything yields the elements in sorted order.
+        for (const auto& entry : ref)
+        {
+            RAD_TEST_CHECK(queue.top() == entry.first);
+            queue.pop();
+        }
+
+        RAD_TEST_CHECK(queue.empty());
+        RAD_TEST_CHECK(!queue.contains(rad::priority_queue_handle()));
+    }
+
+    /// @brief Runs Dijkstra's algorithm via decrease_key, and checks the resulting
+    /// distances against those found by the usual std::priority_queue approach of
+    /// pushing duplicate entries and skipping the stale ones.
+    void test_dijkstra()
+    {
+        constexpr int nodeCount = 500;
+        constexpr int infinity = (std::numeric_limits<int>::max)();
+
+        struct edge
+        {
+            int     to;
+            int     weight;
+        };
+
+        std::vector<std::vector<edge>> edges(nodeCount);
+        rad::test::random rng;
+
+        for (int i = 0; i < nodeCount * 5; ++i)
+        {
+            edges[rng.next(nodeCount)].push_back({ rng.next(nodeCount), 1 + rng.next(100) });
+        }
+
+        // Find the distances via decrease_key.
+        std::vector<int> distances(nodeCount, infinity);
+        std::vector<rad::priority_queue_handle> handles(nodeCount);
+        rad::indexed_priority_queue<std::pair<int, int>, std::greater<std::pair<int, int>>> queue;
+
+        distances[0] = 0;
+        handles[0] = queue.push({ 0, 0 });
+
+        while (!queue.empty())
+        {
+            const auto node = queue.top().second;
+            queue.pop();
+
+            for (const auto& e : edges[node])
+            {
+                const auto distance = distances[node] + e.weight;
+                if (distance < distances[e.to])
+                {
+                    if (distances[e.to] == infinity)
+                    {
+                        handles[e.to] = queue.push({ distance, e.to });
+                    }
+                    else
+                    {
+                        queue.decrease_key(handles[e.to], { distance, e.to });
+                    }
+
+                    distances[e.to] = distance;
+                }
+            }
+        }
+
+        // Find the distances via lazy deletion.
+        std::vector<int> refDistances(nodeCount, infinity);
+        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+            std::greater<std::pair<int, int>>> refQueue;
+
+        refDistances[0] = 0;
+        refQueue.push({ 0, 0 });
+
+        while (!refQueue.empty())
+        {
+            const auto top = refQueue.top();
+            refQueue.pop();
+
+            if (top.first != refDistances[top.second])
+            {
+                continue;
+            }
+
+            for (const auto& e : edges[top.second])
+            {
+                const auto distance = top.first + e.weight;
+                if (distance < refDistances[e.to])
+                {
+                    refDistances[e.to] = distance;
+                    refQueue.push({ distance, e.to });
+                }
+            }
+        }
+
+        RAD_TEST_CHECK(distances == refDistances);
+    }
+}
+
+int main()
+{
+    test_priority_queue<std::less<int>, 2>();
+    test_priority_queue<std::less<int>, 3>();
+    test_priority_queue<std::less<int>, 4>();
+    test_priority_queue<std::greater<int>, 8>();
+    test_push_range_throws<std::input_iterator_tag>();
+    test_push_range_throws<std::forward_iterator_tag>();
+    test_indexed_priority_queue<2>();
+    test_indexed_priority_queue<4>();
+    test_dijkstra();
+
+    std::puts("rad_test_priority_queue: all tests passed");
+    return EXIT_SUCCESS;
+}
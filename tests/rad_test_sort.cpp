@@ -0,0 +1,207 @@
+/// @file rad_test_sort.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::radix_sort and rad::parallel_sort.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_sort.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    constexpr std::size_t radixSizes[] = { 0, 1, 2, 63, 64, 65, 1000, 70000 };
+
+    /// @brief An element which is sorted by its key, and remembers its original
+    /// position, so that the stability of the sort can be checked.
+    template<typename Key>
+    struct record
+    {
+        Key             key;
+        std::uint32_t   position;
+    };
+
+    template<typename Key>
+    Key make_key(rad::test::random& rng)
+    {
+        if constexpr (std::is_floating_point_v<Key>)
+        {
+            // NOTE: This never produces -0.0, which std::stable_sort considers
+            // equal to 0.0, but radix_sort orders before it.
+            return static_cast<Key>(rng.next(2000) - 1000) / Key(8);
+        }
+        else
+        {
+            // NOTE: Keys are drawn from a narrow range now and then, so that
+            // there are plenty of duplicates, and some passes are skipped.
+            const auto bits = (static_cast<std::uint64_t>(rng.next()) << 32) | rng.next();
+            return static_cast<Key>((rng.next(4) == 0) ? (bits % 16) : bits);
+        }
+    }
+
+    /// @brief Compares radix_sort against std::stable_sort, for the given key type.
+    template<typename Key>
+    void test_radix_sort()
+    {
+        rad::test::random rng;
+
+        for (const auto size : radixSizes)
+        {
+            std::vector<record<Key>> records(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                records[i] = { make_key<Key>(rng), static_cast<std::uint32_t>(i) };
+            }
+
+            auto ref = records;
+            std::stable_sort(ref.begin(), ref.end(), [](const record<Key>& a, const record<Key>& b)
+            {
+                return (a.key < b.key);
+            });
+
+            rad::radix_sort(rad::span<record<Key>>(records.data(), records.size()),
+                [](const record<Key>& r) { return r.key; });
+
+            RAD_TEST_CHECK(std::equal(records.begin(), records.end(), ref.begin(), ref.end(),
+                [](const record<Key>& a, const record<Key>& b)
+                {
+                    return (a.key == b.key && a.position == b.position);
+                }));
+
+            // Sorting the keys themselves, into a caller-provided scratch buffer.
+            std::vector<Key> keys(size), scratch(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                keys[i] = records[(i * 7919) % size].key;
+            }
+
+            auto refKeys = keys;
+            std::sort(refKeys.begin(), refKeys.end());
+
+            rad::radix_sort(rad::span<Key>(keys.data(), keys.size()),
+                rad::span<Key>(scratch.data(), scratch.size()));
+
+            RAD_TEST_CHECK(keys == refKeys);
+        }
+    }
+
+    void test_radix_sort_special_floats()
+    {
+        constexpr auto infinity = std::numeric_limits<double>::infinity();
+
+        rad::vector<double> values;
+        for (const auto value : { 1.0, -0.0, infinity, 0.0, -infinity, -1.0,
+            std::numeric_limits<double>::denorm_min(), -0.0, (std::numeric_limits<double>::max)() })
+        {
+            values.push_back(value);
+        }
+
+        rad::radix_sort(values);
+
+        // NOTE: -0.0 sorts before 0.0, as the keys are sorted by their bit patterns.
+        const double expected[] = { -infinity, -1.0, -0.0, -0.0, 0.0,
+            std::numeric_limits<double>::denorm_min(), 1.0, (std::numeric_limits<double>::max)(), infinity };
+
+        RAD_TEST_CHECK(values.size() == std::size(expected));
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            RAD_TEST_CHECK(std::memcmp(&values[i], &expected[i], sizeof(double)) == 0);
+        }
+    }
+
+    /// @brief Compares parallel_sort against std::sort, for ranges both
+    /// smaller and larger than the point at which threads are used.
+    template<typename T, typename Compare>
+    void test_parallel_sort(T (*make_value)(rad::test::random&), Compare compare)
+    {
+        rad::test::random rng;
+
+        for (const std::size_t size : { 0, 1, 1000, 200000 })
+        {
+            std::vector<T> values(size);
+            for (auto& value : values)
+            {
+                value = make_value(rng);
+            }
+
+            auto ref = values;
+            std::sort(ref.begin(), ref.end(), compare);
+
+            for (const std::size_t threadCount : { 0, 1, 2, 3, 8 })
+            {
+                auto sorted = values;
+                rad::parallel_sort(rad::span<T>(sorted.data(), sorted.size()), compare, threadCount);
+                RAD_TEST_CHECK(sorted == ref);
+
+                // Sorting an already-sorted range must leave it sorted.
+                rad::parallel_sort(rad::span<T>(sorted.data(), sorted.size()), compare, threadCount);
+                RAD_TEST_CHECK(sorted == ref);
+            }
+        }
+    }
+
+    int make_int(rad::test::random& rng)
+    {
+        return static_cast<int>(rng.next());
+    }
+
+    int make_duplicate_int(rad::test::random& rng)
+    {
+        // NOTE: Very few distinct values, so that most splitters are equal.
+        return rng.next(3);
+    }
+
+    std::string make_string(rad::test::random& rng)
+    {
+        return std::to_string(rng.next(100000)) + std::string(static_cast<std::size_t>(rng.next(24)), '#');
+    }
+
+    void test_parallel_sort_vector()
+    {
+        rad::vector<std::uint64_t> values;
+        std::vector<std::uint64_t> ref;
+        rad::test::random rng;
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            values.push_back(rng.next());
+            ref.push_back(values.back());
+        }
+
+        std::sort(ref.begin(), ref.end(), std::greater<>());
+        rad::parallel_sort(values, std::greater<>());
+
+        RAD_TEST_CHECK(std::equal(values.begin(), values.end(), ref.begin(), ref.end()));
+    }
+}
+
+int main()
+{
+    test_radix_sort<std::uint8_t>();
+    test_radix_sort<std::int16_t>();
+    test_radix_sort<std::uint32_t>();
+    test_radix_sort<std::int32_t>();
+    test_radix_sort<std::int64_t>();
+    test_radix_sort<std::uint64_t>();
+    test_radix_sort<float>();
+    test_radix_sort<double>();
+    test_radix_sort_special_floats();
+
+    test_parallel_sort<int>(make_int, std::less<>());
+    test_parallel_sort<int>(make_duplicate_int, std::greater<>());
+    test_parallel_sort<std::string>(make_string, std::less<>());
+    test_parallel_sort_vector();
+
+    std::puts("rad_test_sort: all tests passed");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+/// @file rad_test_sparse_set.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::sparse_set and rad::sparse_map.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_sparse_set.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    /// @brief Returns a random key; most keys are clustered together,
+    /// but some are far away, so that most pages are never allocated.
+    template<typename Index>
+    Index make_key(rad::test::random& rng, Index maxKey)
+    {
+        if (rng.next(8) == 0)
+        {
+            return static_cast<Index>(rng.next() % (static_cast<std::uint32_t>(maxKey) + 1));
+        }
+
+        return static_cast<Index>(rng.next(200));
+    }
+
+    template<typename Index, std::size_t PageSize>
+    void check_same(const rad::sparse_set<Index, PageSize>& set, const std::set<Index>& ref)
+    {
+        RAD_TEST_CHECK(set.size() == ref.size());
+        RAD_TEST_CHECK(set.empty() == ref.empty());
+        RAD_TEST_CHECK(static_cast<std::size_t>(set.end() - set.begin()) == ref.size());
+
+        // The dense array holds every key exactly once, in some order.
+        std::vector<Index> keys(set.begin(), set.end());
+        std::sort(keys.begin(), keys.end());
+        RAD_TEST_CHECK(std::equal(keys.begin(), keys.end(), ref.begin(), ref.end()));
+
+        for (std::size_t i = 0; i < set.size(); ++i)
+        {
+            RAD_TEST_CHECK(set.index_of(set.data()[i]) == i);
+        }
+
+        // Every page which holds a key must have been allocated.
+        std::set<std::size_t> pages;
+        for (const auto key : ref)
+        {
+            pages.insert(key / PageSize);
+        }
+
+        RAD_TEST_CHECK(set.page_count() >= pages.size());
+    }
+
+    /// @brief Compares a sparse_set against a std::set across random insertions and erasures.
+    template<typename Index, std::size_t PageSize>
+    void test_set(Index maxKey)
+    {
+        rad::sparse_set<Index, PageSize> set;
+        std::set<Index> ref;
+        std::set<std::size_t> touchedPages;
+        rad::test::random rng;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            const auto key = make_key(rng, maxKey);
+
+            switch (rng.next(4))
+            {
+            case 0:
+            case 1:
+                RAD_TEST_CHECK(set.insert(key) == ref.insert(key).second);
+                touchedPages.insert(key / PageSize);
+                break;
+
+            case 2:
+                RAD_TEST_CHECK(set.erase(key) == (ref.erase(key) > 0));
+                break;
+
+            default:
+                RAD_TEST_CHECK(set.contains(key) == (ref.count(key) > 0));
+                RAD_TEST_CHECK((set.index_of(key) == set.npos) == (ref.count(key) == 0));
+                break;
+            }
+
+            if ((i % 100) == 0)
+            {
+                check_same(set, ref);
+                RAD_TEST_CHECK(set.page_count() == touchedPages.size());
+            }
+        }
+
+        check_same(set, ref);
+
+        // Clearing keeps the pages, and the set still works afterwards.
+        set.clear();
+        ref.clear();
+        check_same(set, ref);
+        RAD_TEST_CHECK(set.page_count() == touchedPages.size());
+
+        for (const auto key : { Index(0), maxKey, Index(maxKey / 2) })
+        {
+            RAD_TEST_CHECK(!set.contains(key));
+            RAD_TEST_CHECK(set.insert(key));
+            ref.insert(key);
+        }
+
+        check_same(set, ref);
+    }
+
+    template<typename T>
+    void check_same(const rad::sparse_map<std::uint32_t, T, 64>& map,
+        const std::map<std::uint32_t, std::string>& ref, std::string (*get_string)(const T&))
+    {
+        RAD_TEST_CHECK(map.size() == ref.size());
+        RAD_TEST_CHECK(map.empty() == ref.empty());
+        RAD_TEST_CHECK(map.keys().size() == ref.size());
+        RAD_TEST_CHECK(map.values().size() == ref.size());
+        RAD_TEST_CHECK(static_cast<std::size_t>(map.end() - map.begin()) == ref.size());
+
+        // The keys and values are kept in the same order.
+        for (std::size_t i = 0; i < map.size(); ++i)
+        {
+            const auto it = ref.find(map.keys()[i]);
+            RAD_TEST_CHECK(it != ref.end());
+            RAD_TEST_CHECK(get_string(map.values()[i]) == it->second);
+            RAD_TEST_CHECK(&map.begin()[i] == &map.values()[i]);
+        }
+
+        for (const auto& entry : ref)
+        {
+            RAD_TEST_CHECK(map.contains(entry.first));
+            RAD_TEST_CHECK(get_string(map.get(entry.first)) == entry.second);
+            RAD_TEST_CHECK(map.find(entry.first) == &map.get(entry.first));
+        }
+    }
+
+    std::string get_string(const std::string& value)
+    {
+        return value;
+    }
+
+    std::string get_pointee_string(const std::unique_ptr<std::string>& value)
+    {
+        return *value;
+    }
+
+    /// @brief Compares a sparse_map against a std::map across random insertions and erasures.
+    template<typename T>
+    void test_map(T (*make_value)(const std::string&), std::string (*get_string)(const T&))
+    {
+        rad::sparse_map<std::uint32_t, T, 64> map;
+        std::map<std::uint32_t, std::string> ref;
+        rad::test::random rng;
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            const auto key = make_key<std::uint32_t>(rng, 100000);
+
+            switch (rng.next(4))
+            {
+            case 0:
+            case 1:
+            {
+                // NOTE: Long enough to exceed the small string optimization,
+                // so that moving the last value into an erased one is checked.
+                const auto str = std::to_string(i) + std::string(32, '#');
+                const auto isNew = (ref.count(key) == 0);
+
+                auto& value = map.emplace(key, make_value(str));
+                if (isNew)
+                {
+                    ref.emplace(key, str);
+                }
+
+                // NOTE: Existing values are left untouched.
+                RAD_TEST_CHECK(get_string(value) == ref[key]);
+                break;
+            }
+
+            case 2:
+                RAD_TEST_CHECK(map.erase(key) == (ref.erase(key) > 0));
+                break;
+
+            default:
+                RAD_TEST_CHECK(map.contains(key) == (ref.count(key) > 0));
+                RAD_TEST_CHECK((map.find(key) != nullptr) == (ref.count(key) > 0));
+                break;
+            }
+
+            if ((i % 100) == 0)
+            {
+                check_same(map, ref, get_string);
+            }
+        }
+
+        check_same(map, ref, get_string);
+
+        map.clear();
+        ref.clear();
+        check_same(map, ref, get_string);
+    }
+
+    std::string make_string(const std::string& str)
+    {
+        return str;
+    }
+
+    std::unique_ptr<std::string> make_unique_string(const std::string& str)
+    {
+        return std::make_unique<std::string>(str);
+    }
+}
+
+int main()
+{
+    test_set<std::uint16_t, 16>(4095);
+    test_set<std::uint32_t, 1024>(1000000);
+    test_set<std::uint32_t, 64>(0xFFFFFu);
+    test_map<std::string>(make_string, get_string);
+    test_map<std::unique_ptr<std::string>>(make_unique_string, get_pointee_string);
+
+    std::puts("rad_test_sparse_set: all tests passed");
+    return EXIT_SUCCESS;
+}
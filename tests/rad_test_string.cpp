@@ -0,0 +1,237 @@
+/// @file rad_test_string.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::basic_string.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_string.h"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    template<typename CharT>
+    void check_same(const rad::basic_string<CharT>& str, const std::basic_string<CharT>& ref)
+    {
+        using view_type = std::basic_string_view<CharT>;
+
+        RAD_TEST_CHECK(str.size() == ref.size());
+        RAD_TEST_CHECK(str.empty() == ref.empty());
+        RAD_TEST_CHECK(str.capacity() >= str.size());
+        RAD_TEST_CHECK(view_type(str) == view_type(ref));
+        RAD_TEST_CHECK(str.c_str()[str.size()] == CharT());
+        RAD_TEST_CHECK(str == view_type(ref) && !(str != view_type(ref)));
+    }
+
+    template<typename CharT>
+    CharT random_char(rad::test::random& rng)
+    {
+        return static_cast<CharT>('a' + rng.next(26));
+    }
+
+    /// @brief Compares a rad::basic_string against a std::basic_string across random
+    /// operations, many of which are given parts of the string itself as their input.
+    template<typename CharT>
+    void test_random_ops()
+    {
+        rad::basic_string<CharT> str;
+        std::basic_string<CharT> ref;
+        rad::test::random rng;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            const auto size = static_cast<int>(ref.size());
+
+            // NOTE: A random (possibly empty) substring of the string itself.
+            const auto offset = rng.next(size + 1);
+            const auto count = rng.next(size - offset + 1);
+
+            switch (rng.next((size > 200) ? 14 : 10))
+            {
+            case 0:
+            {
+                const auto ch = random_char<CharT>(rng);
+                str.push_back(ch);
+                ref.push_back(ch);
+                break;
+            }
+
+            case 1:
+                if (size > 0)
+                {
+                    str.pop_back();
+                    ref.pop_back();
+                }
+
+                break;
+
+            case 2:
+                str.append(str.data() + offset, count);
+                ref.append(ref.substr(offset, count));
+                break;
+
+            case 3:
+            {
+                const auto ch = random_char<CharT>(rng);
+                str.append(count + 1, ch);
+                ref.append(count + 1, ch);
+                break;
+            }
+
+            case 4:
+            {
+                const auto index = rng.next(size + 1);
+                str.insert(index, str.data() + offset, count);
+                ref.insert(index, ref.substr(offset, count));
+                break;
+            }
+
+            case 5:
+                str.assign(str.data() + offset, count);
+                ref = ref.substr(offset, count);
+                break;
+
+            case 6:
+                str += str;
+                ref += ref;
+                break;
+
+            case 7:
+            {
+                const auto newSize = static_cast<std::size_t>(rng.next(2 * size + 2));
+                str.resize(newSize, CharT('x'));
+                ref.resize(newSize, CharT('x'));
+                break;
+            }
+
+            case 8:
+                str.reserve(static_cast<std::size_t>(rng.next(3 * size + 1)));
+                break;
+
+            default:
+                // NOTE: Long strings are erased from more often, so that
+                // the string keeps shrinking back down to a short size.
+                str.erase(offset, count);
+                ref.erase(offset, count);
+                break;
+            }
+
+            check_same(str, ref);
+        }
+
+        str.clear();
+        ref.clear();
+        check_same(str, ref);
+    }
+
+    void test_insert_aliasing()
+    {
+        // Insert parts of the string into itself, both with and without growing.
+        for (const std::size_t initialSize : { 5, 20, 100 })
+        {
+            std::string ref;
+            for (std::size_t i = 0; i < initialSize; ++i)
+            {
+                ref.push_back(static_cast<char>('a' + (i % 26)));
+            }
+
+            for (std::size_t index = 0; index <= ref.size(); index += 3)
+            {
+                for (std::size_t offset = 0; offset < ref.size(); offset += 4)
+                {
+                    rad::string str(ref.data(), ref.size());
+                    std::string expected(ref);
+
+                    const auto count = std::min<std::size_t>(7, ref.size() - offset);
+                    str.insert(index, str.data() + offset, count);
+                    expected.insert(index, ref, offset, count);
+
+                    check_same(str, expected);
+                }
+            }
+        }
+    }
+
+    void test_copy_move_swap()
+    {
+        const std::string shortRef("short");
+        const std::string longRef(100, 'L');
+
+        rad::string shortStr(shortRef.c_str());
+        rad::string longStr(longRef.c_str());
+
+        // NOTE: Short strings are stored inline.
+        RAD_TEST_CHECK(shortStr.capacity() == rad::string::small_capacity);
+        RAD_TEST_CHECK(longStr.capacity() >= longRef.size());
+
+        rad::string copy(longStr);
+        check_same(copy, longRef);
+
+        copy = shortStr;
+        check_same(copy, shortRef);
+
+        rad::string moved(std::move(longStr));
+        check_same(moved, longRef);
+        check_same(longStr, std::string());
+
+        longStr = std::move(moved);
+        check_same(longStr, longRef);
+
+        shortStr.swap(longStr);
+        check_same(shortStr, longRef);
+        check_same(longStr, shortRef);
+
+        RAD_TEST_CHECK(std::hash<rad::string>()(shortStr) ==
+            std::hash<std::string_view>()(longRef));
+
+        RAD_TEST_CHECK((longStr < shortStr) == (shortRef < longRef));
+        RAD_TEST_CHECK((longStr.compare(shortStr) < 0) == (shortRef.compare(longRef) < 0));
+    }
+
+    void test_release_adopt()
+    {
+        for (const std::size_t size : { std::size_t(0), std::size_t(3),
+            rad::string::small_capacity, std::size_t(64) })
+        {
+            const std::string ref(size, 'r');
+            rad::string str(ref.c_str());
+
+            // Releasing a string (short or long) hands over a null-terminated buffer.
+            rad::string::size_type capacity = 0;
+            const auto buffer = str.release(&capacity);
+
+            RAD_TEST_CHECK(buffer);
+            RAD_TEST_CHECK(capacity >= size);
+            RAD_TEST_CHECK(std::string(buffer) == ref);
+            check_same(str, std::string());
+
+            // Adopting the buffer gives it back to a string, which frees it.
+            rad::string adopted("previous contents, which are long enough to be on the heap");
+            adopted.adopt(buffer, size, capacity);
+
+            check_same(adopted, ref);
+            RAD_TEST_CHECK(adopted.capacity() == capacity);
+
+            adopted.append("!");
+            check_same(adopted, ref + "!");
+        }
+    }
+}
+
+int main()
+{
+    test_random_ops<char>();
+    test_random_ops<char16_t>();
+    test_insert_aliasing();
+    test_copy_move_swap();
+    test_release_adopt();
+
+    std::puts("rad_test_string: all tests passed");
+    return EXIT_SUCCESS;
+}
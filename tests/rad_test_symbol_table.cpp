@@ -0,0 +1,168 @@
+/// @file rad_test_symbol_table.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::symbol_table.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_symbol_table.h"
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    /// @brief Returns a random string; strings repeat often, and some of them
+    /// are long, or contain embedded null characters.
+    std::string make_string(rad::test::random& rng, int distinctCount)
+    {
+        const auto n = rng.next(distinctCount);
+        auto str = "sym" + std::to_string(n);
+
+        if ((n % 7) == 0)
+        {
+            str.append(static_cast<std::size_t>(100 + n % 50), 'x');
+        }
+
+        if ((n % 11) == 0)
+        {
+            str.push_back('\0');
+            str.append("tail");
+        }
+
+        return str;
+    }
+
+    void check_symbol(const rad::symbol_table& table, rad::symbol sym, std::string_view str)
+    {
+        RAD_TEST_CHECK(table.get_view(sym) == str);
+        RAD_TEST_CHECK(std::string_view(table.c_str(sym), str.size()) == str);
+        RAD_TEST_CHECK(table.c_str(sym)[str.size()] == '\0');
+        RAD_TEST_CHECK(sym.value() < table.size());
+    }
+
+    /// @brief Compares a symbol table against a std::unordered_map of string to symbol.
+    void test_intern()
+    {
+        rad::symbol_table table;
+        std::unordered_map<std::string, rad::symbol> ref;
+        std::unordered_set<std::uint32_t> values;
+        rad::test::random rng;
+
+        // NOTE: Enough distinct strings to fill several of the table's pages.
+        for (int i = 0; i < 20000; ++i)
+        {
+            const auto str = make_string(rng, 5000);
+            const auto refIt = ref.find(str);
+
+            rad::symbol found;
+            RAD_TEST_CHECK(table.try_find(found, str) == (refIt != ref.end()));
+            RAD_TEST_CHECK(refIt == ref.end() || found == refIt->second);
+
+            if (rng.next(4) == 0)
+            {
+                // Just look the string up.
+                continue;
+            }
+
+            const auto sym = table.intern(str);
+            check_symbol(table, sym, str);
+            RAD_TEST_CHECK(!sym.empty());
+
+            if (refIt != ref.end())
+            {
+                RAD_TEST_CHECK(sym == refIt->second);
+            }
+            else
+            {
+                // NOTE: Different strings always get different symbols.
+                RAD_TEST_CHECK(values.insert(sym.value()).second);
+                ref.emplace(str, sym);
+            }
+
+            RAD_TEST_CHECK(table.size() == (ref.size() + 1));
+        }
+
+        // Every symbol still refers to its string.
+        for (const auto& entry : ref)
+        {
+            check_symbol(table, entry.second, entry.first);
+        }
+
+        // The empty string is always symbol 0, whether it's interned or not.
+        rad::symbol empty(123);
+        RAD_TEST_CHECK(table.try_find(empty, std::string_view()) && empty == rad::symbol());
+        RAD_TEST_CHECK(table.intern("") == rad::symbol());
+        RAD_TEST_CHECK(table.intern(std::string_view()).empty());
+        check_symbol(table, rad::symbol(), std::string_view());
+    }
+
+    void test_threads()
+    {
+        constexpr int threadCount = 4;
+        constexpr int stringCount = 3000;
+
+        rad::symbol_table table;
+        std::vector<std::vector<rad::symbol>> syms(threadCount);
+        std::vector<std::thread> threads;
+
+        // Every thread interns the same strings, in a different order.
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&table, &syms, t]()
+            {
+                syms[t].resize(stringCount);
+
+                for (int i = 0; i < stringCount; ++i)
+                {
+                    const auto index = (t % 2) ? (stringCount - 1 - i) : i;
+                    syms[t][index] = table.intern("thread" + std::to_string(index));
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        // All of the threads must agree on every symbol.
+        RAD_TEST_CHECK(table.size() == (stringCount + 1));
+
+        for (int i = 0; i < stringCount; ++i)
+        {
+            for (int t = 1; t < threadCount; ++t)
+            {
+                RAD_TEST_CHECK(syms[t][i] == syms[0][i]);
+            }
+
+            check_symbol(table, syms[0][i], "thread" + std::to_string(i));
+        }
+    }
+
+    void test_global_table()
+    {
+        auto& table = rad::get_global_symbol_table();
+        RAD_TEST_CHECK(&table == &rad::get_global_symbol_table());
+
+        const auto sym = table.intern("global");
+        RAD_TEST_CHECK(table.intern(std::string("glo") + "bal") == sym);
+        check_symbol(table, sym, "global");
+    }
+}
+
+int main()
+{
+    test_intern();
+    test_threads();
+    test_global_table();
+
+    std::puts("rad_test_symbol_table: all tests passed");
+    return EXIT_SUCCESS;
+}
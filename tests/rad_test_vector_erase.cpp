@@ -0,0 +1,264 @@
+/// @file rad_test_vector_erase.cpp
+/// @author Graham Scott
+/// @brief Regression tests for rad::vector's erase operations.
+/// @date 2026-10-18
+/// @copyright Copyright (c) Graham Scott; see LICENSE.txt file for details
+
+#include "rad_test.h"
+#include "rad_vector.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    /// @brief Owns a heap-allocated int; it has non-trivial moves,
+    /// but is trivially relocatable.
+    struct boxed
+    {
+        int*    ptr;
+
+        explicit boxed(int value) :
+            ptr(new int(value))
+        {
+        }
+
+        boxed(const boxed&) = delete;
+
+        boxed(boxed&& other) noexcept :
+            ptr(other.ptr)
+        {
+            other.ptr = nullptr;
+        }
+
+        ~boxed()
+        {
+            delete ptr;
+        }
+
+        boxed& operator=(const boxed&) = delete;
+
+        boxed& operator=(boxed&& other) noexcept
+        {
+            std::swap(ptr, other.ptr);
+            return *this;
+        }
+    };
+}
+
+namespace rad
+{
+template<>
+struct is_trivially_relocatable<boxed> : std::true_type {};
+}
+
+namespace
+{
+    static_assert(rad::is_trivially_relocatable_v<int>);
+    static_assert(!rad::is_trivially_relocatable_v<std::string>);
+    static_assert(rad::is_trivially_relocatable_v<boxed> && !std::is_trivially_copyable_v<boxed>);
+
+    int make_int(int value)
+    {
+        return value;
+    }
+
+    int get_int(const int& value)
+    {
+        return value;
+    }
+
+    std::string make_string(int value)
+    {
+        // NOTE: Long enough to exceed the small string optimization.
+        return std::to_string(value) + std::string(32, '#');
+    }
+
+    int get_string_int(const std::string& value)
+    {
+        return std::stoi(value);
+    }
+
+    boxed make_boxed(int value)
+    {
+        return boxed(value);
+    }
+
+    int get_boxed_int(const boxed& value)
+    {
+        return *value.ptr;
+    }
+
+    template<typename T>
+    void check_same(const rad::vector<T>& vec, const std::vector<int>& ref, int (*get_value)(const T&))
+    {
+        RAD_TEST_CHECK(vec.size() == ref.size());
+        RAD_TEST_CHECK(vec.empty() == ref.empty());
+        RAD_TEST_CHECK(vec.capacity() >= vec.size());
+
+        for (std::size_t i = 0; i < ref.size(); ++i)
+        {
+            RAD_TEST_CHECK(get_value(vec[i]) == ref[i]);
+        }
+    }
+
+    /// @brief Compares a rad::vector against a std::vector across random erasures, via
+    /// each of the erase operations, for types which are shifted down via memmove (both
+    /// trivially copyable and not), and for types which are shifted via move-assignment.
+    template<typename T>
+    void test_random_erase(T (*make_value)(int), int (*get_value)(const T&))
+    {
+        using size_type = typename rad::vector<T>::size_type;
+
+        rad::vector<T> vec;
+        std::vector<int> ref;
+        rad::test::random rng;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            const auto size = static_cast<int>(ref.size());
+            const auto op = rng.next(10);
+
+            if (op < 4 || size == 0)
+            {
+                const auto value = rng.next(1000);
+                vec.push_back(make_value(value));
+                ref.push_back(value);
+            }
+            else if (op == 4)
+            {
+                const auto pos = rng.next(size);
+                RAD_TEST_CHECK(vec.erase(vec.begin() + pos) == (vec.begin() + pos));
+                ref.erase(ref.begin() + pos);
+            }
+            else if (op == 5)
+            {
+                // NOTE: The range may be empty.
+                const auto first = rng.next(size + 1);
+                const auto last = first + rng.next(size - first + 1);
+                RAD_TEST_CHECK(vec.erase(vec.begin() + first, vec.begin() + last) == (vec.begin() + first));
+                ref.erase(ref.begin() + first, ref.begin() + last);
+            }
+            else if (op == 6)
+            {
+                const auto pos = rng.next(size);
+                RAD_TEST_CHECK(vec.erase_unordered(vec.begin() + pos) == (vec.begin() + pos));
+                ref[pos] = ref.back();
+                ref.pop_back();
+            }
+            else if (op == 7)
+            {
+                const auto divisor = 2 + rng.next(8);
+                const auto remainder = rng.next(divisor);
+                const auto pred = [divisor, remainder](int value) { return ((value % divisor) == remainder); };
+
+                const auto it = std::remove_if(ref.begin(), ref.end(), pred);
+                const auto erasedCount = static_cast<size_type>(ref.end() - it);
+                ref.erase(it, ref.end());
+
+                RAD_TEST_CHECK(vec.erase_if([&](const T& value) { return pred(get_value(value)); }) == erasedCount);
+            }
+            else if (op == 8)
+            {
+                const auto threshold = rng.next(1000);
+                const auto pred = [threshold](int value) { return (value < threshold); };
+
+                const auto it = vec.remove_if([&](const T& value) { return pred(get_value(value)); });
+                ref.erase(std::remove_if(ref.begin(), ref.end(), pred), ref.end());
+
+                // NOTE: remove_if leaves the size unchanged, with the kept elements at the front.
+                RAD_TEST_CHECK(static_cast<std::size_t>(it - vec.begin()) == ref.size());
+                RAD_TEST_CHECK(vec.size() == static_cast<std::size_t>(size));
+
+                vec.erase(it, vec.end());
+            }
+            else
+            {
+                // NOTE: Sometimes no indices are chosen at all.
+                const auto probability = 1 + rng.next(4);
+                std::vector<size_type> indices;
+                std::vector<int> kept;
+
+                for (int j = 0; j < size; ++j)
+                {
+                    if (rng.next(8) < probability)
+                    {
+                        indices.push_back(static_cast<size_type>(j));
+                    }
+                    else
+                    {
+                        kept.push_back(ref[j]);
+                    }
+                }
+
+                RAD_TEST_CHECK(vec.erase_indices(rad::span<const size_type>(indices.data(), indices.size()))
+                    == indices.size());
+                ref = std::move(kept);
+            }
+
+            check_same(vec, ref, get_value);
+        }
+
+        vec.clear();
+        ref.clear();
+        check_same(vec, ref, get_value);
+    }
+
+    void test_erase_if_throws()
+    {
+        constexpr int count = 100;
+        constexpr int throwIndex = 50;
+
+        rad::vector<boxed> vec;
+        std::vector<int> ref;
+
+        for (int i = 0; i < count; ++i)
+        {
+            vec.push_back(boxed(i));
+
+            // NOTE: Every even element before the one which throws is erased,
+            // and every element from the one which throws onwards is kept.
+            if (i >= throwIndex || (i % 2) != 0)
+            {
+                ref.push_back(i);
+            }
+        }
+
+        bool isThrown = false;
+        try
+        {
+            vec.erase_if([](const boxed& value)
+            {
+                if (*value.ptr == throwIndex)
+                {
+                    throw std::runtime_error("erase_if");
+                }
+
+                return ((*value.ptr % 2) == 0);
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            isThrown = true;
+        }
+
+        RAD_TEST_CHECK(isThrown);
+        check_same(vec, ref, get_boxed_int);
+    }
+}
+
+int main()
+{
+    test_random_erase<int>(make_int, get_int);
+    test_random_erase<std::string>(make_string, get_string_int);
+    test_random_erase<boxed>(make_boxed, get_boxed_int);
+    test_erase_if_throws();
+
+    std::puts("rad_test_vector_erase: all tests passed");
+    return EXIT_SUCCESS;
+}